@@ -0,0 +1,72 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Entry-point for benchmarks.
+ **/
+#include "benchmarks/Benchmark.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+int main( int   i_argc,
+          char *i_argv[] ) {
+  // minimum runtime per measurement in seconds
+  double l_minTime = 0.5;
+
+  // only cases containing the filter are run
+  std::string l_filter = "";
+
+  // path of the JSON output; empty for stdout
+  std::string l_outPath = "";
+
+  bool l_argsValid = true;
+  int l_opt = 0;
+  while( (l_opt = getopt( i_argc, i_argv, "t:f:o:" )) != -1 ) {
+    if( l_opt == 't' ) {
+      l_minTime = atof( optarg );
+    }
+    else if( l_opt == 'f' ) {
+      l_filter = optarg;
+    }
+    else if( l_opt == 'o' ) {
+      l_outPath = optarg;
+    }
+    else {
+      l_argsValid = false;
+    }
+  }
+
+  if( !l_argsValid || optind != i_argc || l_minTime < 0 ) {
+    std::cerr << "invalid arguments, usage:" << std::endl;
+    std::cerr << "  ./build/bench [-t MIN_TIME] [-f FILTER] [-o OUTPUT]" << std::endl;
+    std::cerr << "where MIN_TIME is the minimum runtime per measurement in seconds (default: 0.5)," << std::endl;
+    std::cerr << "FILTER selects the cases whose names contain it (default: all)" << std::endl;
+    std::cerr << "and OUTPUT is the path of the JSON results (default: stdout)." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  tsunami_lab::benchmarks::Benchmark l_benchmark( l_minTime,
+                                                  l_filter );
+
+  // progress goes to stderr, which keeps stdout valid JSON
+  l_benchmark.run( std::cerr );
+
+  if( l_outPath == "" ) {
+    l_benchmark.writeJson( std::cout );
+  }
+  else {
+    std::ofstream l_file( l_outPath );
+    l_benchmark.writeJson( l_file );
+    l_file.close();
+
+    if( l_file.fail() ) {
+      std::cerr << "failed to write " << l_outPath << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
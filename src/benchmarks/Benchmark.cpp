@@ -0,0 +1,149 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Minimal framework for benchmarks with JSON output.
+ **/
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+std::vector< tsunami_lab::benchmarks::Benchmark::Case > & tsunami_lab::benchmarks::Benchmark::getCases() {
+  // function-local to be independent of the order of static initialization
+  static std::vector< Case > l_cases;
+  return l_cases;
+}
+
+bool tsunami_lab::benchmarks::Benchmark::registerCase( std::string const & i_name,
+                                                       t_case              i_function ) {
+  getCases().push_back( { i_name, i_function } );
+  return true;
+}
+
+tsunami_lab::benchmarks::Benchmark::Benchmark( double              i_minTime,
+                                               std::string const & i_filter ) {
+  m_minTime = i_minTime;
+  m_filter = i_filter;
+}
+
+void tsunami_lab::benchmarks::Benchmark::run( std::ostream & io_log ) {
+  for( Case const & l_case : getCases() ) {
+    if( l_case.m_name.find( m_filter ) == std::string::npos ) continue;
+
+    io_log << "running " << l_case.m_name << std::endl;
+    t_idx l_first = m_results.size();
+
+    l_case.m_function( *this );
+
+    for( t_idx l_re = l_first; l_re < m_results.size(); l_re++ ) {
+      io_log << "  " << std::left << std::setw( 56 ) << m_results[l_re].m_name
+             << std::right << std::setw( 14 ) << std::setprecision( 4 ) << m_results[l_re].m_value
+             << " " << m_results[l_re].m_unit << std::endl;
+    }
+  }
+}
+
+double tsunami_lab::benchmarks::Benchmark::measure( std::function< void() > const & i_kernel ) {
+  typedef std::chrono::steady_clock t_clock;
+
+  auto l_time = [&i_kernel]( t_idx i_nCalls ) {
+    t_clock::time_point l_start = t_clock::now();
+    for( t_idx l_ca = 0; l_ca < i_nCalls; l_ca++ ) {
+      i_kernel();
+    }
+    return std::chrono::duration< double >( t_clock::now() - l_start ).count();
+  };
+
+  // warm-up, e.g., first touch and instruction caches
+  i_kernel();
+
+  // calibrate the number of calls per repetition
+  double l_repTime = m_minTime / m_nRepetitions;
+  t_idx l_nCalls = 1;
+  double l_seconds = l_time( l_nCalls );
+  while( l_seconds < l_repTime && l_nCalls < (t_idx(1) << 30) ) {
+    l_nCalls *= 2;
+    l_seconds = l_time( l_nCalls );
+  }
+
+  double l_best = l_seconds / l_nCalls;
+  for( t_idx l_re = 1; l_re < m_nRepetitions; l_re++ ) {
+    l_best = std::min( l_best, l_time( l_nCalls ) / l_nCalls );
+  }
+
+  m_lastSeconds = l_best;
+  m_lastCalls = l_nCalls;
+
+  return l_best;
+}
+
+void tsunami_lab::benchmarks::Benchmark::report( std::string const & i_name,
+                                                 std::string const & i_unit,
+                                                 double              i_value ) {
+  m_results.push_back( { i_name,
+                         i_unit,
+                         i_value,
+                         m_lastSeconds,
+                         m_lastCalls } );
+}
+
+void tsunami_lab::benchmarks::Benchmark::writeJsonString( std::string const & i_string,
+                                                          std::ostream      & io_stream ) {
+  io_stream << '"';
+  for( char l_ch : i_string ) {
+    if( l_ch == '"' || l_ch == '\\' ) io_stream << '\\';
+    io_stream << l_ch;
+  }
+  io_stream << '"';
+}
+
+void tsunami_lab::benchmarks::Benchmark::writeJson( std::ostream & io_stream ) const {
+  int l_nThreads = 1;
+#ifdef _OPENMP
+  l_nThreads = omp_get_max_threads();
+#endif
+
+  char l_date[32] = { 0 };
+  std::time_t l_now = std::time( nullptr );
+  std::strftime( l_date, sizeof(l_date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime( &l_now ) );
+
+  io_stream << std::setprecision( 9 );
+  io_stream << "{\n";
+  io_stream << "  \"context\": {\n";
+  io_stream << "    \"date\": ";
+  writeJsonString( l_date, io_stream );
+  io_stream << ",\n";
+  io_stream << "    \"compiler\": ";
+#ifdef __VERSION__
+  writeJsonString( __VERSION__, io_stream );
+#else
+  writeJsonString( "unknown", io_stream );
+#endif
+  io_stream << ",\n";
+  io_stream << "    \"threads\": " << l_nThreads << ",\n";
+  io_stream << "    \"repetitions\": " << m_nRepetitions << ",\n";
+  io_stream << "    \"min_time\": " << m_minTime << "\n";
+  io_stream << "  },\n";
+  io_stream << "  \"benchmarks\": [";
+
+  for( t_idx l_re = 0; l_re < m_results.size(); l_re++ ) {
+    Result const & l_result = m_results[l_re];
+
+    io_stream << ((l_re == 0) ? "\n" : ",\n");
+    io_stream << "    { \"name\": ";
+    writeJsonString( l_result.m_name, io_stream );
+    io_stream << ", \"unit\": ";
+    writeJsonString( l_result.m_unit, io_stream );
+    io_stream << ", \"value\": " << l_result.m_value
+              << ", \"seconds_per_call\": " << l_result.m_seconds
+              << ", \"calls_per_repetition\": " << l_result.m_nCalls << " }";
+  }
+
+  io_stream << "\n  ]\n";
+  io_stream << "}\n";
+}
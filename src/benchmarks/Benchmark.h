@@ -0,0 +1,151 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Minimal framework for benchmarks with JSON output.
+ **/
+#ifndef TSUNAMI_LAB_BENCHMARKS_BENCHMARK
+#define TSUNAMI_LAB_BENCHMARKS_BENCHMARK
+
+#include "../constants.h"
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace benchmarks {
+    class Benchmark;
+  }
+}
+
+/**
+ * Runs registered benchmark cases and collects their results.
+ *
+ * A case is a function which measures kernels through measure and records the derived metrics through report.
+ * Cases register themselves at static initialization through registerCase, similar to the unit tests.
+ **/
+class tsunami_lab::benchmarks::Benchmark {
+  public:
+    //! function of a benchmark case
+    typedef void (*t_case)( Benchmark & io_benchmark );
+
+  private:
+    //! registered case
+    struct Case {
+      //! name of the case
+      std::string m_name;
+
+      //! function of the case
+      t_case m_function;
+    };
+
+    //! result of a measurement
+    struct Result {
+      //! name of the measurement, including its parameters
+      std::string m_name;
+
+      //! unit of the metric
+      std::string m_unit;
+
+      //! value of the metric
+      double m_value;
+
+      //! best time per call of the kernel in seconds
+      double m_seconds;
+
+      //! number of calls of the kernel per repetition
+      t_idx m_nCalls;
+    };
+
+    //! number of timed repetitions per measurement; the best one is reported
+    static t_idx constexpr m_nRepetitions = 5;
+
+    //! minimum total runtime of the repetitions of a measurement in seconds
+    double m_minTime = 0;
+
+    //! only cases whose names contain the filter are run
+    std::string m_filter;
+
+    //! results of all measurements
+    std::vector< Result > m_results;
+
+    //! best time per call of the last measurement in seconds
+    double m_lastSeconds = 0;
+
+    //! number of calls per repetition of the last measurement
+    t_idx m_lastCalls = 0;
+
+    /**
+     * Gets the registered cases.
+     *
+     * @return registered cases.
+     **/
+    static std::vector< Case > & getCases();
+
+    /**
+     * Writes a string as JSON string literal.
+     *
+     * @param i_string string which is written.
+     * @param io_stream stream to which the literal is written.
+     **/
+    static void writeJsonString( std::string const & i_string,
+                                 std::ostream      & io_stream );
+
+  public:
+    /**
+     * Registers a case.
+     *
+     * @param i_name name of the case.
+     * @param i_function function of the case.
+     * @return true.
+     **/
+    static bool registerCase( std::string const & i_name,
+                              t_case              i_function );
+
+    /**
+     * Constructor.
+     *
+     * @param i_minTime minimum total runtime of the repetitions of a measurement in seconds.
+     * @param i_filter only cases whose names contain the filter are run; empty runs all cases.
+     **/
+    Benchmark( double              i_minTime,
+               std::string const & i_filter );
+
+    /**
+     * Runs all selected cases in order of registration.
+     *
+     * @param io_log stream to which progress is written.
+     **/
+    void run( std::ostream & io_log );
+
+    /**
+     * Measures the time per call of a kernel.
+     * After a warm-up call, the number of calls per repetition is doubled until a repetition takes long enough.
+     * The best of several repetitions is returned, which filters out interference of other processes.
+     *
+     * @param i_kernel kernel which is measured.
+     * @return best time per call in seconds.
+     **/
+    double measure( std::function< void() > const & i_kernel );
+
+    /**
+     * Records a metric derived from the last measurement.
+     *
+     * @param i_name name of the measurement, including its parameters.
+     * @param i_unit unit of the metric.
+     * @param i_value value of the metric.
+     **/
+    void report( std::string const & i_name,
+                 std::string const & i_unit,
+                 double              i_value );
+
+    /**
+     * Writes all results and the context of the run as JSON.
+     *
+     * @param io_stream stream to which the results are written.
+     **/
+    void writeJson( std::ostream & io_stream ) const;
+};
+
+#endif
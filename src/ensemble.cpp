@@ -0,0 +1,264 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Entry-point for ensembles of one-dimensional dam break simulations.
+ **/
+#include "patches/WavePropagationEnsemble1d.h"
+#include "setups/DamBreak1d.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+int main( int   i_argc,
+          char *i_argv[] ) {
+  // number of cells
+  tsunami_lab::t_idx l_nx = 0;
+
+  // path of the per-member statistics
+  std::string l_outPath = "ensemble.csv";
+
+  // parse options
+  bool l_argsValid = true;
+  int l_opt = 0;
+  while( (l_opt = getopt( i_argc, i_argv, "o:" )) != -1 ) {
+    if( l_opt == 'o' ) {
+      l_outPath = optarg;
+    }
+    else {
+      l_argsValid = false;
+    }
+  }
+
+  if( !l_argsValid || i_argc - optind != 2 ) {
+    std::cerr << "invalid arguments, usage:" << std::endl;
+    std::cerr << "  ./build/ensemble [-o OUTPUT] MEMBERS N_CELLS_X" << std::endl;
+    std::cerr << "where MEMBERS is a CSV file with one dam break per line: heightLeft,heightRight,locationDam," << std::endl;
+    std::cerr << "N_CELLS_X is the number of cells in x-direction" << std::endl;
+    std::cerr << "and OUTPUT is the CSV file of the per-member statistics (default: ensemble.csv)." << std::endl;
+    std::cerr << "Empty lines and lines starting with # are ignored in MEMBERS." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  l_nx = atoi( i_argv[optind+1] );
+  if( l_nx < 1 ) {
+    std::cerr << "invalid number of cells" << std::endl;
+    return EXIT_FAILURE;
+  }
+  tsunami_lab::t_real l_dxy = 10.0 / l_nx;
+
+  // read the members' setups
+  std::vector< tsunami_lab::setups::DamBreak1d > l_setups;
+  std::vector< tsunami_lab::t_real > l_params;
+  {
+    std::ifstream l_file( i_argv[optind] );
+    if( !l_file ) {
+      std::cerr << "failed to open " << i_argv[optind] << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::string l_line;
+    tsunami_lab::t_idx l_lineNumber = 0;
+    while( std::getline( l_file, l_line ) ) {
+      l_lineNumber++;
+      if( l_line.empty() || l_line[0] == '#' ) continue;
+
+      std::replace( l_line.begin(), l_line.end(), ',', ' ' );
+      std::istringstream l_stream( l_line );
+      tsunami_lab::t_real l_heightLeft = 0;
+      tsunami_lab::t_real l_heightRight = 0;
+      tsunami_lab::t_real l_locationDam = 0;
+      if( !( l_stream >> l_heightLeft >> l_heightRight >> l_locationDam ) ) {
+        std::cerr << "invalid member in line " << l_lineNumber << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      l_setups.emplace_back( l_heightLeft,
+                             l_heightRight,
+                             l_locationDam );
+      l_params.insert( l_params.end(), { l_heightLeft, l_heightRight, l_locationDam } );
+    }
+  }
+  tsunami_lab::t_idx l_nMembers = l_setups.size();
+  if( l_nMembers == 0 ) {
+    std::cerr << "no members in " << i_argv[optind] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "runtime configuration" << std::endl;
+  std::cout << "  number of cells in x-direction: " << l_nx << std::endl;
+  std::cout << "  cell size:                      " << l_dxy << std::endl;
+  std::cout << "  number of members:              " << l_nMembers << std::endl;
+
+  // construct solver and set up the members
+  tsunami_lab::patches::WavePropagationEnsemble1d<> l_ensemble( l_nx,
+                                                                l_nMembers );
+  {
+    std::vector< tsunami_lab::t_real > l_h( l_nx );
+    std::vector< tsunami_lab::t_real > l_hu( l_nx );
+
+    for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+      l_setups[l_me].getValues( l_dxy,
+                                0,
+                                0,
+                                l_nx,
+                                1,
+                                l_nx,
+                                l_h.data(),
+                                l_hu.data(),
+                                nullptr,
+                                nullptr );
+
+      l_ensemble.setValues( l_me,
+                            0,
+                            l_nx,
+                            l_h.data(),
+                            l_hu.data() );
+    }
+  }
+
+  // CFL number used to derive the time steps from the maximum wave speeds
+  tsunami_lab::t_real l_cfl = 0.5;
+  tsunami_lab::t_real l_endTime = 1.25;
+
+  // per-member time stepping, which matches that of separate simulations
+  std::vector< tsunami_lab::t_idx >  l_timeSteps( l_nMembers, 0 );
+  std::vector< tsunami_lab::t_real > l_simTimes( l_nMembers, 0 );
+  std::vector< tsunami_lab::t_real > l_dts( l_nMembers, 0 );
+  std::vector< tsunami_lab::t_real > l_scalings( l_nMembers, 0 );
+  std::vector< tsunami_lab::t_real > l_speedsMax( l_nMembers, 0 );
+
+  // derive maximum wave speeds of the initial states: particle velocity plus gravity wave speed
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nx; l_ce++ ) {
+    for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+      tsunami_lab::t_real l_h = l_ensemble.getHeight()[l_ce * l_nMembers + l_me];
+      tsunami_lab::t_real l_hu = l_ensemble.getMomentumX()[l_ce * l_nMembers + l_me];
+
+      if( l_h > 0 ) {
+        tsunami_lab::t_real l_speed  = std::abs( l_hu ) / l_h;
+                            l_speed += std::sqrt( 9.81 * l_h );
+        l_speedsMax[l_me] = std::max( l_speed, l_speedsMax[l_me] );
+      }
+    }
+  }
+  tsunami_lab::t_idx l_nActive = l_nMembers;
+  for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+    if( l_speedsMax[l_me] > 0 ) {
+      l_dts[l_me] = l_cfl * l_dxy / l_speedsMax[l_me];
+    }
+    // members without waves, i.e., dry ones, are at rest: their state holds at the end time without time steps
+    else {
+      l_simTimes[l_me] = l_endTime;
+      l_nActive--;
+    }
+  }
+
+  std::cout << "entering time loop" << std::endl;
+  auto l_start = std::chrono::steady_clock::now();
+
+  tsunami_lab::t_idx l_nSteps = 0;
+  tsunami_lab::t_idx l_nUpdates = 0;
+  l_ensemble.setGhostOutflow();
+
+  while( l_nActive > 0 ) {
+    if( l_nSteps % 100 == 0 ) {
+      std::cout << "  #time steps / active members: "
+                << l_nSteps << " / " << l_nActive << std::endl;
+    }
+
+    // members which reached the end time keep their state
+    for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+      l_scalings[l_me] = ( l_simTimes[l_me] < l_endTime ) ? l_dts[l_me] / l_dxy : 0;
+    }
+
+    l_ensemble.timeStep( l_scalings.data(),
+                         l_speedsMax.data() );
+    l_nSteps++;
+    l_nUpdates += l_nActive;
+
+    for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+      if( l_scalings[l_me] == 0 ) continue;
+
+      l_timeSteps[l_me]++;
+      l_simTimes[l_me] += l_dts[l_me];
+
+      // adapt the time step to the maximum wave speed of the previous step
+      if( l_speedsMax[l_me] > 0 ) {
+        l_dts[l_me] = l_cfl * l_dxy / l_speedsMax[l_me];
+      }
+
+      if( l_simTimes[l_me] >= l_endTime ) {
+        l_nActive--;
+      }
+    }
+  }
+
+  double l_seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - l_start ).count();
+  std::cout << "finished time loop" << std::endl;
+  std::cout << "  #time steps:                    " << l_nSteps << std::endl;
+  std::cout << "  time:                           " << l_seconds << " s" << std::endl;
+  std::cout << "  throughput:                     " << l_nUpdates * l_nx / l_seconds * 1E-6
+            << " million cell updates per second" << std::endl;
+
+  // per-member statistics of the final state
+  std::vector< tsunami_lab::t_real > l_heightsMin( l_nMembers, std::numeric_limits< tsunami_lab::t_real >::max() );
+  std::vector< tsunami_lab::t_real > l_heightsMax( l_nMembers, 0 );
+  std::vector< tsunami_lab::t_real > l_momentaMax( l_nMembers, 0 );
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nx; l_ce++ ) {
+    for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+      tsunami_lab::t_real l_h = l_ensemble.getHeight()[l_ce * l_nMembers + l_me];
+      tsunami_lab::t_real l_hu = l_ensemble.getMomentumX()[l_ce * l_nMembers + l_me];
+
+      l_heightsMin[l_me] = std::min( l_h, l_heightsMin[l_me] );
+      l_heightsMax[l_me] = std::max( l_h, l_heightsMax[l_me] );
+      l_momentaMax[l_me] = std::max( std::abs( l_hu ), l_momentaMax[l_me] );
+    }
+  }
+
+  std::cout << "writing per-member statistics to " << l_outPath << std::endl;
+  std::ofstream l_out( l_outPath );
+  l_out << "member,heightLeft,heightRight,locationDam,timeSteps,simTime,heightMin,heightMax,momentumMax" << "\n";
+  for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+    l_out << l_me << ","
+          << l_params[l_me*3+0] << ","
+          << l_params[l_me*3+1] << ","
+          << l_params[l_me*3+2] << ","
+          << l_timeSteps[l_me] << ","
+          << l_simTimes[l_me] << ","
+          << l_heightsMin[l_me] << ","
+          << l_heightsMax[l_me] << ","
+          << l_momentaMax[l_me] << "\n";
+  }
+  l_out.close();
+  if( l_out.fail() ) {
+    std::cerr << "failed to write " << l_outPath << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // aggregated statistics over the members
+  double l_momentumMean = 0;
+  for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+    l_momentumMean += l_momentaMax[l_me];
+  }
+  l_momentumMean /= l_nMembers;
+
+  std::cout << "ensemble statistics of the final states" << std::endl;
+  std::cout << "  maximum height (min / max):     "
+            << *std::min_element( l_heightsMax.begin(), l_heightsMax.end() ) << " / "
+            << *std::max_element( l_heightsMax.begin(), l_heightsMax.end() ) << std::endl;
+  std::cout << "  maximum momentum (min / mean / max): "
+            << *std::min_element( l_momentaMax.begin(), l_momentaMax.end() ) << " / "
+            << l_momentumMean << " / "
+            << *std::max_element( l_momentaMax.begin(), l_momentaMax.end() ) << std::endl;
+
+  std::cout << "finished, exiting" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Hardware performance counters through perf_event_open.
+ **/
+#include "Counters.h"
+#include <cstring>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+tsunami_lab::instrumentation::Counters::Counters( bool i_enable ): m_requested( i_enable ) {
+#ifdef __linux__
+  if( !i_enable ) return;
+
+  int l_nThreads = 1;
+#ifdef _OPENMP
+  l_nThreads = omp_get_max_threads();
+#endif
+  m_fds.assign( l_nThreads * m_nEvents, -1 );
+
+  std::uint64_t const l_configs[m_nEvents] = { PERF_COUNT_HW_CPU_CYCLES,
+                                               PERF_COUNT_HW_INSTRUCTIONS,
+                                               PERF_COUNT_HW_CACHE_MISSES };
+
+  // every thread opens the counters of itself as a group led by the cycles, which is read at once
+#pragma omp parallel num_threads( l_nThreads )
+  {
+    t_idx l_th = 0;
+#ifdef _OPENMP
+    l_th = omp_get_thread_num();
+#endif
+    int * l_fds = m_fds.data() + l_th * m_nEvents;
+
+    for( unsigned short l_ev = 0; l_ev < m_nEvents; l_ev++ ) {
+      perf_event_attr l_attr;
+      std::memset( &l_attr, 0, sizeof(l_attr) );
+      l_attr.size = sizeof(l_attr);
+      l_attr.type = PERF_TYPE_HARDWARE;
+      l_attr.config = l_configs[l_ev];
+      l_attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      l_attr.exclude_kernel = 1;
+      l_attr.exclude_hv = 1;
+
+      // the members join the leader's group; skipped if the leader failed
+      if( l_ev > 0 && l_fds[0] < 0 ) continue;
+      l_fds[l_ev] = syscall( SYS_perf_event_open,
+                             &l_attr,
+                             0,
+                             -1,
+                             (l_ev == 0) ? -1 : l_fds[0],
+                             0 );
+    }
+  }
+
+  m_available = true;
+  for( int l_fd : m_fds ) {
+    if( l_fd < 0 ) m_available = false;
+  }
+  if( !m_available ) close();
+#else
+  (void) i_enable;
+#endif
+}
+
+tsunami_lab::instrumentation::Counters::~Counters() {
+  close();
+}
+
+void tsunami_lab::instrumentation::Counters::close() {
+  for( int & l_fd : m_fds ) {
+    if( l_fd >= 0 ) ::close( l_fd );
+    l_fd = -1;
+  }
+}
+
+void tsunami_lab::instrumentation::Counters::read( std::uint64_t o_values[m_nEvents] ) const {
+  for( unsigned short l_ev = 0; l_ev < m_nEvents; l_ev++ ) {
+    o_values[l_ev] = 0;
+  }
+  if( !m_available ) return;
+
+  // a single read per thread returns the group: number of events, time enabled, time running, values
+  for( t_idx l_id = 0; l_id < m_fds.size(); l_id += m_nEvents ) {
+    std::uint64_t l_data[3 + m_nEvents] = { 0 };
+    if( ::read( m_fds[l_id], l_data, sizeof(l_data) ) != sizeof(l_data) || l_data[0] != m_nEvents ) continue;
+
+    // extrapolate multiplexed counters; the group is scheduled as a whole
+    double l_scaling = 1;
+    if( l_data[2] > 0 && l_data[2] < l_data[1] ) {
+      l_scaling = double(l_data[1]) / l_data[2];
+    }
+    for( unsigned short l_ev = 0; l_ev < m_nEvents; l_ev++ ) {
+      o_values[l_ev] += (l_scaling == 1) ? l_data[3+l_ev]
+                                         : static_cast< std::uint64_t >( l_data[3+l_ev] * l_scaling );
+    }
+  }
+}
+
+char const * tsunami_lab::instrumentation::Counters::getName( unsigned short i_event ) {
+  char const * l_names[m_nEvents] = { "cycles",
+                                      "instructions",
+                                      "llc_misses" };
+  return (i_event < m_nEvents) ? l_names[i_event] : "unknown";
+}
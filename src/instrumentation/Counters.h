@@ -0,0 +1,100 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Hardware performance counters through perf_event_open.
+ **/
+#ifndef TSUNAMI_LAB_INSTRUMENTATION_COUNTERS
+#define TSUNAMI_LAB_INSTRUMENTATION_COUNTERS
+
+#include "../constants.h"
+#include <cstdint>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace instrumentation {
+    class Counters;
+  }
+}
+
+/**
+ * Counts cycles, instructions and last-level cache misses of all OpenMP threads.
+ *
+ * Every thread of the OpenMP thread pool opens its own counters at construction, grouped such that a single read returns all events.
+ * The pool is reused by later parallel regions, thus the counters cover all parallel work of the same team size.
+ * Threads which are not part of the pool (e.g., the writer thread of the output) are not counted.
+ * If the counters can't be opened, e.g., due to kernel.perf_event_paranoid or missing PMU access in containers,
+ * the counters are unavailable and all reads return zero.
+ **/
+class tsunami_lab::instrumentation::Counters {
+  public:
+    //! number of events
+    static unsigned short constexpr m_nEvents = 3;
+
+  private:
+    //! file descriptors of the events; entry thread * m_nEvents + event, where event 0 leads the thread's group
+    std::vector< int > m_fds;
+
+    //! true if the counters were requested at construction
+    bool m_requested = false;
+
+    //! true if all counters were opened successfully
+    bool m_available = false;
+
+    /**
+     * Closes all open file descriptors.
+     **/
+    void close();
+
+  public:
+    /**
+     * Constructor which opens the counters of all OpenMP threads.
+     *
+     * @param i_enable false disables the counters without trying to open them.
+     **/
+    Counters( bool i_enable = true );
+
+    /**
+     * Destructor which closes the counters.
+     **/
+    ~Counters();
+
+    Counters( Counters const & ) = delete;
+    Counters & operator=( Counters const & ) = delete;
+
+    /**
+     * Checks whether the counters were requested, i.e., enabled at construction.
+     *
+     * @return true if requested, false otherwise.
+     **/
+    bool isRequested() const {
+      return m_requested;
+    }
+
+    /**
+     * Checks whether the counters are available.
+     *
+     * @return true if available, false otherwise.
+     **/
+    bool isAvailable() const {
+      return m_available;
+    }
+
+    /**
+     * Reads the counters through one system call per thread, summed over all threads and extrapolated if the kernel multiplexed them.
+     * Extrapolated values are estimates: a later read may return less than an earlier one.
+     *
+     * @param o_values will be set to the values of the events; zero if unavailable.
+     **/
+    void read( std::uint64_t o_values[m_nEvents] ) const;
+
+    /**
+     * Gets the name of an event.
+     *
+     * @param i_event id of the event.
+     * @return name of the event.
+     **/
+    static char const * getName( unsigned short i_event );
+};
+
+#endif
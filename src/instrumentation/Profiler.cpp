@@ -0,0 +1,129 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Scoped region timers with optional hardware counters.
+ **/
+#include "Profiler.h"
+#include <iomanip>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+tsunami_lab::instrumentation::Profiler::Scope::Scope( Profiler & io_profiler,
+                                                      t_idx      i_region ): m_profiler( io_profiler ),
+                                                                             m_region( i_region ) {
+  m_profiler.m_counters.read( m_counters );
+  m_start = t_clock::now();
+}
+
+tsunami_lab::instrumentation::Profiler::Scope::~Scope() {
+  t_clock::time_point l_end = t_clock::now();
+
+  std::uint64_t l_counters[Counters::m_nEvents];
+  m_profiler.m_counters.read( l_counters );
+
+  Region & l_region = m_profiler.m_regions[m_region];
+  l_region.m_nCalls++;
+  l_region.m_seconds += std::chrono::duration< double >( l_end - m_start ).count();
+  // multiplexed counters are extrapolated with different scalings at entry and exit, thus the difference may be negative
+  for( unsigned short l_ev = 0; l_ev < Counters::m_nEvents; l_ev++ ) {
+    if( l_counters[l_ev] > m_counters[l_ev] ) {
+      l_region.m_counters[l_ev] += l_counters[l_ev] - m_counters[l_ev];
+    }
+  }
+}
+
+tsunami_lab::instrumentation::Profiler::Profiler( bool i_counters ): m_counters( i_counters ) {
+  m_start = t_clock::now();
+}
+
+tsunami_lab::t_idx tsunami_lab::instrumentation::Profiler::addRegion( std::string const & i_name ) {
+  m_regions.emplace_back();
+  m_regions.back().m_name = i_name;
+
+  return m_regions.size() - 1;
+}
+
+void tsunami_lab::instrumentation::Profiler::writeTable( std::ostream & io_stream ) const {
+  double l_total = std::chrono::duration< double >( t_clock::now() - m_start ).count();
+
+  io_stream << std::left  << std::setw( 18 ) << "region"
+            << std::right << std::setw( 10 ) << "calls"
+                          << std::setw( 12 ) << "time [s]"
+                          << std::setw( 9 )  << "share"
+                          << std::setw( 16 ) << "per call [ms]";
+  if( hasCounters() ) {
+    io_stream << std::setw( 16 ) << "cycles"
+              << std::setw( 16 ) << "instructions"
+              << std::setw( 7 )  << "IPC"
+              << std::setw( 14 ) << "LLC misses";
+  }
+  io_stream << std::endl;
+
+  for( Region const & l_region : m_regions ) {
+    double l_perCall = (l_region.m_nCalls > 0) ? l_region.m_seconds / l_region.m_nCalls : 0;
+    double l_share = (l_total > 0) ? l_region.m_seconds / l_total : 0;
+
+    io_stream << std::left  << std::setw( 18 ) << l_region.m_name
+              << std::right << std::setw( 10 ) << l_region.m_nCalls
+              << std::fixed
+              << std::setw( 12 ) << std::setprecision( 4 ) << l_region.m_seconds
+              << std::setw( 8 )  << std::setprecision( 1 ) << 100 * l_share << "%"
+              << std::setw( 16 ) << std::setprecision( 4 ) << 1E3 * l_perCall;
+
+    if( hasCounters() ) {
+      double l_ipc = 0;
+      if( l_region.m_counters[0] > 0 ) l_ipc = double(l_region.m_counters[1]) / l_region.m_counters[0];
+
+      io_stream << std::setw( 16 ) << l_region.m_counters[0]
+                << std::setw( 16 ) << l_region.m_counters[1]
+                << std::setw( 7 )  << std::setprecision( 2 ) << l_ipc
+                << std::setw( 14 ) << l_region.m_counters[2];
+    }
+    io_stream << std::defaultfloat << std::endl;
+  }
+
+  io_stream << std::left << std::setw( 18 ) << "total"
+            << std::right << std::setw( 22 ) << std::fixed << std::setprecision( 4 ) << l_total
+            << std::defaultfloat << std::endl;
+  // only noted if requested, the counters are opt-in
+  if( m_counters.isRequested() && !hasCounters() ) {
+    io_stream << "hardware counters unavailable" << std::endl;
+  }
+}
+
+void tsunami_lab::instrumentation::Profiler::writeJson( std::ostream & io_stream ) const {
+  double l_total = std::chrono::duration< double >( t_clock::now() - m_start ).count();
+
+  int l_nThreads = 1;
+#ifdef _OPENMP
+  l_nThreads = omp_get_max_threads();
+#endif
+
+  io_stream << std::setprecision( 9 );
+  io_stream << "{\n";
+  io_stream << "  \"threads\": " << l_nThreads << ",\n";
+  io_stream << "  \"counters\": " << (hasCounters() ? "true" : "false") << ",\n";
+  io_stream << "  \"total_seconds\": " << l_total << ",\n";
+  io_stream << "  \"regions\": [";
+
+  for( t_idx l_re = 0; l_re < m_regions.size(); l_re++ ) {
+    Region const & l_region = m_regions[l_re];
+
+    io_stream << ((l_re == 0) ? "\n" : ",\n");
+    io_stream << "    { \"name\": \"" << l_region.m_name << "\""
+              << ", \"calls\": " << l_region.m_nCalls
+              << ", \"seconds\": " << l_region.m_seconds;
+
+    for( unsigned short l_ev = 0; l_ev < Counters::m_nEvents; l_ev++ ) {
+      io_stream << ", \"" << Counters::getName( l_ev ) << "\": ";
+      if( hasCounters() ) io_stream << l_region.m_counters[l_ev];
+      else                io_stream << "null";
+    }
+    io_stream << " }";
+  }
+
+  io_stream << "\n  ]\n";
+  io_stream << "}\n";
+}
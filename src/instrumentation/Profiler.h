@@ -0,0 +1,160 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Scoped region timers with optional hardware counters.
+ **/
+#ifndef TSUNAMI_LAB_INSTRUMENTATION_PROFILER
+#define TSUNAMI_LAB_INSTRUMENTATION_PROFILER
+
+#include "../constants.h"
+#include "Counters.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace instrumentation {
+    class Profiler;
+  }
+}
+
+/**
+ * Accumulates the wall time and hardware counters of named regions.
+ *
+ * Regions are registered once and then entered through Scope objects, whose lifetime defines the measured interval.
+ * Scopes may be nested, in which case the inner regions are included in the outer ones.
+ * Scopes have to be used from the initial thread outside of parallel regions.
+ **/
+class tsunami_lab::instrumentation::Profiler {
+  public:
+    //! clock of the timers
+    typedef std::chrono::steady_clock t_clock;
+
+  private:
+    //! accumulated measurements of a region
+    struct Region {
+      //! name of the region; used as key of the machine-readable report, thus no quotes or backslashes
+      std::string m_name;
+
+      //! number of times the region was entered
+      t_idx m_nCalls = 0;
+
+      //! accumulated wall time in seconds
+      double m_seconds = 0;
+
+      //! accumulated hardware counters
+      std::uint64_t m_counters[Counters::m_nEvents] = { 0 };
+    };
+
+    //! regions in order of registration
+    std::vector< Region > m_regions;
+
+    //! hardware counters
+    Counters m_counters;
+
+    //! time of construction
+    t_clock::time_point m_start;
+
+  public:
+    /**
+     * Measures a region from construction to destruction.
+     **/
+    class Scope {
+      private:
+        //! profiler to which the measurement is added
+        Profiler & m_profiler;
+
+        //! id of the region
+        t_idx m_region;
+
+        //! hardware counters at the beginning
+        std::uint64_t m_counters[Counters::m_nEvents];
+
+        //! time at the beginning
+        t_clock::time_point m_start;
+
+      public:
+        /**
+         * Constructor which starts the measurement.
+         *
+         * @param io_profiler profiler to which the measurement is added.
+         * @param i_region id of the region.
+         **/
+        Scope( Profiler & io_profiler,
+               t_idx      i_region );
+
+        /**
+         * Destructor which stops the measurement and adds it to the region.
+         **/
+        ~Scope();
+
+        Scope( Scope const & ) = delete;
+        Scope & operator=( Scope const & ) = delete;
+    };
+
+    /**
+     * Constructor.
+     * The hardware counters are opt-in since every scope reads them at entry and exit, one system call per thread each.
+     *
+     * @param i_counters true if hardware counters should be read, if available.
+     **/
+    Profiler( bool i_counters = false );
+
+    /**
+     * Registers a region.
+     *
+     * @param i_name name of the region.
+     * @return id of the region.
+     **/
+    t_idx addRegion( std::string const & i_name );
+
+    /**
+     * Checks whether hardware counters are available.
+     *
+     * @return true if available, false otherwise.
+     **/
+    bool hasCounters() const {
+      return m_counters.isAvailable();
+    }
+
+    /**
+     * Gets the number of times a region was entered.
+     *
+     * @param i_region id of the region.
+     * @return number of calls.
+     **/
+    t_idx getCalls( t_idx i_region ) const {
+      return m_regions[i_region].m_nCalls;
+    }
+
+    /**
+     * Gets the accumulated wall time of a region.
+     *
+     * @param i_region id of the region.
+     * @return wall time in seconds.
+     **/
+    double getSeconds( t_idx i_region ) const {
+      return m_regions[i_region].m_seconds;
+    }
+
+    /**
+     * Writes a human-readable summary of all regions.
+     * The shares refer to the wall time since construction.
+     *
+     * @param io_stream stream to which the summary is written.
+     **/
+    void writeTable( std::ostream & io_stream ) const;
+
+    /**
+     * Writes a machine-readable report of all regions as JSON.
+     * Counters are null if unavailable.
+     *
+     * @param io_stream stream to which the report is written.
+     **/
+    void writeJson( std::ostream & io_stream ) const;
+};
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the instrumentation.
+ **/
+#include <catch2/catch.hpp>
+#include "Profiler.h"
+#include <sstream>
+#include <thread>
+
+TEST_CASE( "Test the scoped region timers.", "[Profiler]" ) {
+  for( bool l_counters : { false, true } ) {
+    // counters are optional, thus the timers have to work either way
+    tsunami_lab::instrumentation::Profiler l_profiler( l_counters );
+    if( !l_counters ) REQUIRE( !l_profiler.hasCounters() );
+
+    tsunami_lab::t_idx l_regOuter = l_profiler.addRegion( "outer" );
+    tsunami_lab::t_idx l_regInner = l_profiler.addRegion( "inner" );
+    REQUIRE( l_regOuter == 0 );
+    REQUIRE( l_regInner == 1 );
+
+    REQUIRE( l_profiler.getCalls( l_regOuter ) == 0 );
+    REQUIRE( l_profiler.getSeconds( l_regOuter ) == 0 );
+
+    {
+      tsunami_lab::instrumentation::Profiler::Scope l_scopeOuter( l_profiler,
+                                                                  l_regOuter );
+      for( unsigned short l_it = 0; l_it < 3; l_it++ ) {
+        tsunami_lab::instrumentation::Profiler::Scope l_scopeInner( l_profiler,
+                                                                    l_regInner );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+      }
+    }
+
+    REQUIRE( l_profiler.getCalls( l_regOuter ) == 1 );
+    REQUIRE( l_profiler.getCalls( l_regInner ) == 3 );
+
+    // nested regions are included in the outer ones
+    REQUIRE( l_profiler.getSeconds( l_regInner ) >= 0.006 );
+    REQUIRE( l_profiler.getSeconds( l_regOuter ) >= l_profiler.getSeconds( l_regInner ) );
+
+    std::ostringstream l_table;
+    l_profiler.writeTable( l_table );
+    REQUIRE( l_table.str().find( "inner" ) != std::string::npos );
+    REQUIRE( l_table.str().find( "total" ) != std::string::npos );
+    if( !l_counters ) {
+      REQUIRE( l_table.str().find( "unavailable" ) == std::string::npos );
+    }
+
+    std::ostringstream l_json;
+    l_profiler.writeJson( l_json );
+    REQUIRE( l_json.str().find( "\"name\": \"outer\", \"calls\": 1" ) != std::string::npos );
+    REQUIRE( l_json.str().find( "\"name\": \"inner\", \"calls\": 3" ) != std::string::npos );
+    if( !l_profiler.hasCounters() ) {
+      REQUIRE( l_json.str().find( "\"cycles\": null" ) != std::string::npos );
+    }
+  }
+}
+
+TEST_CASE( "Test the hardware counters.", "[Counters]" ) {
+  tsunami_lab::instrumentation::Counters l_disabled( false );
+  REQUIRE( !l_disabled.isRequested() );
+  REQUIRE( !l_disabled.isAvailable() );
+
+  std::uint64_t l_values[tsunami_lab::instrumentation::Counters::m_nEvents] = { 1, 1, 1 };
+  l_disabled.read( l_values );
+  REQUIRE( l_values[0] == 0 );
+  REQUIRE( l_values[1] == 0 );
+  REQUIRE( l_values[2] == 0 );
+
+  REQUIRE( std::string( tsunami_lab::instrumentation::Counters::getName( 1 ) ) == "instructions" );
+
+  // availability depends on the system; if available, the counters increase
+  tsunami_lab::instrumentation::Counters l_counters;
+  REQUIRE( l_counters.isRequested() );
+  if( l_counters.isAvailable() ) {
+    std::uint64_t l_before[tsunami_lab::instrumentation::Counters::m_nEvents];
+    std::uint64_t l_after[tsunami_lab::instrumentation::Counters::m_nEvents];
+
+    l_counters.read( l_before );
+    volatile double l_sum = 0;
+    for( int l_it = 0; l_it < 100000; l_it++ ) l_sum = l_sum + l_it;
+    l_counters.read( l_after );
+
+    REQUIRE( l_after[0] > l_before[0] );
+    REQUIRE( l_after[1] > l_before[1] );
+  }
+}
@@ -0,0 +1,177 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Asynchronous output of snapshots through a background thread.
+ **/
+#include "AsyncWriter.h"
+#include "Binary.h"
+#include "Compressed.h"
+#include "Csv.h"
+#include <cstring>
+#include <fstream>
+
+tsunami_lab::io::AsyncWriter::AsyncWriter( t_idx i_nBuffers,
+                                           int   i_nThreads ) {
+  if( i_nBuffers < 1 ) i_nBuffers = 1;
+  m_nThreads = (i_nThreads < 1) ? 1 : i_nThreads;
+
+  m_snapshots.resize( i_nBuffers );
+  for( t_idx l_bu = 0; l_bu < i_nBuffers; l_bu++ ) {
+    m_free.push_back( l_bu );
+  }
+
+  m_thread = std::thread( &AsyncWriter::run, this );
+}
+
+tsunami_lab::io::AsyncWriter::~AsyncWriter() {
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    m_finish = true;
+  }
+  m_cond.notify_all();
+
+  m_thread.join();
+}
+
+void tsunami_lab::io::AsyncWriter::run() {
+  std::unique_lock< std::mutex > l_lock( m_mutex );
+
+  while( true ) {
+    m_cond.wait( l_lock, [this]{ return !m_queue.empty() || m_finish; } );
+
+    // the queue is drained before finishing
+    if( m_queue.empty() ) break;
+
+    t_idx l_bu = m_queue.front();
+    m_queue.pop_front();
+    m_nWriting++;
+
+    // serialize without holding the lock; the staging buffer is owned by this thread until returned
+    l_lock.unlock();
+    bool l_success = write( m_snapshots[l_bu],
+                           m_nThreads );
+    l_lock.lock();
+
+    if( !l_success ) m_nFailed++;
+    m_nWriting--;
+    m_free.push_back( l_bu );
+    m_cond.notify_all();
+  }
+}
+
+bool tsunami_lab::io::AsyncWriter::write( Snapshot const & i_snapshot,
+                                          int              i_nThreads ) {
+  t_real const * l_fields[3] = { nullptr, nullptr, nullptr };
+  for( unsigned short l_fi = 0; l_fi < 3; l_fi++ ) {
+    if( i_snapshot.m_present[l_fi] ) {
+      l_fields[l_fi] = i_snapshot.m_data[l_fi].data();
+    }
+  }
+
+  if( i_snapshot.m_format == "binary" ) {
+    return Binary::write( i_snapshot.m_path,
+                          i_snapshot.m_dxy,
+                          i_snapshot.m_nx,
+                          i_snapshot.m_ny,
+                          i_snapshot.m_nx,
+                          i_snapshot.m_time,
+                          l_fields[0],
+                          l_fields[1],
+                          l_fields[2],
+                          i_nThreads );
+  }
+  else if( i_snapshot.m_format == "compressed" ) {
+    return Compressed::write( i_snapshot.m_path,
+                              i_snapshot.m_dxy,
+                              i_snapshot.m_nx,
+                              i_snapshot.m_ny,
+                              i_snapshot.m_nx,
+                              i_snapshot.m_time,
+                              l_fields[0],
+                              l_fields[1],
+                              l_fields[2],
+                              i_nThreads );
+  }
+  else {
+    std::ofstream l_file;
+    l_file.open( i_snapshot.m_path );
+
+    Csv::write( i_snapshot.m_dxy,
+                i_snapshot.m_nx,
+                i_snapshot.m_ny,
+                i_snapshot.m_nx,
+                l_fields[0],
+                l_fields[1],
+                l_fields[2],
+                l_file,
+                i_nThreads,
+                i_snapshot.m_offsetX );
+    l_file.close();
+
+    return !l_file.fail();
+  }
+}
+
+void tsunami_lab::io::AsyncWriter::submit( std::string const & i_path,
+                                           std::string const & i_format,
+                                           t_real              i_dxy,
+                                           t_idx               i_nx,
+                                           t_idx               i_ny,
+                                           t_idx               i_stride,
+                                           t_real              i_time,
+                                           t_real      const * i_h,
+                                           t_real      const * i_hu,
+                                           t_real      const * i_hv,
+                                           t_idx               i_offsetX ) {
+  // wait for a free staging buffer
+  t_idx l_bu = 0;
+  {
+    std::unique_lock< std::mutex > l_lock( m_mutex );
+    m_cond.wait( l_lock, [this]{ return !m_free.empty(); } );
+
+    l_bu = m_free.front();
+    m_free.pop_front();
+  }
+
+  // copy the snapshot; the buffer's memory is reused if large enough
+  Snapshot & l_snapshot = m_snapshots[l_bu];
+  l_snapshot.m_path = i_path;
+  l_snapshot.m_format = i_format;
+  l_snapshot.m_dxy = i_dxy;
+  l_snapshot.m_nx = i_nx;
+  l_snapshot.m_ny = i_ny;
+  l_snapshot.m_offsetX = i_offsetX;
+  l_snapshot.m_time = i_time;
+
+  t_real const * l_fields[3] = { i_h, i_hu, i_hv };
+  for( unsigned short l_fi = 0; l_fi < 3; l_fi++ ) {
+    l_snapshot.m_present[l_fi] = l_fields[l_fi] != nullptr;
+    if( l_fields[l_fi] == nullptr ) continue;
+
+    l_snapshot.m_data[l_fi].resize( i_nx * i_ny );
+    t_real * l_out = l_snapshot.m_data[l_fi].data();
+    t_real const * l_in = l_fields[l_fi];
+
+#pragma omp parallel for schedule(static)
+    for( t_idx l_iy = 0; l_iy < i_ny; l_iy++ ) {
+      std::memcpy( l_out + l_iy * i_nx,
+                   l_in  + l_iy * i_stride,
+                   i_nx * sizeof(t_real) );
+    }
+  }
+
+  // hand the buffer to the writer thread
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    m_queue.push_back( l_bu );
+  }
+  m_cond.notify_all();
+}
+
+tsunami_lab::t_idx tsunami_lab::io::AsyncWriter::flush() {
+  std::unique_lock< std::mutex > l_lock( m_mutex );
+  m_cond.wait( l_lock, [this]{ return m_queue.empty() && m_nWriting == 0; } );
+
+  return m_nFailed;
+}
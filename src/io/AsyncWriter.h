@@ -0,0 +1,164 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Asynchronous output of snapshots through a background thread.
+ **/
+#ifndef TSUNAMI_LAB_IO_ASYNC_WRITER
+#define TSUNAMI_LAB_IO_ASYNC_WRITER
+
+#include "../constants.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace io {
+    class AsyncWriter;
+  }
+}
+
+/**
+ * Writes snapshots in the background.
+ *
+ * A submitted snapshot is copied into one of a fixed number of reusable staging buffers.
+ * A writer thread serializes the staged copies in submission order, while the caller continues.
+ * If all staging buffers are in use, a submission blocks until the writer thread frees one (backpressure).
+ * The writer thread formats and compresses with a small number of OpenMP threads,
+ * since a full team would compete with the solver's threads for the cores.
+ **/
+class tsunami_lab::io::AsyncWriter {
+  private:
+    //! staged copy of a snapshot
+    struct Snapshot {
+      //! path of the output file
+      std::string m_path;
+
+      //! output format: csv, binary or compressed
+      std::string m_format;
+
+      //! cell width in x- and y-direction
+      t_real m_dxy = 0;
+
+      //! number of cells in x-direction
+      t_idx m_nx = 0;
+
+      //! number of cells in y-direction
+      t_idx m_ny = 0;
+
+      //! global index of the first cell in x-direction
+      t_idx m_offsetX = 0;
+
+      //! simulation time
+      t_real m_time = 0;
+
+      //! true if the respective field is present; 0: heights, 1: momenta in x-direction, 2: momenta in y-direction
+      bool m_present[3] = { false, false, false };
+
+      //! stride-free copies of the fields
+      std::vector< t_real > m_data[3];
+    };
+
+    //! staging buffers
+    std::vector< Snapshot > m_snapshots;
+
+    //! ids of the staging buffers which are free
+    std::deque< t_idx > m_free;
+
+    //! ids of the staging buffers which wait for the writer thread, in submission order
+    std::deque< t_idx > m_queue;
+
+    //! number of snapshots which are currently written by the writer thread
+    t_idx m_nWriting = 0;
+
+    //! number of snapshots which could not be written
+    t_idx m_nFailed = 0;
+
+    //! true if the writer thread has to finish
+    bool m_finish = false;
+
+    //! protects the members above
+    std::mutex m_mutex;
+
+    //! signals changes of the members above
+    std::condition_variable m_cond;
+
+    //! number of OpenMP threads which the writer thread uses to serialize a snapshot
+    int m_nThreads = 1;
+
+    //! writer thread
+    std::thread m_thread;
+
+    /**
+     * Loop of the writer thread.
+     **/
+    void run();
+
+    /**
+     * Writes a staged snapshot to disk.
+     *
+     * @param i_snapshot snapshot which is written.
+     * @param i_nThreads number of OpenMP threads which serialize the snapshot.
+     * @return true if successful, false otherwise.
+     **/
+    static bool write( Snapshot const & i_snapshot,
+                       int              i_nThreads );
+
+  public:
+    /**
+     * Constructor which starts the writer thread.
+     *
+     * @param i_nBuffers number of staging buffers, i.e., the capacity of the queue; 2 gives double buffering.
+     * @param i_nThreads number of OpenMP threads which the writer thread uses to serialize a snapshot.
+     **/
+    AsyncWriter( t_idx i_nBuffers = 2,
+                 int   i_nThreads = 1 );
+
+    /**
+     * Destructor which writes all pending snapshots and joins the writer thread.
+     **/
+    ~AsyncWriter();
+
+    AsyncWriter( AsyncWriter const & ) = delete;
+    AsyncWriter & operator=( AsyncWriter const & ) = delete;
+
+    /**
+     * Copies a snapshot into a staging buffer and queues it for writing.
+     * Blocks while all staging buffers are in use.
+     *
+     * @param i_path path of the output file.
+     * @param i_format output format: csv, binary or compressed.
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_stride stride of the data arrays in y-direction (x is assumed to be stride-1).
+     * @param i_time simulation time of the snapshot.
+     * @param i_h water height of the cells; optional: use nullptr if not required.
+     * @param i_hu momentum in x-direction of the cells; optional: use nullptr if not required.
+     * @param i_hv momentum in y-direction of the cells; optional: use nullptr if not required.
+     * @param i_offsetX global index of the first cell in x-direction, e.g., of a rank's subdomain; only the CSV format records it.
+     **/
+    void submit( std::string const & i_path,
+                 std::string const & i_format,
+                 t_real              i_dxy,
+                 t_idx               i_nx,
+                 t_idx               i_ny,
+                 t_idx               i_stride,
+                 t_real              i_time,
+                 t_real      const * i_h,
+                 t_real      const * i_hu,
+                 t_real      const * i_hv,
+                 t_idx               i_offsetX = 0 );
+
+    /**
+     * Waits until all submitted snapshots are written.
+     *
+     * @return number of snapshots which could not be written since construction.
+     **/
+    t_idx flush();
+};
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the asynchronous output of snapshots.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "AsyncWriter.h"
+#include "Binary.h"
+#include "Compressed.h"
+
+TEST_CASE( "Test the asynchronous writer with more snapshots than staging buffers.", "[AsyncWriter]" ) {
+  // define a simple example with a stride of 4 and a ghost cell layer
+  tsunami_lab::t_real l_h[16]  = {  0,  1,  2,  3,
+                                    4,  5,  6,  7,
+                                    8,  9, 10, 11,
+                                   12, 13, 14, 15 };
+  tsunami_lab::t_real l_hu[16] = { 15, 14, 13, 12,
+                                   11, 10,  9,  8,
+                                    7,  6,  5,  4,
+                                    3,  2,  1,  0 };
+
+  {
+    tsunami_lab::io::AsyncWriter l_writer( 2 );
+
+    // the input is modified after every submission; the staged copies have to be unaffected
+    for( unsigned short l_sn = 0; l_sn < 5; l_sn++ ) {
+      l_writer.submit( "test_async_" + std::to_string(l_sn) + ".binary",
+                       "binary",
+                       10,
+                       2,
+                       2,
+                       4,
+                       l_sn,
+                       l_h+4+1,
+                       l_hu+4+1,
+                       nullptr );
+
+      for( unsigned short l_ce = 0; l_ce < 16; l_ce++ ) {
+        l_h[l_ce] += 100;
+      }
+    }
+
+    l_writer.submit( "test_async.csv",
+                     "csv",
+                     10,
+                     2,
+                     2,
+                     4,
+                     0,
+                     l_h+4+1,
+                     l_hu+4+1,
+                     nullptr );
+
+    l_writer.submit( "test_async.compressed",
+                     "compressed",
+                     10,
+                     2,
+                     2,
+                     4,
+                     0,
+                     l_h+4+1,
+                     nullptr,
+                     nullptr );
+
+    REQUIRE( l_writer.flush() == 0 );
+  }
+
+  for( unsigned short l_sn = 0; l_sn < 5; l_sn++ ) {
+    std::string l_path = "test_async_" + std::to_string(l_sn) + ".binary";
+    {
+      tsunami_lab::io::Binary l_snapshot( l_path );
+      REQUIRE( l_snapshot.isValid() );
+      REQUIRE( l_snapshot.getHeader().m_time == l_sn );
+
+      REQUIRE( l_snapshot.getHeight()[0] ==  5 + 100 * l_sn );
+      REQUIRE( l_snapshot.getHeight()[1] ==  6 + 100 * l_sn );
+      REQUIRE( l_snapshot.getHeight()[2] ==  9 + 100 * l_sn );
+      REQUIRE( l_snapshot.getHeight()[3] == 10 + 100 * l_sn );
+
+      REQUIRE( l_snapshot.getMomentumX()[0] == 10 );
+      REQUIRE( l_snapshot.getMomentumX()[3] ==  5 );
+      REQUIRE( l_snapshot.getMomentumY() == nullptr );
+    }
+    std::remove( l_path.c_str() );
+  }
+
+  {
+    tsunami_lab::io::Compressed l_snapshot( "test_async.compressed" );
+    REQUIRE( l_snapshot.isValid() );
+
+    tsunami_lab::t_real l_hRead[4] = { 0 };
+    REQUIRE( l_snapshot.read( tsunami_lab::io::Compressed::m_maskHeight, l_hRead ) );
+    REQUIRE( l_hRead[0] == 505 );
+    REQUIRE( l_hRead[3] == 510 );
+  }
+  std::remove( "test_async.compressed" );
+
+  std::ifstream l_file( "test_async.csv" );
+  std::stringstream l_stream;
+  l_stream << l_file.rdbuf();
+
+  std::string l_ref = R"V0G0N(x,y,height,momentum_x
+5,5,505,10
+15,5,506,9
+5,15,509,6
+15,15,510,5
+)V0G0N";
+
+  REQUIRE( l_stream.str() == l_ref );
+  std::remove( "test_async.csv" );
+}
@@ -0,0 +1,176 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for writing and reading snapshots in a compact binary format.
+ **/
+#include "Binary.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static_assert( sizeof(tsunami_lab::io::Binary::Header) == tsunami_lab::io::Binary::m_alignment,
+               "header has to fill exactly one alignment unit" );
+
+std::size_t tsunami_lab::io::Binary::fieldSize( t_idx i_nx,
+                                                t_idx i_ny ) {
+  std::size_t l_size = i_nx * i_ny * sizeof(t_real);
+  return (l_size + m_alignment - 1) / m_alignment * m_alignment;
+}
+
+bool tsunami_lab::io::Binary::write( std::string const & i_path,
+                                     t_real              i_dxy,
+                                     t_idx               i_nx,
+                                     t_idx               i_ny,
+                                     t_idx               i_stride,
+                                     t_real              i_time,
+                                     t_real      const * i_h,
+                                     t_real      const * i_hu,
+                                     t_real      const * i_hv,
+                                     int                 i_nThreads ) {
+  // copying threads; the background writer uses few, which leaves the cores to the solver
+  int l_nThreads = 1;
+#ifdef _OPENMP
+  l_nThreads = (i_nThreads > 0) ? i_nThreads : omp_get_max_threads();
+#endif
+
+  t_real const * l_fields[3] = { i_h, i_hu, i_hv };
+
+  // assemble header
+  Header l_header;
+  std::memset( &l_header, 0, sizeof(Header) );
+  std::memcpy( l_header.m_magic, m_magic, sizeof(m_magic) );
+  l_header.m_version = m_formatVersion;
+  l_header.m_realSize = sizeof(t_real);
+  l_header.m_nx = i_nx;
+  l_header.m_ny = i_ny;
+  l_header.m_dxy = i_dxy;
+  l_header.m_time = i_time;
+
+  std::size_t l_size = sizeof(Header);
+  for( unsigned short l_fi = 0; l_fi < 3; l_fi++ ) {
+    if( l_fields[l_fi] != nullptr ) {
+      l_header.m_fieldMask |= 1u << l_fi;
+      l_size += fieldSize( i_nx, i_ny );
+    }
+  }
+
+  // size the file and map it
+  int l_fd = open( i_path.c_str(),
+                   O_RDWR | O_CREAT | O_TRUNC,
+                   0644 );
+  if( l_fd < 0 ) return false;
+
+  if( ftruncate( l_fd, l_size ) != 0 ) {
+    close( l_fd );
+    return false;
+  }
+
+  void * l_map = mmap( nullptr,
+                       l_size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED,
+                       l_fd,
+                       0 );
+  if( l_map == MAP_FAILED ) {
+    close( l_fd );
+    return false;
+  }
+  char * l_data = static_cast< char * >( l_map );
+
+  // copy header and fields, removing the stride of the data arrays
+  std::memcpy( l_data, &l_header, sizeof(Header) );
+
+  char * l_field = l_data + sizeof(Header);
+  for( unsigned short l_fi = 0; l_fi < 3; l_fi++ ) {
+    if( l_fields[l_fi] == nullptr ) continue;
+
+    t_real * l_out = reinterpret_cast< t_real * >( l_field );
+    t_real const * l_in = l_fields[l_fi];
+
+#pragma omp parallel for num_threads( l_nThreads ) schedule(static)
+    for( t_idx l_iy = 0; l_iy < i_ny; l_iy++ ) {
+      std::memcpy( l_out + l_iy * i_nx,
+                   l_in  + l_iy * i_stride,
+                   i_nx * sizeof(t_real) );
+    }
+
+    l_field += fieldSize( i_nx, i_ny );
+  }
+
+  bool l_success = munmap( l_map, l_size ) == 0;
+  l_success = (close( l_fd ) == 0) && l_success;
+
+  return l_success;
+}
+
+tsunami_lab::io::Binary::Binary( std::string const & i_path ) {
+  int l_fd = open( i_path.c_str(),
+                   O_RDONLY );
+  if( l_fd < 0 ) return;
+
+  struct stat l_stat;
+  if( fstat( l_fd, &l_stat ) != 0 || l_stat.st_size < (off_t) sizeof(Header) ) {
+    close( l_fd );
+    return;
+  }
+  std::size_t l_size = l_stat.st_size;
+
+  void * l_map = mmap( nullptr,
+                       l_size,
+                       PROT_READ,
+                       MAP_PRIVATE,
+                       l_fd,
+                       0 );
+  // the mapping stays valid after closing the descriptor
+  close( l_fd );
+  if( l_map == MAP_FAILED ) return;
+
+  // check the header
+  Header const * l_header = static_cast< Header const * >( l_map );
+  std::size_t l_sizeExpected = sizeof(Header);
+  for( unsigned short l_fi = 0; l_fi < 3; l_fi++ ) {
+    if( l_header->m_fieldMask & (1u << l_fi) ) {
+      l_sizeExpected += fieldSize( l_header->m_nx, l_header->m_ny );
+    }
+  }
+
+  if(    std::memcmp( l_header->m_magic, m_magic, sizeof(m_magic) ) != 0
+      || l_header->m_version != m_formatVersion
+      || l_header->m_realSize != sizeof(t_real)
+      || l_size < l_sizeExpected ) {
+    munmap( l_map, l_size );
+    return;
+  }
+
+  m_data = static_cast< char * >( l_map );
+  m_size = l_size;
+}
+
+tsunami_lab::io::Binary::~Binary() {
+  if( m_data != nullptr ) {
+    munmap( m_data, m_size );
+  }
+}
+
+tsunami_lab::t_real const * tsunami_lab::io::Binary::getField( std::uint32_t i_field ) const {
+  if( m_data == nullptr ) return nullptr;
+
+  Header const & l_header = getHeader();
+  if( (l_header.m_fieldMask & i_field) == 0 ) return nullptr;
+
+  // skip the header and all fields in front of the requested one
+  char const * l_field = m_data + sizeof(Header);
+  for( std::uint32_t l_fi = 1; l_fi < i_field; l_fi <<= 1 ) {
+    if( l_header.m_fieldMask & l_fi ) {
+      l_field += fieldSize( l_header.m_nx, l_header.m_ny );
+    }
+  }
+
+  return reinterpret_cast< t_real const * >( l_field );
+}
@@ -0,0 +1,189 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for writing and reading snapshots in a compact binary format.
+ *
+ * Layout of a file:
+ *   header (64 bytes, see Binary::Header),
+ *   water heights, momenta in x-direction, momenta in y-direction (only fields in the mask are present).
+ * Every field is stored as nx * ny contiguous values (x is stride-1) and starts at a 64-byte aligned offset.
+ **/
+#ifndef TSUNAMI_LAB_IO_BINARY
+#define TSUNAMI_LAB_IO_BINARY
+
+#include "../constants.h"
+#include <cstdint>
+#include <string>
+
+namespace tsunami_lab {
+  namespace io {
+    class Binary;
+  }
+}
+
+class tsunami_lab::io::Binary {
+  public:
+    //! mask bit of the water heights
+    static std::uint32_t constexpr m_maskHeight = 1;
+
+    //! mask bit of the momenta in x-direction
+    static std::uint32_t constexpr m_maskMomentumX = 2;
+
+    //! mask bit of the momenta in y-direction
+    static std::uint32_t constexpr m_maskMomentumY = 4;
+
+    //! alignment of the header and the field arrays in bytes
+    static std::size_t constexpr m_alignment = 64;
+
+    //! header at the beginning of every file
+    struct Header {
+      //! magic bytes identifying the format
+      char m_magic[8];
+
+      //! version of the format
+      std::uint32_t m_version;
+
+      //! size of a floating point value in bytes
+      std::uint32_t m_realSize;
+
+      //! number of cells in x-direction
+      std::uint64_t m_nx;
+
+      //! number of cells in y-direction
+      std::uint64_t m_ny;
+
+      //! cell width in x- and y-direction
+      double m_dxy;
+
+      //! simulation time of the snapshot
+      double m_time;
+
+      //! fields which are present in the file
+      std::uint32_t m_fieldMask;
+
+      //! padding to the alignment
+      char m_padding[12];
+    };
+
+  private:
+    //! magic bytes identifying the format
+    static char constexpr m_magic[8] = { 'T', 'S', 'U', 'N', 'A', 'M', 'I', 'B' };
+
+    //! version of the format
+    static std::uint32_t constexpr m_formatVersion = 1;
+
+    //! mapped file, nullptr if not open
+    char * m_data = nullptr;
+
+    //! size of the mapped file in bytes
+    std::size_t m_size = 0;
+
+    /**
+     * Gets the aligned size of a field in bytes.
+     *
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @return size of the field including padding.
+     **/
+    static std::size_t fieldSize( t_idx i_nx,
+                                  t_idx i_ny );
+
+    /**
+     * Gets a field of the mapped file.
+     *
+     * @param i_field mask bit of the field.
+     * @return pointer to the field's values, nullptr if not present.
+     **/
+    t_real const * getField( std::uint32_t i_field ) const;
+
+  public:
+    /**
+     * Writes a snapshot to the given file.
+     * The file is sized once and filled through a shared memory mapping.
+     *
+     * @param i_path path of the file.
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_stride stride of the data arrays in y-direction (x is assumed to be stride-1).
+     * @param i_time simulation time of the snapshot.
+     * @param i_h water height of the cells; optional: use nullptr if not required.
+     * @param i_hu momentum in x-direction of the cells; optional: use nullptr if not required.
+     * @param i_hv momentum in y-direction of the cells; optional: use nullptr if not required.
+     * @param i_nThreads number of threads which copy the fields; 0 uses the default number of OpenMP threads.
+     * @return true if successful, false otherwise.
+     **/
+    static bool write( std::string const & i_path,
+                       t_real              i_dxy,
+                       t_idx               i_nx,
+                       t_idx               i_ny,
+                       t_idx               i_stride,
+                       t_real              i_time,
+                       t_real      const * i_h,
+                       t_real      const * i_hu,
+                       t_real      const * i_hv,
+                       int                 i_nThreads = 0 );
+
+    /**
+     * Opens a snapshot for reading through a read-only memory mapping (zero-copy).
+     *
+     * @param i_path path of the file.
+     **/
+    Binary( std::string const & i_path );
+
+    /**
+     * Destructor which unmaps the file.
+     **/
+    ~Binary();
+
+    Binary( Binary const & ) = delete;
+    Binary & operator=( Binary const & ) = delete;
+
+    /**
+     * Checks whether the snapshot was opened and its header is valid.
+     *
+     * @return true if valid, false otherwise.
+     **/
+    bool isValid() const {
+      return m_data != nullptr;
+    }
+
+    /**
+     * Gets the header of the snapshot.
+     *
+     * @return header.
+     **/
+    Header const & getHeader() const {
+      return *reinterpret_cast< Header const * >( m_data );
+    }
+
+    /**
+     * Gets the cells' water heights.
+     *
+     * @return water heights, nullptr if not present.
+     **/
+    t_real const * getHeight() const {
+      return getField( m_maskHeight );
+    }
+
+    /**
+     * Gets the cells' momenta in x-direction.
+     *
+     * @return momenta in x-direction, nullptr if not present.
+     **/
+    t_real const * getMomentumX() const {
+      return getField( m_maskMomentumX );
+    }
+
+    /**
+     * Gets the cells' momenta in y-direction.
+     *
+     * @return momenta in y-direction, nullptr if not present.
+     **/
+    t_real const * getMomentumY() const {
+      return getField( m_maskMomentumY );
+    }
+};
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the binary snapshot interface.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <cstdint>
+#include <cstdio>
+#include "Binary.h"
+
+TEST_CASE( "Test the binary writer and reader for 2D settings.", "[Binary2d]" ) {
+  // define a simple example with a stride of 4 and a ghost cell layer
+  tsunami_lab::t_real l_h[16]  = {  0,  1,  2,  3,
+                                    4,  5,  6,  7,
+                                    8,  9, 10, 11,
+                                   12, 13, 14, 15 };
+  tsunami_lab::t_real l_hv[16] = {  0,  4,  8, 12,
+                                    1,  5,  9, 13,
+                                    2,  6, 10, 14,
+                                    3,  7, 11, 15 };
+
+  std::string l_path = "test_binary_2d.bin";
+
+  bool l_success = tsunami_lab::io::Binary::write( l_path,
+                                                   10,
+                                                   2,
+                                                   2,
+                                                   4,
+                                                   1.5,
+                                                   l_h+4+1,
+                                                   nullptr,
+                                                   l_hv+4+1 );
+  REQUIRE( l_success );
+
+  {
+    tsunami_lab::io::Binary l_snapshot( l_path );
+    REQUIRE( l_snapshot.isValid() );
+
+    tsunami_lab::io::Binary::Header const & l_header = l_snapshot.getHeader();
+    REQUIRE( l_header.m_nx == 2 );
+    REQUIRE( l_header.m_ny == 2 );
+    REQUIRE( l_header.m_dxy == 10 );
+    REQUIRE( l_header.m_time == 1.5 );
+    REQUIRE( l_header.m_fieldMask == (   tsunami_lab::io::Binary::m_maskHeight
+                                       | tsunami_lab::io::Binary::m_maskMomentumY ) );
+
+    REQUIRE( l_snapshot.getMomentumX() == nullptr );
+
+    // fields are aligned and stored without stride
+    tsunami_lab::t_real const * l_hRead  = l_snapshot.getHeight();
+    tsunami_lab::t_real const * l_hvRead = l_snapshot.getMomentumY();
+    REQUIRE( reinterpret_cast< std::uintptr_t >( l_hRead )  % tsunami_lab::io::Binary::m_alignment == 0 );
+    REQUIRE( reinterpret_cast< std::uintptr_t >( l_hvRead ) % tsunami_lab::io::Binary::m_alignment == 0 );
+
+    REQUIRE( l_hRead[0] ==  5 );
+    REQUIRE( l_hRead[1] ==  6 );
+    REQUIRE( l_hRead[2] ==  9 );
+    REQUIRE( l_hRead[3] == 10 );
+
+    REQUIRE( l_hvRead[0] ==  5 );
+    REQUIRE( l_hvRead[1] ==  9 );
+    REQUIRE( l_hvRead[2] ==  6 );
+    REQUIRE( l_hvRead[3] == 10 );
+  }
+
+  std::remove( l_path.c_str() );
+}
+
+TEST_CASE( "Test the binary reader with invalid files.", "[BinaryInvalid]" ) {
+  // missing file
+  tsunami_lab::io::Binary l_missing( "test_binary_missing.bin" );
+  REQUIRE( !l_missing.isValid() );
+  REQUIRE( l_missing.getHeight() == nullptr );
+
+  // file which is not a snapshot
+  std::string l_path = "test_binary_invalid.bin";
+  std::FILE * l_file = std::fopen( l_path.c_str(), "wb" );
+  REQUIRE( l_file != nullptr );
+  char l_data[128] = { 'x' };
+  std::fwrite( l_data, 1, sizeof(l_data), l_file );
+  std::fclose( l_file );
+
+  {
+    tsunami_lab::io::Binary l_invalid( l_path );
+    REQUIRE( !l_invalid.isValid() );
+  }
+
+  std::remove( l_path.c_str() );
+}
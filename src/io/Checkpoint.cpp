@@ -0,0 +1,119 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for checkpointing the state of a patch.
+ **/
+#include "Checkpoint.h"
+#include "Vectored.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+static_assert( sizeof(tsunami_lab::io::Checkpoint::Header) == 64,
+               "header has to have a size of 64 bytes" );
+
+template< typename T_real >
+bool tsunami_lab::io::Checkpoint::write( std::string const &         i_path,
+                                         t_idx                       i_nx,
+                                         t_idx                       i_ny,
+                                         t_idx                       i_nFields,
+                                         T_real      const * const * i_fields,
+                                         double                      i_time,
+                                         t_idx                       i_timeStep,
+                                         double                      i_speedMax ) {
+  // assemble header
+  Header l_header;
+  std::memset( &l_header, 0, sizeof(Header) );
+  std::memcpy( l_header.m_magic, m_magic, sizeof(m_magic) );
+  l_header.m_version = m_formatVersion;
+  l_header.m_realSize = sizeof(T_real);
+  l_header.m_nx = i_nx;
+  l_header.m_ny = i_ny;
+  l_header.m_nFields = i_nFields;
+  l_header.m_time = i_time;
+  l_header.m_timeStep = i_timeStep;
+  l_header.m_speedMax = i_speedMax;
+
+  // gather header and fields
+  std::vector< iovec > l_iov( i_nFields + 1 );
+  l_iov[0].iov_base = &l_header;
+  l_iov[0].iov_len = sizeof(Header);
+  for( t_idx l_fi = 0; l_fi < i_nFields; l_fi++ ) {
+    l_iov[l_fi+1].iov_base = const_cast< T_real * >( i_fields[l_fi] );
+    l_iov[l_fi+1].iov_len = i_nx * i_ny * sizeof(T_real);
+  }
+
+  std::string l_pathTmp = i_path + ".tmp";
+  int l_fd = open( l_pathTmp.c_str(),
+                   O_WRONLY | O_CREAT | O_TRUNC,
+                   0644 );
+  if( l_fd < 0 ) return false;
+
+  bool l_success = Vectored::transfer( l_fd, l_iov, true );
+  l_success = l_success && (fsync( l_fd ) == 0);
+  l_success = (close( l_fd ) == 0) && l_success;
+
+  // replace the previous checkpoint atomically
+  l_success = l_success && (std::rename( l_pathTmp.c_str(), i_path.c_str() ) == 0);
+  if( !l_success ) std::remove( l_pathTmp.c_str() );
+
+  return l_success;
+}
+
+template< typename T_real >
+bool tsunami_lab::io::Checkpoint::read( std::string const &   i_path,
+                                        t_idx                 i_nx,
+                                        t_idx                 i_ny,
+                                        t_idx                 i_nFields,
+                                        T_real      * const * o_fields,
+                                        T_real              & o_time,
+                                        t_idx               & o_timeStep,
+                                        T_real              & o_speedMax ) {
+  int l_fd = open( i_path.c_str(),
+                   O_RDONLY );
+  if( l_fd < 0 ) return false;
+
+  // read and validate the header before the fields are touched
+  Header l_header;
+  std::vector< iovec > l_iov( 1 );
+  l_iov[0].iov_base = &l_header;
+  l_iov[0].iov_len = sizeof(Header);
+
+  if(    !Vectored::transfer( l_fd, l_iov, false )
+      || std::memcmp( l_header.m_magic, m_magic, sizeof(m_magic) ) != 0
+      || l_header.m_version != m_formatVersion
+      || l_header.m_realSize != sizeof(T_real)
+      || l_header.m_nx != i_nx
+      || l_header.m_ny != i_ny
+      || l_header.m_nFields != i_nFields ) {
+    close( l_fd );
+    return false;
+  }
+
+  // scatter the fields
+  l_iov.resize( i_nFields );
+  for( t_idx l_fi = 0; l_fi < i_nFields; l_fi++ ) {
+    l_iov[l_fi].iov_base = o_fields[l_fi];
+    l_iov[l_fi].iov_len = i_nx * i_ny * sizeof(T_real);
+  }
+
+  bool l_success = Vectored::transfer( l_fd, l_iov, false );
+  close( l_fd );
+  if( !l_success ) return false;
+
+  o_time = l_header.m_time;
+  o_timeStep = l_header.m_timeStep;
+  o_speedMax = l_header.m_speedMax;
+
+  return true;
+}
+
+// explicit instantiations
+template bool tsunami_lab::io::Checkpoint::write( std::string const &, t_idx, t_idx, t_idx, float const * const *, double, t_idx, double );
+template bool tsunami_lab::io::Checkpoint::write( std::string const &, t_idx, t_idx, t_idx, double const * const *, double, t_idx, double );
+template bool tsunami_lab::io::Checkpoint::read( std::string const &, t_idx, t_idx, t_idx, float * const *, float &, t_idx &, float & );
+template bool tsunami_lab::io::Checkpoint::read( std::string const &, t_idx, t_idx, t_idx, double * const *, double &, t_idx &, double & );
@@ -0,0 +1,119 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for checkpointing the state of a patch.
+ *
+ * Layout of a file:
+ *   header (64 bytes, see Checkpoint::Header),
+ *   raw fields, each with nx * ny values including ghost cells.
+ **/
+#ifndef TSUNAMI_LAB_IO_CHECKPOINT
+#define TSUNAMI_LAB_IO_CHECKPOINT
+
+#include "../constants.h"
+#include <cstdint>
+#include <string>
+
+namespace tsunami_lab {
+  namespace io {
+    class Checkpoint;
+  }
+}
+
+class tsunami_lab::io::Checkpoint {
+  public:
+    //! header at the beginning of every file
+    struct Header {
+      //! magic bytes identifying the format
+      char m_magic[8];
+
+      //! version of the format
+      std::uint32_t m_version;
+
+      //! size of a floating point value in bytes
+      std::uint32_t m_realSize;
+
+      //! number of values in x-direction, including ghost cells
+      std::uint64_t m_nx;
+
+      //! number of values in y-direction, including ghost cells
+      std::uint64_t m_ny;
+
+      //! number of fields
+      std::uint64_t m_nFields;
+
+      //! simulation time
+      double m_time;
+
+      //! time step counter
+      std::uint64_t m_timeStep;
+
+      //! maximum wave speed of the last time step, from which the next time step is derived
+      double m_speedMax;
+    };
+
+  private:
+    //! magic bytes identifying the format
+    static char constexpr m_magic[8] = { 'T', 'S', 'U', 'N', 'A', 'M', 'I', 'C' };
+
+    //! version of the format
+    static std::uint32_t constexpr m_formatVersion = 2;
+
+  public:
+    /**
+     * Writes a checkpoint through a single gathering write.
+     * The data is written to a temporary file first, which then replaces the given file.
+     * Thus, an interrupted write never corrupts an existing checkpoint.
+     *
+     * @param i_path path of the checkpoint.
+     * @param i_nx number of values per field in x-direction, including ghost cells.
+     * @param i_ny number of values per field in y-direction, including ghost cells.
+     * @param i_nFields number of fields.
+     * @param i_fields fields, each holding i_nx * i_ny contiguous values.
+     * @param i_time simulation time.
+     * @param i_timeStep time step counter.
+     * @param i_speedMax maximum wave speed of the last time step.
+     * @return true if successful, false otherwise.
+     *
+     * @tparam T_real floating point type of the fields; instantiated for float and double.
+     **/
+    template< typename T_real >
+    static bool write( std::string const &         i_path,
+                       t_idx                       i_nx,
+                       t_idx                       i_ny,
+                       t_idx                       i_nFields,
+                       T_real      const * const * i_fields,
+                       double                      i_time,
+                       t_idx                       i_timeStep,
+                       double                      i_speedMax );
+
+    /**
+     * Reads a checkpoint's header and validates it.
+     * Afterwards, the fields are read through a single scattering read directly into the given fields.
+     * The dimensions stored in the checkpoint have to match the given ones.
+     *
+     * @param i_path path of the checkpoint.
+     * @param i_nx number of values per field in x-direction, including ghost cells.
+     * @param i_ny number of values per field in y-direction, including ghost cells.
+     * @param i_nFields number of fields.
+     * @param o_fields fields which are overwritten, each holding i_nx * i_ny contiguous values.
+     * @param o_time will be set to the simulation time.
+     * @param o_timeStep will be set to the time step counter.
+     * @param o_speedMax will be set to the maximum wave speed of the last time step.
+     * @return true if successful, false otherwise; the fields are untouched if the header is invalid and may be partially overwritten if reading the fields fails.
+     *
+     * @tparam T_real floating point type of the fields; has to match the one of the checkpoint.
+     **/
+    template< typename T_real >
+    static bool read( std::string const &   i_path,
+                      t_idx                 i_nx,
+                      t_idx                 i_ny,
+                      t_idx                 i_nFields,
+                      T_real      * const * o_fields,
+                      T_real              & o_time,
+                      t_idx               & o_timeStep,
+                      T_real              & o_speedMax );
+};
+
+#endif
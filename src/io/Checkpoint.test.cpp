@@ -0,0 +1,86 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the checkpoint interface.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <cstdio>
+#include "Checkpoint.h"
+
+TEST_CASE( "Test writing and reading checkpoints.", "[Checkpoint]" ) {
+  tsunami_lab::t_real l_h[6]  = { 1, 2, 3, 4, 5, 6 };
+  tsunami_lab::t_real l_hu[6] = { 6, 5, 4, 3, 2, 1 };
+  tsunami_lab::t_real const * l_fields[2] = { l_h, l_hu };
+
+  std::string l_path = "test_checkpoint.chk";
+
+  REQUIRE( tsunami_lab::io::Checkpoint::write( l_path,
+                                               3,
+                                               2,
+                                               2,
+                                               l_fields,
+                                               0.75,
+                                               42,
+                                               12.5 ) );
+
+  // restore
+  tsunami_lab::t_real l_hRead[6]  = { 0 };
+  tsunami_lab::t_real l_huRead[6] = { 0 };
+  tsunami_lab::t_real * l_fieldsRead[2] = { l_hRead, l_huRead };
+  tsunami_lab::t_real l_time = 0;
+  tsunami_lab::t_idx l_timeStep = 0;
+  tsunami_lab::t_real l_speedMax = 0;
+
+  REQUIRE( tsunami_lab::io::Checkpoint::read( l_path,
+                                              3,
+                                              2,
+                                              2,
+                                              l_fieldsRead,
+                                              l_time,
+                                              l_timeStep,
+                                              l_speedMax ) );
+
+  REQUIRE( l_time == 0.75f );
+  REQUIRE( l_timeStep == 42 );
+  REQUIRE( l_speedMax == 12.5f );
+  for( unsigned short l_id = 0; l_id < 6; l_id++ ) {
+    REQUIRE( l_hRead[l_id]  == l_h[l_id] );
+    REQUIRE( l_huRead[l_id] == l_hu[l_id] );
+  }
+
+  // mismatching dimensions; the fields are untouched since the header is validated first
+  l_hRead[0] = -1;
+  REQUIRE( !tsunami_lab::io::Checkpoint::read( l_path,
+                                               2,
+                                               3,
+                                               2,
+                                               l_fieldsRead,
+                                               l_time,
+                                               l_timeStep,
+                                               l_speedMax ) );
+  REQUIRE( l_hRead[0] == -1 );
+
+  // mismatching number of fields
+  REQUIRE( !tsunami_lab::io::Checkpoint::read( l_path,
+                                               3,
+                                               2,
+                                               1,
+                                               l_fieldsRead,
+                                               l_time,
+                                               l_timeStep,
+                                               l_speedMax ) );
+
+  // missing file
+  REQUIRE( !tsunami_lab::io::Checkpoint::read( "test_checkpoint_missing.chk",
+                                               3,
+                                               2,
+                                               2,
+                                               l_fieldsRead,
+                                               l_time,
+                                               l_timeStep,
+                                               l_speedMax ) );
+
+  std::remove( l_path.c_str() );
+}
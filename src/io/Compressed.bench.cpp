@@ -0,0 +1,105 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the compressed snapshot output.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "../patches/WavePropagation1d.h"
+#include "Binary.h"
+#include "Compressed.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+  /**
+   * Writes and reads snapshots of 2^22 cells in the compressed and in the binary format.
+   * The snapshots replicate a dam break in 2^14 cells after 12000 time steps,
+   * whose shock and rarefaction cover most of the domain; the chunks do not exploit the replication.
+   * Reports the compression ratio w.r.t. the binary format and the throughput w.r.t. the uncompressed bytes.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    tsunami_lab::t_idx l_nCellsDamBreak = tsunami_lab::t_idx(1) << 14;
+    tsunami_lab::t_idx l_nCells = tsunami_lab::t_idx(1) << 22;
+
+    tsunami_lab::patches::WavePropagation1d<> l_waveProp( l_nCellsDamBreak );
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCellsDamBreak; l_ce++ ) {
+      l_waveProp.setHeight( l_ce,
+                            0,
+                            (l_ce < l_nCellsDamBreak / 2) ? 10 : 5 );
+    }
+    for( unsigned short l_st = 0; l_st < 12000; l_st++ ) {
+      l_waveProp.setGhostOutflow();
+      l_waveProp.timeStep( 0.05f );
+    }
+
+    std::vector< tsunami_lab::t_real > l_h( l_nCells );
+    std::vector< tsunami_lab::t_real > l_hu( l_nCells );
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+      l_h[l_ce] = l_waveProp.getHeight()[ l_ce % l_nCellsDamBreak ];
+      l_hu[l_ce] = l_waveProp.getMomentumX()[ l_ce % l_nCellsDamBreak ];
+    }
+
+    double l_nBytes = 2.0 * l_nCells * sizeof(tsunami_lab::t_real);
+    std::string l_pathCompressed = "bench_compressed.tsz";
+    std::string l_pathBinary = "bench_compressed.binary";
+
+    double l_seconds = io_benchmark.measure( [&]() {
+      tsunami_lab::io::Compressed::write( l_pathCompressed,
+                                          0.01,
+                                          l_nCells,
+                                          1,
+                                          l_nCells,
+                                          0,
+                                          l_h.data(),
+                                          l_hu.data(),
+                                          nullptr );
+    } );
+    io_benchmark.report( "Compressed::write",
+                         "bytes/s",
+                         l_nBytes / l_seconds );
+
+    l_seconds = io_benchmark.measure( [&]() {
+      tsunami_lab::io::Binary::write( l_pathBinary,
+                                      0.01,
+                                      l_nCells,
+                                      1,
+                                      l_nCells,
+                                      0,
+                                      l_h.data(),
+                                      l_hu.data(),
+                                      nullptr );
+    } );
+    io_benchmark.report( "Binary::write",
+                         "bytes/s",
+                         l_nBytes / l_seconds );
+
+    {
+      tsunami_lab::io::Compressed l_snapshot( l_pathCompressed );
+      std::vector< tsunami_lab::t_real > l_values( l_nCells );
+
+      l_seconds = io_benchmark.measure( [&]() {
+        l_snapshot.read( tsunami_lab::io::Compressed::m_maskHeight,
+                         l_values.data() );
+        l_snapshot.read( tsunami_lab::io::Compressed::m_maskMomentumX,
+                         l_values.data() );
+      } );
+      io_benchmark.report( "Compressed::read",
+                           "bytes/s",
+                           l_nBytes / l_seconds );
+
+      io_benchmark.report( "Compressed/ratio",
+                           "x",
+                           ( sizeof(tsunami_lab::io::Binary::Header) + l_nBytes ) / l_snapshot.getSize() );
+    }
+
+    std::remove( l_pathCompressed.c_str() );
+    std::remove( l_pathBinary.c_str() );
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "Compressed",
+                                                                         run );
+}
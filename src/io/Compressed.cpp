@@ -0,0 +1,404 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for writing and reading snapshots in a lossless compressed format.
+ **/
+#include "Compressed.h"
+#include "Rans.h"
+#include "Vectored.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static_assert( sizeof(tsunami_lab::io::Compressed::Header) == 64,
+               "header has to have a size of 64 bytes" );
+
+namespace {
+  //! unsigned integer holding the bits of a floating point value
+  typedef std::conditional< sizeof(tsunami_lab::t_real) == 4,
+                            std::uint32_t,
+                            std::uint64_t >::type t_bits;
+
+  static_assert( sizeof(t_bits) == sizeof(tsunami_lab::t_real),
+                 "floating point values have to have 4 or 8 bytes" );
+
+  //! number of byte planes
+  unsigned short constexpr g_nPlanes = sizeof(t_bits);
+
+  //! sign bit
+  t_bits constexpr g_sign = t_bits(1) << (8 * sizeof(t_bits) - 1);
+
+  /**
+   * Maps the bits of a floating point value to an unsigned integer whose order matches the one of the values.
+   *
+   * @param i_bits bits of the floating point value.
+   * @return ordered integer.
+   **/
+  t_bits toOrdered( t_bits i_bits ) {
+    return (i_bits & g_sign) ? ~i_bits : (i_bits | g_sign);
+  }
+
+  /**
+   * Inverse of toOrdered.
+   *
+   * @param i_ordered ordered integer.
+   * @return bits of the floating point value.
+   **/
+  t_bits fromOrdered( t_bits i_ordered ) {
+    return (i_ordered & g_sign) ? (i_ordered ^ g_sign) : ~i_ordered;
+  }
+
+  /**
+   * Estimates the size of the byte planes of residuals after order-0 entropy coding.
+   *
+   * @param i_nValues number of residuals.
+   * @param i_residuals residuals.
+   * @return estimated size in bits.
+   **/
+  double estimateBits( tsunami_lab::t_idx         i_nValues,
+                       t_bits             const * i_residuals ) {
+    std::vector< tsunami_lab::t_idx > l_counts( g_nPlanes * 256, 0 );
+    for( tsunami_lab::t_idx l_va = 0; l_va < i_nValues; l_va++ ) {
+      for( unsigned short l_pl = 0; l_pl < g_nPlanes; l_pl++ ) {
+        l_counts[ l_pl * 256 + ( (i_residuals[l_va] >> (8*l_pl)) & 0xff ) ]++;
+      }
+    }
+
+    double l_bits = g_nPlanes * i_nValues * std::log2( double(i_nValues) );
+    for( tsunami_lab::t_idx l_co : l_counts ) {
+      if( l_co > 0 ) l_bits -= l_co * std::log2( double(l_co) );
+    }
+    return l_bits;
+  }
+}
+
+void tsunami_lab::io::Compressed::encodeChunk( t_idx                         i_nValues,
+                                               t_real                const * i_values,
+                                               std::vector< std::uint8_t > & o_chunk ) {
+  // residuals of both predictors; the first value is predicted by zero
+  std::vector< t_bits > l_residuals[2];
+  l_residuals[0].resize( i_nValues );
+  l_residuals[1].resize( i_nValues );
+
+  t_bits l_prevBits = 0;
+  t_bits l_prevOrdered = toOrdered( 0 );
+  for( t_idx l_va = 0; l_va < i_nValues; l_va++ ) {
+    t_bits l_bits = 0;
+    std::memcpy( &l_bits, i_values + l_va, sizeof(t_bits) );
+    l_residuals[0][l_va] = l_bits ^ l_prevBits;
+
+    // zigzag encoding of the difference moves the sign to the lowest bit
+    t_bits l_ordered = toOrdered( l_bits );
+    t_bits l_diff = l_ordered - l_prevOrdered;
+    l_residuals[1][l_va] = (l_diff << 1) ^ ( t_bits(0) - (l_diff >> (8 * sizeof(t_bits) - 1)) );
+
+    l_prevBits = l_bits;
+    l_prevOrdered = l_ordered;
+  }
+
+  unsigned short l_pr = estimateBits( i_nValues, l_residuals[0].data() ) <= estimateBits( i_nValues, l_residuals[1].data() ) ? 0 : 1;
+
+  // byte shuffle and entropy coding of the planes
+  o_chunk.clear();
+  o_chunk.push_back( (l_pr == 0) ? m_methodXor : m_methodDelta );
+
+  std::vector< std::uint8_t > l_plane( i_nValues );
+  for( unsigned short l_pl = 0; l_pl < g_nPlanes; l_pl++ ) {
+    for( t_idx l_va = 0; l_va < i_nValues; l_va++ ) {
+      l_plane[l_va] = (l_residuals[l_pr][l_va] >> (8*l_pl)) & 0xff;
+    }
+    Rans::encode( i_nValues,
+                  l_plane.data(),
+                  o_chunk );
+  }
+
+  // fall back to the raw values if the chunk does not compress
+  if( o_chunk.size() >= 1 + i_nValues * sizeof(t_real) ) {
+    o_chunk.resize( 1 + i_nValues * sizeof(t_real) );
+    o_chunk[0] = m_methodRaw;
+    std::memcpy( o_chunk.data() + 1,
+                 i_values,
+                 i_nValues * sizeof(t_real) );
+  }
+}
+
+bool tsunami_lab::io::Compressed::decodeChunk( std::uint8_t const * i_chunk,
+                                               std::size_t          i_size,
+                                               t_idx                i_nValues,
+                                               t_real             * o_values ) {
+  if( i_size < 1 ) return false;
+  std::uint8_t l_method = i_chunk[0];
+
+  if( l_method == m_methodRaw ) {
+    if( i_size != 1 + i_nValues * sizeof(t_real) ) return false;
+    std::memcpy( o_values,
+                 i_chunk + 1,
+                 i_nValues * sizeof(t_real) );
+    return true;
+  }
+  if( l_method != m_methodXor && l_method != m_methodDelta ) return false;
+
+  // entropy decoding and byte unshuffle of the planes
+  std::vector< t_bits > l_residuals( i_nValues, 0 );
+  std::vector< std::uint8_t > l_plane( i_nValues );
+  std::size_t l_pos = 1;
+  for( unsigned short l_pl = 0; l_pl < g_nPlanes; l_pl++ ) {
+    std::size_t l_size = 0;
+    if( !Rans::decode( i_chunk + l_pos,
+                       i_size - l_pos,
+                       i_nValues,
+                       l_plane.data(),
+                       l_size ) ) return false;
+    l_pos += l_size;
+
+    for( t_idx l_va = 0; l_va < i_nValues; l_va++ ) {
+      l_residuals[l_va] |= t_bits( l_plane[l_va] ) << (8*l_pl);
+    }
+  }
+  if( l_pos != i_size ) return false;
+
+  // inverse prediction
+  t_bits l_prevBits = 0;
+  t_bits l_prevOrdered = toOrdered( 0 );
+  for( t_idx l_va = 0; l_va < i_nValues; l_va++ ) {
+    t_bits l_bits = 0;
+    if( l_method == m_methodXor ) {
+      l_bits = l_residuals[l_va] ^ l_prevBits;
+    }
+    else {
+      t_bits l_diff = (l_residuals[l_va] >> 1) ^ ( t_bits(0) - (l_residuals[l_va] & 1) );
+      l_prevOrdered += l_diff;
+      l_bits = fromOrdered( l_prevOrdered );
+    }
+    l_prevBits = l_bits;
+    std::memcpy( o_values + l_va, &l_bits, sizeof(t_bits) );
+  }
+
+  return true;
+}
+
+bool tsunami_lab::io::Compressed::write( std::string const & i_path,
+                                         t_real              i_dxy,
+                                         t_idx               i_nx,
+                                         t_idx               i_ny,
+                                         t_idx               i_stride,
+                                         t_real              i_time,
+                                         t_real      const * i_h,
+                                         t_real      const * i_hu,
+                                         t_real      const * i_hv,
+                                         int                 i_nThreads ) {
+  // compressing threads, by default as many as in OpenMP's parallel regions
+  int l_nThreads = 1;
+#ifdef _OPENMP
+  l_nThreads = (i_nThreads > 0) ? i_nThreads : omp_get_max_threads();
+#endif
+
+  t_real const * l_fields[3] = { i_h, i_hu, i_hv };
+
+  // assemble header
+  Header l_header;
+  std::memset( &l_header, 0, sizeof(Header) );
+  std::memcpy( l_header.m_magic, m_magic, sizeof(m_magic) );
+  l_header.m_version = m_formatVersion;
+  l_header.m_realSize = sizeof(t_real);
+  l_header.m_nx = i_nx;
+  l_header.m_ny = i_ny;
+  l_header.m_dxy = i_dxy;
+  l_header.m_time = i_time;
+  l_header.m_chunkSize = m_chunkSize;
+
+  std::vector< t_real const * > l_present;
+  for( unsigned short l_fi = 0; l_fi < 3; l_fi++ ) {
+    if( l_fields[l_fi] != nullptr ) {
+      l_header.m_fieldMask |= 1u << l_fi;
+      l_present.push_back( l_fields[l_fi] );
+    }
+  }
+
+  // compress the chunks of all fields in parallel
+  t_idx l_nValues = i_nx * i_ny;
+  t_idx l_nChunks = getNumChunks( l_nValues );
+  std::vector< std::vector< std::uint8_t > > l_chunks( l_present.size() * l_nChunks );
+
+#pragma omp parallel num_threads( l_nThreads )
+  {
+    std::vector< t_real > l_values( m_chunkSize );
+
+#pragma omp for schedule(dynamic)
+    for( t_idx l_ch = 0; l_ch < l_chunks.size(); l_ch++ ) {
+      t_real const * l_field = l_present[ l_ch / l_nChunks ];
+      t_idx l_first = (l_ch % l_nChunks) * m_chunkSize;
+      t_idx l_nValuesChunk = std::min( m_chunkSize, l_nValues - l_first );
+
+      // gather the chunk's values, removing the stride of the data arrays
+      for( t_idx l_va = l_first; l_va < l_first + l_nValuesChunk; ) {
+        t_idx l_ix = l_va % i_nx;
+        t_idx l_iy = l_va / i_nx;
+        t_idx l_count = std::min( i_nx - l_ix, l_first + l_nValuesChunk - l_va );
+        std::memcpy( l_values.data() + (l_va - l_first),
+                     l_field + l_iy * i_stride + l_ix,
+                     l_count * sizeof(t_real) );
+        l_va += l_count;
+      }
+
+      encodeChunk( l_nValuesChunk,
+                   l_values.data(),
+                   l_chunks[l_ch] );
+    }
+  }
+
+  // chunk table
+  std::vector< std::uint64_t > l_offsets( l_chunks.size() + 1 );
+  l_offsets[0] = sizeof(Header) + l_offsets.size() * sizeof(std::uint64_t);
+  for( t_idx l_ch = 0; l_ch < l_chunks.size(); l_ch++ ) {
+    l_offsets[l_ch+1] = l_offsets[l_ch] + l_chunks[l_ch].size();
+  }
+
+  // gather header, table and chunks
+  std::vector< iovec > l_iov;
+  l_iov.push_back( { &l_header, sizeof(Header) } );
+  l_iov.push_back( { l_offsets.data(), l_offsets.size() * sizeof(std::uint64_t) } );
+  for( std::vector< std::uint8_t > & l_chunk : l_chunks ) {
+    l_iov.push_back( { l_chunk.data(), l_chunk.size() } );
+  }
+
+  int l_fd = open( i_path.c_str(),
+                   O_WRONLY | O_CREAT | O_TRUNC,
+                   0644 );
+  if( l_fd < 0 ) return false;
+
+  bool l_success = Vectored::transfer( l_fd, l_iov, true );
+  l_success = (close( l_fd ) == 0) && l_success;
+
+  return l_success;
+}
+
+tsunami_lab::io::Compressed::Compressed( std::string const & i_path ) {
+  int l_fd = open( i_path.c_str(),
+                   O_RDONLY );
+  if( l_fd < 0 ) return;
+
+  struct stat l_stat;
+  if( fstat( l_fd, &l_stat ) != 0 || l_stat.st_size < (off_t) sizeof(Header) ) {
+    close( l_fd );
+    return;
+  }
+  std::size_t l_size = l_stat.st_size;
+
+  void * l_map = mmap( nullptr,
+                       l_size,
+                       PROT_READ,
+                       MAP_PRIVATE,
+                       l_fd,
+                       0 );
+  // the mapping stays valid after closing the descriptor
+  close( l_fd );
+  if( l_map == MAP_FAILED ) return;
+
+  // check the header
+  char const * l_data = static_cast< char const * >( l_map );
+  Header const * l_header = static_cast< Header const * >( l_map );
+  bool l_valid =    std::memcmp( l_header->m_magic, m_magic, sizeof(m_magic) ) == 0
+                 && l_header->m_version == m_formatVersion
+                 && l_header->m_realSize == sizeof(t_real)
+                 && l_header->m_chunkSize == m_chunkSize
+                 && (l_header->m_fieldMask & ~7u) == 0
+                 && l_header->m_nx > 0
+                 && l_header->m_ny > 0
+                 && l_header->m_ny <= l_size * m_chunkSize / l_header->m_nx;
+
+  // check the chunk table: the chunks are contiguous and end with the file
+  if( l_valid ) {
+    std::size_t l_nFields = 0;
+    for( unsigned short l_fi = 0; l_fi < 3; l_fi++ ) {
+      if( l_header->m_fieldMask & (1u << l_fi) ) l_nFields++;
+    }
+    std::size_t l_nOffsets = l_nFields * getNumChunks( l_header->m_nx * l_header->m_ny ) + 1;
+
+    l_valid = l_nOffsets <= (l_size - sizeof(Header)) / sizeof(std::uint64_t);
+    for( std::size_t l_of = 0; l_valid && l_of < l_nOffsets; l_of++ ) {
+      std::uint64_t l_offset = 0;
+      std::memcpy( &l_offset, l_data + sizeof(Header) + l_of * sizeof(std::uint64_t), sizeof(std::uint64_t) );
+
+      std::uint64_t l_lower = sizeof(Header) + l_nOffsets * sizeof(std::uint64_t);
+      if( l_of > 0 ) {
+        std::memcpy( &l_lower, l_data + sizeof(Header) + (l_of-1) * sizeof(std::uint64_t), sizeof(std::uint64_t) );
+        l_lower++;
+      }
+      l_valid = l_offset >= l_lower && l_offset <= l_size;
+      if( l_of == 0 ) l_valid = l_valid && l_offset == l_lower;
+      if( l_of == l_nOffsets-1 ) l_valid = l_valid && l_offset == l_size;
+    }
+  }
+
+  if( !l_valid ) {
+    munmap( l_map, l_size );
+    return;
+  }
+
+  m_data = static_cast< char * >( l_map );
+  m_size = l_size;
+}
+
+tsunami_lab::io::Compressed::~Compressed() {
+  if( m_data != nullptr ) {
+    munmap( m_data, m_size );
+  }
+}
+
+bool tsunami_lab::io::Compressed::readChunk( std::uint32_t   i_field,
+                                             t_idx           i_chunk,
+                                             t_real        * o_values ) const {
+  if( m_data == nullptr ) return false;
+
+  Header const & l_header = getHeader();
+  if(    ( i_field != m_maskHeight && i_field != m_maskMomentumX && i_field != m_maskMomentumY )
+      || (l_header.m_fieldMask & i_field) == 0
+      || i_chunk >= getNumChunks() ) return false;
+
+  // skip the chunks of all fields in front of the requested one
+  t_idx l_id = i_chunk;
+  for( std::uint32_t l_fi = 1; l_fi < i_field; l_fi <<= 1 ) {
+    if( l_header.m_fieldMask & l_fi ) {
+      l_id += getNumChunks();
+    }
+  }
+
+  std::uint64_t l_offsets[2] = { 0, 0 };
+  std::memcpy( l_offsets,
+               m_data + sizeof(Header) + l_id * sizeof(std::uint64_t),
+               2 * sizeof(std::uint64_t) );
+
+  t_idx l_first = i_chunk * m_chunkSize;
+  t_idx l_nValues = std::min( m_chunkSize, t_idx( l_header.m_nx * l_header.m_ny ) - l_first );
+
+  return decodeChunk( reinterpret_cast< std::uint8_t const * >( m_data + l_offsets[0] ),
+                      l_offsets[1] - l_offsets[0],
+                      l_nValues,
+                      o_values );
+}
+
+bool tsunami_lab::io::Compressed::read( std::uint32_t   i_field,
+                                        t_real        * o_values ) const {
+  if( m_data == nullptr ) return false;
+
+  bool l_success = true;
+#pragma omp parallel for schedule(dynamic) reduction(&&:l_success)
+  for( t_idx l_ch = 0; l_ch < getNumChunks(); l_ch++ ) {
+    l_success = readChunk( i_field,
+                           l_ch,
+                           o_values + l_ch * m_chunkSize ) && l_success;
+  }
+
+  return l_success;
+}
@@ -0,0 +1,250 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for writing and reading snapshots in a lossless compressed format.
+ *
+ * Layout of a file:
+ *   header (64 bytes, see Compressed::Header),
+ *   chunk table: offsets of all chunks in the file and the file's size (8 bytes each),
+ *   chunks of the water heights, momenta in x-direction, momenta in y-direction (only fields in the mask are present).
+ * Every field is split into chunks of m_chunkSize values w.r.t. the stride-free order (x is stride-1).
+ *
+ * Layout of a chunk:
+ *   method (1 byte): raw, XOR prediction or delta prediction,
+ *   raw: the chunk's values,
+ *   otherwise: one rANS stream (see Rans) per byte plane of the predicted residuals, least significant plane first.
+ **/
+#ifndef TSUNAMI_LAB_IO_COMPRESSED
+#define TSUNAMI_LAB_IO_COMPRESSED
+
+#include "../constants.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace io {
+    class Compressed;
+  }
+}
+
+/**
+ * Lossless compression of snapshots, tailored to smooth fields.
+ *
+ * Every value is predicted from its predecessor in memory order, either by the XOR of the bit patterns
+ * or by the difference of the bit patterns mapped to the order of the floating point values.
+ * For smooth fields, the residuals are small, i.e., their high bytes are mostly zero.
+ * The residuals are shuffled into byte planes, each of which is entropy coded on its own.
+ * The predictor is chosen per chunk through the estimated entropy; chunks which do not compress are stored raw.
+ *
+ * The chunks are compressed in parallel and decompressed independently of each other.
+ **/
+class tsunami_lab::io::Compressed {
+  public:
+    //! mask bit of the water heights
+    static std::uint32_t constexpr m_maskHeight = 1;
+
+    //! mask bit of the momenta in x-direction
+    static std::uint32_t constexpr m_maskMomentumX = 2;
+
+    //! mask bit of the momenta in y-direction
+    static std::uint32_t constexpr m_maskMomentumY = 4;
+
+    //! number of values per chunk
+    static t_idx constexpr m_chunkSize = 1 << 16;
+
+    //! header at the beginning of every file
+    struct Header {
+      //! magic bytes identifying the format
+      char m_magic[8];
+
+      //! version of the format
+      std::uint32_t m_version;
+
+      //! size of a floating point value in bytes
+      std::uint32_t m_realSize;
+
+      //! number of cells in x-direction
+      std::uint64_t m_nx;
+
+      //! number of cells in y-direction
+      std::uint64_t m_ny;
+
+      //! cell width in x- and y-direction
+      double m_dxy;
+
+      //! simulation time of the snapshot
+      double m_time;
+
+      //! fields which are present in the file
+      std::uint32_t m_fieldMask;
+
+      //! number of values per chunk
+      std::uint32_t m_chunkSize;
+
+      //! padding to 64 bytes
+      char m_padding[8];
+    };
+
+  private:
+    //! magic bytes identifying the format
+    static char constexpr m_magic[8] = { 'T', 'S', 'U', 'N', 'A', 'M', 'I', 'Z' };
+
+    //! version of the format
+    static std::uint32_t constexpr m_formatVersion = 1;
+
+    //! method of chunks which are stored raw
+    static std::uint8_t constexpr m_methodRaw = 0;
+
+    //! method of chunks which are XOR-predicted
+    static std::uint8_t constexpr m_methodXor = 1;
+
+    //! method of chunks which are delta-predicted
+    static std::uint8_t constexpr m_methodDelta = 2;
+
+    //! mapped file, nullptr if not open
+    char * m_data = nullptr;
+
+    //! size of the mapped file in bytes
+    std::size_t m_size = 0;
+
+    /**
+     * Gets the number of chunks of a field.
+     *
+     * @param i_nValues number of values of the field.
+     * @return number of chunks.
+     **/
+    static t_idx getNumChunks( t_idx i_nValues ) {
+      return (i_nValues + m_chunkSize - 1) / m_chunkSize;
+    }
+
+    /**
+     * Compresses a chunk.
+     *
+     * @param i_nValues number of values.
+     * @param i_values values of the chunk.
+     * @param o_chunk will be set to the compressed chunk.
+     **/
+    static void encodeChunk( t_idx                         i_nValues,
+                             t_real                const * i_values,
+                             std::vector< std::uint8_t > & o_chunk );
+
+    /**
+     * Decompresses a chunk.
+     *
+     * @param i_chunk compressed chunk.
+     * @param i_size size of the compressed chunk in bytes.
+     * @param i_nValues number of values.
+     * @param o_values will be set to the values of the chunk.
+     * @return true if successful, false otherwise.
+     **/
+    static bool decodeChunk( std::uint8_t const * i_chunk,
+                             std::size_t          i_size,
+                             t_idx                i_nValues,
+                             t_real             * o_values );
+
+  public:
+    /**
+     * Writes a snapshot to the given file.
+     * The chunks are compressed in parallel and written with a single gathering write.
+     *
+     * @param i_path path of the file.
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_stride stride of the data arrays in y-direction (x is assumed to be stride-1).
+     * @param i_time simulation time of the snapshot.
+     * @param i_h water height of the cells; optional: use nullptr if not required.
+     * @param i_hu momentum in x-direction of the cells; optional: use nullptr if not required.
+     * @param i_hv momentum in y-direction of the cells; optional: use nullptr if not required.
+     * @param i_nThreads number of threads which compress the chunks; 0 uses the default number of OpenMP threads.
+     * @return true if successful, false otherwise.
+     **/
+    static bool write( std::string const & i_path,
+                       t_real              i_dxy,
+                       t_idx               i_nx,
+                       t_idx               i_ny,
+                       t_idx               i_stride,
+                       t_real              i_time,
+                       t_real      const * i_h,
+                       t_real      const * i_hu,
+                       t_real      const * i_hv,
+                       int                 i_nThreads = 0 );
+
+    /**
+     * Opens a snapshot for reading through a read-only memory mapping.
+     * The header and the chunk table are validated, the chunks on decompression.
+     *
+     * @param i_path path of the file.
+     **/
+    Compressed( std::string const & i_path );
+
+    /**
+     * Destructor which unmaps the file.
+     **/
+    ~Compressed();
+
+    Compressed( Compressed const & ) = delete;
+    Compressed & operator=( Compressed const & ) = delete;
+
+    /**
+     * Checks whether the snapshot was opened and its header and chunk table are valid.
+     *
+     * @return true if valid, false otherwise.
+     **/
+    bool isValid() const {
+      return m_data != nullptr;
+    }
+
+    /**
+     * Gets the header of the snapshot.
+     *
+     * @return header.
+     **/
+    Header const & getHeader() const {
+      return *reinterpret_cast< Header const * >( m_data );
+    }
+
+    /**
+     * Gets the number of chunks per field.
+     *
+     * @return number of chunks.
+     **/
+    t_idx getNumChunks() const {
+      return getNumChunks( getHeader().m_nx * getHeader().m_ny );
+    }
+
+    /**
+     * Gets the size of the snapshot's file.
+     *
+     * @return size in bytes.
+     **/
+    std::size_t getSize() const {
+      return m_size;
+    }
+
+    /**
+     * Decompresses a single chunk of a field.
+     *
+     * @param i_field mask bit of the field.
+     * @param i_chunk id of the chunk.
+     * @param o_values will be set to the chunk's values: m_chunkSize values, fewer for the last chunk.
+     * @return true if successful, false if the field or chunk is not present or corrupted.
+     **/
+    bool readChunk( std::uint32_t   i_field,
+                    t_idx           i_chunk,
+                    t_real        * o_values ) const;
+
+    /**
+     * Decompresses a field; the chunks are decompressed in parallel.
+     *
+     * @param i_field mask bit of the field.
+     * @param o_values will be set to the field's nx * ny values (x is stride-1).
+     * @return true if successful, false if the field is not present or corrupted.
+     **/
+    bool read( std::uint32_t   i_field,
+               t_real        * o_values ) const;
+};
+
+#endif
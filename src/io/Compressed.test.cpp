@@ -0,0 +1,188 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the compressed snapshot interface.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+#include "Compressed.h"
+
+TEST_CASE( "Test the compressed writer and reader for 2D settings.", "[Compressed2d]" ) {
+  typedef tsunami_lab::io::Compressed t_compressed;
+
+  // 300 x 400 cells in arrays with a stride of 310 result in two chunks per field, the second being incomplete
+  tsunami_lab::t_idx l_nx = 300;
+  tsunami_lab::t_idx l_ny = 400;
+  tsunami_lab::t_idx l_stride = 310;
+
+  std::vector< tsunami_lab::t_real > l_h( l_stride * l_ny );
+  std::vector< tsunami_lab::t_real > l_hv( l_stride * l_ny );
+  std::mt19937 l_gen( 42 );
+  std::uniform_real_distribution< tsunami_lab::t_real > l_dist( -1, 1 );
+
+  for( tsunami_lab::t_idx l_iy = 0; l_iy < l_ny; l_iy++ ) {
+    for( tsunami_lab::t_idx l_ix = 0; l_ix < l_stride; l_ix++ ) {
+      // smooth heights with a dam and random momenta
+      l_h[l_iy * l_stride + l_ix] = 10 + std::sin( tsunami_lab::t_real(0.01) * l_ix ) + ( (l_ix < 150) ? 5 : 0 );
+      l_hv[l_iy * l_stride + l_ix] = l_dist( l_gen );
+    }
+  }
+
+  // special values survive
+  l_h[0] = -0.0f;
+  l_h[1] = -3;
+  l_h[2] = std::numeric_limits< tsunami_lab::t_real >::infinity();
+  l_h[3] = std::numeric_limits< tsunami_lab::t_real >::quiet_NaN();
+  l_h[4] = std::numeric_limits< tsunami_lab::t_real >::denorm_min();
+
+  std::string l_path = "test_compressed_2d.tsz";
+  REQUIRE( t_compressed::write( l_path,
+                                10,
+                                l_nx,
+                                l_ny,
+                                l_stride,
+                                1.5,
+                                l_h.data(),
+                                nullptr,
+                                l_hv.data() ) );
+
+  {
+    t_compressed l_snapshot( l_path );
+    REQUIRE( l_snapshot.isValid() );
+
+    t_compressed::Header const & l_header = l_snapshot.getHeader();
+    REQUIRE( l_header.m_nx == 300 );
+    REQUIRE( l_header.m_ny == 400 );
+    REQUIRE( l_header.m_dxy == 10 );
+    REQUIRE( l_header.m_time == 1.5 );
+    REQUIRE( l_header.m_fieldMask == ( t_compressed::m_maskHeight | t_compressed::m_maskMomentumY ) );
+    REQUIRE( l_snapshot.getNumChunks() == 2 );
+
+    // the random momenta are stored raw, the heights compress
+    REQUIRE( l_snapshot.getSize() < 64 + 5 * 8 + 2 + l_nx * l_ny * sizeof(tsunami_lab::t_real) * 3 / 2 );
+
+    std::vector< tsunami_lab::t_real > l_values( l_nx * l_ny );
+    REQUIRE( !l_snapshot.read( t_compressed::m_maskMomentumX, l_values.data() ) );
+
+    REQUIRE( l_snapshot.read( t_compressed::m_maskHeight, l_values.data() ) );
+    for( tsunami_lab::t_idx l_iy = 0; l_iy < l_ny; l_iy++ ) {
+      REQUIRE( std::memcmp( l_values.data() + l_iy * l_nx,
+                            l_h.data() + l_iy * l_stride,
+                            l_nx * sizeof(tsunami_lab::t_real) ) == 0 );
+    }
+    REQUIRE( std::signbit( l_values[0] ) );
+    REQUIRE( std::isnan( l_values[3] ) );
+
+    REQUIRE( l_snapshot.read( t_compressed::m_maskMomentumY, l_values.data() ) );
+    for( tsunami_lab::t_idx l_iy = 0; l_iy < l_ny; l_iy++ ) {
+      REQUIRE( std::memcmp( l_values.data() + l_iy * l_nx,
+                            l_hv.data() + l_iy * l_stride,
+                            l_nx * sizeof(tsunami_lab::t_real) ) == 0 );
+    }
+
+    // the incomplete chunk on its own
+    std::vector< tsunami_lab::t_real > l_chunk( t_compressed::m_chunkSize );
+    REQUIRE( l_snapshot.readChunk( t_compressed::m_maskHeight, 1, l_chunk.data() ) );
+    tsunami_lab::t_idx l_first = t_compressed::m_chunkSize;
+    REQUIRE( l_chunk[0] == l_h[ (l_first / l_nx) * l_stride + l_first % l_nx ] );
+    REQUIRE( l_chunk[l_nx * l_ny - l_first - 1] == l_h[ (l_ny-1) * l_stride + l_nx-1 ] );
+    REQUIRE( !l_snapshot.readChunk( t_compressed::m_maskHeight, 2, l_chunk.data() ) );
+  }
+
+  std::remove( l_path.c_str() );
+}
+
+TEST_CASE( "Test the compression ratio of smooth fields.", "[CompressedRatio]" ) {
+  typedef tsunami_lab::io::Compressed t_compressed;
+
+  // smooth 1d field of a dam break's rarefaction and a resting region
+  tsunami_lab::t_idx l_nx = 1 << 18;
+  std::vector< tsunami_lab::t_real > l_h( l_nx );
+  std::vector< tsunami_lab::t_real > l_hu( l_nx );
+  for( tsunami_lab::t_idx l_ix = 0; l_ix < l_nx; l_ix++ ) {
+    tsunami_lab::t_real l_x = tsunami_lab::t_real(l_ix) / l_nx;
+    l_h[l_ix] = (l_x < 0.5) ? 10 - 2 * l_x : 5;
+    l_hu[l_ix] = (l_x < 0.5) ? 3 * l_x : 0;
+  }
+
+  std::string l_path = "test_compressed_ratio.tsz";
+  REQUIRE( t_compressed::write( l_path,
+                                1,
+                                l_nx,
+                                1,
+                                l_nx,
+                                0,
+                                l_h.data(),
+                                l_hu.data(),
+                                nullptr ) );
+
+  {
+    t_compressed l_snapshot( l_path );
+    REQUIRE( l_snapshot.isValid() );
+    REQUIRE( l_snapshot.getSize() * 3 < 2 * l_nx * sizeof(tsunami_lab::t_real) );
+
+    std::vector< tsunami_lab::t_real > l_values( l_nx );
+    REQUIRE( l_snapshot.read( t_compressed::m_maskMomentumX, l_values.data() ) );
+    REQUIRE( l_values == l_hu );
+  }
+
+  std::remove( l_path.c_str() );
+}
+
+TEST_CASE( "Test the compressed reader with invalid files.", "[CompressedInvalid]" ) {
+  typedef tsunami_lab::io::Compressed t_compressed;
+
+  // missing file
+  t_compressed l_missing( "test_compressed_missing.tsz" );
+  REQUIRE( !l_missing.isValid() );
+
+  // truncated and corrupted files
+  std::vector< tsunami_lab::t_real > l_h( 1000 );
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 1000; l_ce++ ) {
+    l_h[l_ce] = 10 + tsunami_lab::t_real(l_ce) / 1000;
+  }
+
+  std::string l_path = "test_compressed_invalid.tsz";
+  REQUIRE( t_compressed::write( l_path, 1, 1000, 1, 1000, 0, l_h.data(), nullptr, nullptr ) );
+
+  std::vector< char > l_data;
+  {
+    std::FILE * l_file = std::fopen( l_path.c_str(), "rb" );
+    REQUIRE( l_file != nullptr );
+    char l_buffer[4096];
+    std::size_t l_nBytes = 0;
+    while( (l_nBytes = std::fread( l_buffer, 1, sizeof(l_buffer), l_file )) > 0 ) {
+      l_data.insert( l_data.end(), l_buffer, l_buffer + l_nBytes );
+    }
+    std::fclose( l_file );
+  }
+
+  // drop the last byte
+  std::FILE * l_file = std::fopen( l_path.c_str(), "wb" );
+  std::fwrite( l_data.data(), 1, l_data.size() - 1, l_file );
+  std::fclose( l_file );
+  {
+    t_compressed l_invalid( l_path );
+    REQUIRE( !l_invalid.isValid() );
+  }
+
+  // flip a bit in the chunk: the header and the table stay valid, the decompression fails
+  l_data[ l_data.size() - 20 ] ^= 0x04;
+  l_file = std::fopen( l_path.c_str(), "wb" );
+  std::fwrite( l_data.data(), 1, l_data.size(), l_file );
+  std::fclose( l_file );
+  {
+    t_compressed l_corrupted( l_path );
+    REQUIRE( l_corrupted.isValid() );
+    REQUIRE( !l_corrupted.read( t_compressed::m_maskHeight, l_h.data() ) );
+  }
+
+  std::remove( l_path.c_str() );
+}
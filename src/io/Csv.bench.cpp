@@ -0,0 +1,80 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the CSV output.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "Csv.h"
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+  /**
+   * Stream buffer which discards all characters but counts them.
+   * Isolates the formatting from the file system.
+   **/
+  class CountingBuffer: public std::streambuf {
+    public:
+      //! number of characters written
+      tsunami_lab::t_idx m_nChars = 0;
+
+    protected:
+      std::streamsize xsputn( char const *,
+                              std::streamsize i_count ) {
+        m_nChars += i_count;
+        return i_count;
+      }
+
+      int_type overflow( int_type i_ch ) {
+        if( !traits_type::eq_int_type( i_ch, traits_type::eof() ) ) m_nChars++;
+        return traits_type::not_eof( i_ch );
+      }
+  };
+
+  /**
+   * Runs the case.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    tsunami_lab::t_idx l_nx = 1024;
+    tsunami_lab::t_idx l_ny = 1024;
+
+    // representative values of a dam break with random perturbations
+    std::mt19937 l_gen( 42 );
+    std::uniform_real_distribution< tsunami_lab::t_real > l_dist( -1, 1 );
+
+    std::vector< tsunami_lab::t_real > l_data( 3 * l_nx * l_ny );
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nx * l_ny; l_ce++ ) {
+      l_data[l_ce] = 10 + l_dist( l_gen );
+      l_data[l_nx * l_ny + l_ce] = 20 * l_dist( l_gen );
+      l_data[2 * l_nx * l_ny + l_ce] = 20 * l_dist( l_gen );
+    }
+
+    CountingBuffer l_buffer;
+    std::ostream l_stream( &l_buffer );
+
+    double l_seconds = io_benchmark.measure( [&]() {
+      l_buffer.m_nChars = 0;
+      tsunami_lab::io::Csv::write( 0.01,
+                                   l_nx,
+                                   l_ny,
+                                   l_nx,
+                                   l_data.data(),
+                                   l_data.data() + l_nx * l_ny,
+                                   l_data.data() + 2 * l_nx * l_ny,
+                                   l_stream );
+    } );
+
+    io_benchmark.report( "Csv::write/" + std::to_string( l_nx ) + "x" + std::to_string( l_ny ),
+                         "bytes/s",
+                         l_buffer.m_nChars / l_seconds );
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "Csv",
+                                                                         run );
+}
@@ -5,6 +5,19 @@
  * IO-routines for writing a snapshot as Comma Separated Values (CSV).
  **/
 #include "Csv.h"
+#include <charconv>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+char * tsunami_lab::io::Csv::format( t_real   i_value,
+                                     char   * o_first ) {
+  // shortest representation which round-trips; never exceeds m_maxValueLength
+  return std::to_chars( o_first,
+                        o_first + m_maxValueLength,
+                        i_value ).ptr;
+}
 
 void tsunami_lab::io::Csv::write( t_real               i_dxy,
                                   t_idx                i_nx,
@@ -13,7 +26,15 @@ void tsunami_lab::io::Csv::write( t_real               i_dxy,
                                   t_real       const * i_h,
                                   t_real       const * i_hu,
                                   t_real       const * i_hv,
-                                  std::ostream       & io_stream ) {
+                                  std::ostream       & io_stream,
+                                  int                  i_nThreads,
+                                  t_idx                i_offsetX ) {
+  // threads which format the chunks
+  int l_nThreads = 1;
+#ifdef _OPENMP
+  l_nThreads = (i_nThreads > 0) ? i_nThreads : omp_get_max_threads();
+#endif
+
   // write the CSV header
   io_stream << "x,y";
   if( i_h  != nullptr ) io_stream << ",height";
@@ -21,22 +42,57 @@ void tsunami_lab::io::Csv::write( t_real               i_dxy,
   if( i_hv != nullptr ) io_stream << ",momentum_y";
   io_stream << "\n";
 
-  // iterate over all cells
-  for( t_idx l_iy = 0; l_iy < i_ny; l_iy++ ) {
-    for( t_idx l_ix = 0; l_ix < i_nx; l_ix++ ) {
-      // derive coordinates of cell center
-      t_real l_posX = (l_ix + 0.5) * i_dxy;
-      t_real l_posY = (l_iy + 0.5) * i_dxy;
-
-      t_idx l_id = l_iy * i_stride + l_ix;
-
-      // write data
-      io_stream << l_posX << "," << l_posY;
-      if( i_h  != nullptr ) io_stream << "," << i_h[l_id];
-      if( i_hu != nullptr ) io_stream << "," << i_hu[l_id];
-      if( i_hv != nullptr ) io_stream << "," << i_hv[l_id];
-      io_stream << "\n";
+  // upper bound of a row's length: five values, the separators and the line break
+  t_idx l_rowLength = 5 * (m_maxValueLength + 1);
+
+  // cells are formatted in chunks, several chunks in parallel, and written in order
+  t_idx l_nCells = i_nx * i_ny;
+  t_idx l_nChunks = (l_nCells + m_chunkSize - 1) / m_chunkSize;
+
+  std::vector< std::vector< char > > l_buffers( (l_nChunks < m_nChunksRound) ? l_nChunks : m_nChunksRound );
+  std::vector< t_idx > l_sizes( l_buffers.size() );
+
+  for( t_idx l_ch0 = 0; l_ch0 < l_nChunks; l_ch0 += l_buffers.size() ) {
+    t_idx l_nChunksRound = l_nChunks - l_ch0;
+    l_nChunksRound = (l_nChunksRound < l_buffers.size()) ? l_nChunksRound : l_buffers.size();
+
+#pragma omp parallel for num_threads( l_nThreads ) schedule(dynamic)
+    for( t_idx l_cr = 0; l_cr < l_nChunksRound; l_cr++ ) {
+      t_idx l_first = (l_ch0 + l_cr) * m_chunkSize;
+      t_idx l_last = l_first + m_chunkSize;
+      l_last = (l_last < l_nCells) ? l_last : l_nCells;
+
+      std::vector< char > & l_buffer = l_buffers[l_cr];
+      l_buffer.resize( (l_last - l_first) * l_rowLength );
+      char * l_ptr = l_buffer.data();
+
+      for( t_idx l_ce = l_first; l_ce < l_last; l_ce++ ) {
+        t_idx l_ix = l_ce % i_nx;
+        t_idx l_iy = l_ce / i_nx;
+
+        // derive coordinates of cell center
+        t_real l_posX = (i_offsetX + l_ix + 0.5) * i_dxy;
+        t_real l_posY = (l_iy + 0.5) * i_dxy;
+
+        t_idx l_id = l_iy * i_stride + l_ix;
+
+        // write data
+        l_ptr = format( l_posX, l_ptr );
+        *l_ptr++ = ',';
+        l_ptr = format( l_posY, l_ptr );
+        if( i_h  != nullptr ) { *l_ptr++ = ','; l_ptr = format( i_h[l_id],  l_ptr ); }
+        if( i_hu != nullptr ) { *l_ptr++ = ','; l_ptr = format( i_hu[l_id], l_ptr ); }
+        if( i_hv != nullptr ) { *l_ptr++ = ','; l_ptr = format( i_hv[l_id], l_ptr ); }
+        *l_ptr++ = '\n';
+      }
+
+      l_sizes[l_cr] = l_ptr - l_buffer.data();
+    }
+
+    for( t_idx l_cr = 0; l_cr < l_nChunksRound; l_cr++ ) {
+      io_stream.write( l_buffers[l_cr].data(),
+                       l_sizes[l_cr] );
     }
   }
   io_stream << std::flush;
-}
\ No newline at end of file
+}
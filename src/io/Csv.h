@@ -18,9 +18,31 @@ namespace tsunami_lab {
 }
 
 class tsunami_lab::io::Csv {
+  private:
+    //! maximum number of characters of a formatted value
+    static t_idx constexpr m_maxValueLength = 32;
+
+    //! number of cells which are formatted as one chunk
+    static t_idx constexpr m_chunkSize = 16384;
+
+    //! maximum number of chunks which are buffered at a time
+    static t_idx constexpr m_nChunksRound = 64;
+
+    /**
+     * Formats a value using its shortest representation which round-trips.
+     *
+     * @param i_value value which is formatted.
+     * @param o_first first character of the output; at least m_maxValueLength characters are available.
+     * @return one past the last written character.
+     **/
+    static char * format( t_real   i_value,
+                          char   * o_first );
+
   public:
     /**
      * Writes the data as CSV to the given stream.
+     * Values are written in their shortest representation which round-trips, e.g., 0.1 for 0.1f.
+     * Chunks of cells are formatted in parallel into memory and written in order.
      *
      * @param i_dxy cell width in x- and y-direction.
      * @param i_nx number of cells in x-direction.
@@ -30,6 +52,8 @@ class tsunami_lab::io::Csv {
      * @param i_hu momentum in x-direction of the cells; optional: use nullptr if not required.
      * @param i_hv momentum in y-direction of the cells; optional: use nullptr if not required.
      * @param io_stream stream to which the CSV-data is written.
+     * @param i_nThreads number of threads which format the chunks; 0 uses the default number of OpenMP threads.
+     * @param i_offsetX global index of the first cell in x-direction, e.g., of a rank's subdomain; shifts the x-coordinates.
      **/
     static void write( t_real               i_dxy,
                        t_idx                i_nx,
@@ -38,7 +62,9 @@ class tsunami_lab::io::Csv {
                        t_real       const * i_h,
                        t_real       const * i_hu,
                        t_real       const * i_hv,
-                       std::ostream       & io_stream );
+                       std::ostream       & io_stream,
+                       int                  i_nThreads = 0,
+                       t_idx                i_offsetX = 0 );
 };
 
 #endif
\ No newline at end of file
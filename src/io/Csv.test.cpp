@@ -6,7 +6,10 @@
  **/
 #include <catch2/catch.hpp>
 #include "../constants.h"
+#include <cstdlib>
 #include <sstream>
+#include <string>
+#include <vector>
 #define private public
 #include "Csv.h"
 #undef public
@@ -36,6 +39,24 @@ TEST_CASE( "Test the CSV-writer for 1D settings.", "[CsvWrite1d]" ) {
 
   REQUIRE( l_stream0.str().size() == l_ref0.size() );
   REQUIRE( l_stream0.str() == l_ref0 );
+
+  // subdomain of the last three cells, whose coordinates are global
+  std::stringstream l_streamSub;
+  tsunami_lab::io::Csv::write( 0.5,
+                               3,
+                               1,
+                               3,
+                               l_h+3,
+                               l_hu+3,
+                               nullptr,
+                               l_streamSub,
+                               0,
+                               2 );
+
+  REQUIRE( l_streamSub.str() == "x,y,height,momentum_x\n"
+                                "1.25,0.25,3,3\n"
+                                "1.75,0.25,4,2\n"
+                                "2.25,0.25,5,1\n" );
 }
 
 TEST_CASE( "Test the CSV-writer for 2D settings.", "[CsvWrite2d]" ) {
@@ -72,4 +93,60 @@ TEST_CASE( "Test the CSV-writer for 2D settings.", "[CsvWrite2d]" ) {
 
   REQUIRE( l_stream1.str().size() == l_ref1.size() );
   REQUIRE( l_stream1.str() == l_ref1 );
-}
\ No newline at end of file
+}
+TEST_CASE( "Test the CSV-writer with multiple chunks and round-tripping values.", "[CsvWriteChunks]" ) {
+  // 2D example which spans several chunks; the values have no short decimal representation
+  std::size_t l_nx = 300;
+  std::size_t l_ny = 100;
+  std::size_t l_stride = l_nx + 3;
+
+  std::vector< tsunami_lab::t_real > l_h( l_stride * l_ny );
+  for( std::size_t l_ce = 0; l_ce < l_h.size(); l_ce++ ) {
+    l_h[l_ce] = tsunami_lab::t_real(1) / (l_ce + 3) - tsunami_lab::t_real(1e-7) * l_ce;
+  }
+
+  std::stringstream l_stream;
+  tsunami_lab::io::Csv::write( 0.1,
+                               l_nx,
+                               l_ny,
+                               l_stride,
+                               l_h.data(),
+                               nullptr,
+                               nullptr,
+                               l_stream );
+
+  // the output is independent of the number of threads
+  std::stringstream l_streamSerial;
+  tsunami_lab::io::Csv::write( 0.1,
+                               l_nx,
+                               l_ny,
+                               l_stride,
+                               l_h.data(),
+                               nullptr,
+                               nullptr,
+                               l_streamSerial,
+                               1 );
+  REQUIRE( l_streamSerial.str() == l_stream.str() );
+
+  std::string l_line;
+  std::getline( l_stream, l_line );
+  REQUIRE( l_line == "x,y,height" );
+
+  for( std::size_t l_iy = 0; l_iy < l_ny; l_iy++ ) {
+    for( std::size_t l_ix = 0; l_ix < l_nx; l_ix++ ) {
+      REQUIRE( std::getline( l_stream, l_line ) );
+
+      std::size_t l_sep0 = l_line.find( ',' );
+      std::size_t l_sep1 = l_line.find( ',', l_sep0+1 );
+
+      tsunami_lab::t_real l_x = std::strtof( l_line.substr( 0, l_sep0 ).c_str(), nullptr );
+      tsunami_lab::t_real l_y = std::strtof( l_line.substr( l_sep0+1, l_sep1-l_sep0-1 ).c_str(), nullptr );
+      tsunami_lab::t_real l_value = std::strtof( l_line.substr( l_sep1+1 ).c_str(), nullptr );
+
+      REQUIRE( l_x == tsunami_lab::t_real( (l_ix + 0.5) * tsunami_lab::t_real(0.1) ) );
+      REQUIRE( l_y == tsunami_lab::t_real( (l_iy + 0.5) * tsunami_lab::t_real(0.1) ) );
+      REQUIRE( l_value == l_h[l_iy * l_stride + l_ix] );
+    }
+  }
+  REQUIRE( !std::getline( l_stream, l_line ) );
+}
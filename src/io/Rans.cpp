@@ -0,0 +1,178 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Entropy coding of byte streams with range asymmetric numeral systems (rANS).
+ **/
+#include "Rans.h"
+#include <algorithm>
+#include <cstdint>
+
+void tsunami_lab::io::Rans::normalize( t_idx         const i_counts[256],
+                                       std::uint32_t       o_freqs[256] ) {
+  t_idx l_nTotal = 0;
+  for( unsigned short l_sy = 0; l_sy < 256; l_sy++ ) {
+    l_nTotal += i_counts[l_sy];
+  }
+
+  // rounded frequencies, every symbol which occurs keeps at least one
+  std::int64_t l_sum = 0;
+  for( unsigned short l_sy = 0; l_sy < 256; l_sy++ ) {
+    o_freqs[l_sy] = 0;
+    if( i_counts[l_sy] > 0 ) {
+      o_freqs[l_sy] = std::max( std::uint32_t(1),
+                                std::uint32_t( (i_counts[l_sy] * m_scale + l_nTotal / 2) / l_nTotal ) );
+    }
+    l_sum += o_freqs[l_sy];
+  }
+
+  // the rounding leaves a deviation of the sum, which is spread over the symbols in the order of their counts
+  unsigned short l_order[256];
+  for( unsigned short l_sy = 0; l_sy < 256; l_sy++ ) {
+    l_order[l_sy] = l_sy;
+  }
+  std::stable_sort( l_order,
+                    l_order + 256,
+                    [&]( unsigned short i_sy0, unsigned short i_sy1 ) { return i_counts[i_sy0] > i_counts[i_sy1]; } );
+
+  while( l_sum != m_scale ) {
+    for( unsigned short l_or = 0; l_or < 256 && l_sum != m_scale; l_or++ ) {
+      unsigned short l_sy = l_order[l_or];
+      if( i_counts[l_sy] == 0 ) break;
+
+      if( l_sum < m_scale ) {
+        o_freqs[l_sy]++;
+        l_sum++;
+      }
+      else if( o_freqs[l_sy] > 1 ) {
+        o_freqs[l_sy]--;
+        l_sum--;
+      }
+    }
+  }
+}
+
+void tsunami_lab::io::Rans::encode( t_idx                         i_nSymbols,
+                                    std::uint8_t          const * i_symbols,
+                                    std::vector< std::uint8_t > & io_out ) {
+  t_idx l_counts[256] = { 0 };
+  for( t_idx l_id = 0; l_id < i_nSymbols; l_id++ ) {
+    l_counts[ i_symbols[l_id] ]++;
+  }
+
+  std::uint32_t l_freqs[256];
+  normalize( l_counts,
+             l_freqs );
+
+  // table of the symbols
+  std::uint32_t l_starts[256];
+  std::uint32_t l_start = 0;
+  std::uint16_t l_nDistinct = 0;
+  for( unsigned short l_sy = 0; l_sy < 256; l_sy++ ) {
+    l_starts[l_sy] = l_start;
+    l_start += l_freqs[l_sy];
+    if( l_freqs[l_sy] > 0 ) l_nDistinct++;
+  }
+
+  io_out.push_back( l_nDistinct & 0xff );
+  io_out.push_back( l_nDistinct >> 8 );
+  for( unsigned short l_sy = 0; l_sy < 256; l_sy++ ) {
+    if( l_freqs[l_sy] == 0 ) continue;
+    io_out.push_back( std::uint8_t( l_sy ) );
+    io_out.push_back( l_freqs[l_sy] & 0xff );
+    io_out.push_back( l_freqs[l_sy] >> 8 );
+  }
+
+  // the encoder runs backwards, thus the payload is assembled in reverse order
+  std::vector< std::uint8_t > l_payload;
+  l_payload.reserve( i_nSymbols / 2 + 16 );
+
+  std::uint32_t l_x = m_lower;
+  for( t_idx l_id = i_nSymbols; l_id-- > 0; ) {
+    std::uint32_t l_freq = l_freqs[ i_symbols[l_id] ];
+    std::uint32_t l_xMax = ( (m_lower >> m_scaleBits) << 8 ) * l_freq;
+    while( l_x >= l_xMax ) {
+      l_payload.push_back( l_x & 0xff );
+      l_x >>= 8;
+    }
+    l_x = ( (l_x / l_freq) << m_scaleBits ) + (l_x % l_freq) + l_starts[ i_symbols[l_id] ];
+  }
+  for( unsigned short l_by = 0; l_by < 4; l_by++ ) {
+    l_payload.push_back( l_x & 0xff );
+    l_x >>= 8;
+  }
+
+  std::uint32_t l_size = l_payload.size();
+  for( unsigned short l_by = 0; l_by < 4; l_by++ ) {
+    io_out.push_back( (l_size >> (8*l_by)) & 0xff );
+  }
+  io_out.insert( io_out.end(),
+                 l_payload.rbegin(),
+                 l_payload.rend() );
+}
+
+bool tsunami_lab::io::Rans::decode( std::uint8_t const * i_data,
+                                    std::size_t          i_size,
+                                    t_idx                i_nSymbols,
+                                    std::uint8_t       * o_symbols,
+                                    std::size_t        & o_size ) {
+  // table of the symbols
+  if( i_size < 2 ) return false;
+  std::size_t l_nDistinct = i_data[0] | (std::size_t(i_data[1]) << 8);
+  if( l_nDistinct < 1 || l_nDistinct > 256 ) return false;
+
+  std::size_t l_pos = 2;
+  if( i_size < l_pos + 3 * l_nDistinct + 4 ) return false;
+
+  std::uint8_t l_symbols[256];
+  std::uint32_t l_freqs[256];
+  std::uint32_t l_starts[256];
+  std::uint8_t l_slots[m_scale];
+  std::uint32_t l_start = 0;
+  for( std::size_t l_di = 0; l_di < l_nDistinct; l_di++ ) {
+    l_symbols[l_di] = i_data[l_pos];
+    l_freqs[l_di] = i_data[l_pos+1] | (std::uint32_t(i_data[l_pos+2]) << 8);
+    l_starts[l_di] = l_start;
+    l_pos += 3;
+
+    if( l_freqs[l_di] == 0 || l_start + l_freqs[l_di] > m_scale ) return false;
+    std::fill( l_slots + l_start,
+               l_slots + l_start + l_freqs[l_di],
+               std::uint8_t( l_di ) );
+    l_start += l_freqs[l_di];
+  }
+  if( l_start != m_scale ) return false;
+
+  // payload
+  std::size_t l_sizePayload = 0;
+  for( unsigned short l_by = 0; l_by < 4; l_by++ ) {
+    l_sizePayload |= std::size_t( i_data[l_pos+l_by] ) << (8*l_by);
+  }
+  l_pos += 4;
+  if( l_sizePayload < 4 || i_size - l_pos < l_sizePayload ) return false;
+
+  std::uint8_t const * l_payload = i_data + l_pos;
+  std::uint32_t l_x = 0;
+  for( unsigned short l_by = 0; l_by < 4; l_by++ ) {
+    l_x = (l_x << 8) | l_payload[l_by];
+  }
+  std::size_t l_pp = 4;
+
+  for( t_idx l_id = 0; l_id < i_nSymbols; l_id++ ) {
+    std::uint32_t l_slot = l_x & (m_scale - 1);
+    std::uint8_t l_di = l_slots[l_slot];
+    o_symbols[l_id] = l_symbols[l_di];
+    l_x = l_freqs[l_di] * (l_x >> m_scaleBits) + l_slot - l_starts[l_di];
+
+    while( l_x < m_lower ) {
+      if( l_pp >= l_sizePayload ) return false;
+      l_x = (l_x << 8) | l_payload[l_pp];
+      l_pp++;
+    }
+  }
+
+  o_size = l_pos + l_sizePayload;
+
+  // the decoder ends in the encoder's initial state after consuming the entire payload
+  return l_x == m_lower && l_pp == l_sizePayload;
+}
@@ -0,0 +1,85 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Entropy coding of byte streams with range asymmetric numeral systems (rANS).
+ *
+ * Layout of an encoded stream:
+ *   number of distinct symbols (2 bytes),
+ *   symbol (1 byte) and normalized frequency (2 bytes) of every distinct symbol,
+ *   size of the payload in bytes (4 bytes),
+ *   payload, starting with the final state of the encoder (4 bytes).
+ * All integers are little-endian.
+ **/
+#ifndef TSUNAMI_LAB_IO_RANS
+#define TSUNAMI_LAB_IO_RANS
+
+#include "../constants.h"
+#include <cstdint>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace io {
+    class Rans;
+  }
+}
+
+/**
+ * Static order-0 rANS coder with a 32-bit state and byte-wise renormalization.
+ *
+ * The frequencies of the symbols are counted per stream and normalized to m_scale.
+ * A symbol with normalized frequency f costs log2(m_scale/f) bits;
+ * thus, a stream of a single symbol, e.g., the zero high bytes of small integers, costs no payload beyond the final state.
+ **/
+class tsunami_lab::io::Rans {
+  private:
+    //! number of bits of the normalized frequencies' sum
+    static unsigned short constexpr m_scaleBits = 12;
+
+    //! sum of the normalized frequencies
+    static std::uint32_t constexpr m_scale = 1u << m_scaleBits;
+
+    //! lower bound of the normalized state interval
+    static std::uint32_t constexpr m_lower = 1u << 23;
+
+    /**
+     * Normalizes the counts of the symbols to frequencies which sum up to m_scale.
+     * Every symbol which occurs keeps a frequency of at least one.
+     *
+     * @param i_counts number of occurrences of every symbol.
+     * @param o_freqs will be set to the normalized frequencies.
+     **/
+    static void normalize( t_idx         const i_counts[256],
+                           std::uint32_t       o_freqs[256] );
+
+  public:
+    /**
+     * Encodes a stream of bytes and appends it to a buffer.
+     *
+     * @param i_nSymbols number of bytes; has to be at least one.
+     * @param i_symbols bytes which are encoded.
+     * @param io_out buffer to which the encoded stream is appended.
+     **/
+    static void encode( t_idx                         i_nSymbols,
+                        std::uint8_t          const * i_symbols,
+                        std::vector< std::uint8_t > & io_out );
+
+    /**
+     * Decodes a stream of bytes.
+     * The encoded stream is checked against the buffer's bounds, thus corrupted streams fail without reading beyond them.
+     *
+     * @param i_data encoded stream.
+     * @param i_size size of the buffer holding the encoded stream in bytes.
+     * @param i_nSymbols number of bytes which are decoded.
+     * @param o_symbols will be set to the decoded bytes.
+     * @param o_size will be set to the size of the encoded stream in bytes.
+     * @return true if successful, false otherwise.
+     **/
+    static bool decode( std::uint8_t const * i_data,
+                        std::size_t          i_size,
+                        t_idx                i_nSymbols,
+                        std::uint8_t       * o_symbols,
+                        std::size_t        & o_size );
+};
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the rANS entropy coder.
+ **/
+#include <catch2/catch.hpp>
+#include "Rans.h"
+#include <random>
+#include <vector>
+
+TEST_CASE( "Test the rANS entropy coder.", "[Rans]" ) {
+  std::mt19937 l_gen( 42 );
+  std::geometric_distribution< int > l_geometric( 0.3 );
+  std::uniform_int_distribution< int > l_uniform( 0, 255 );
+
+  // skewed, uniform and constant streams, including a single byte
+  std::vector< std::vector< std::uint8_t > > l_streams( 4 );
+  for( unsigned int l_id = 0; l_id < 100000; l_id++ ) {
+    l_streams[0].push_back( std::min( l_geometric( l_gen ), 255 ) );
+    l_streams[1].push_back( l_uniform( l_gen ) );
+    l_streams[2].push_back( 7 );
+  }
+  l_streams[3].push_back( 255 );
+
+  // two streams in one buffer
+  std::vector< std::uint8_t > l_encoded;
+  tsunami_lab::io::Rans::encode( l_streams[0].size(),
+                                 l_streams[0].data(),
+                                 l_encoded );
+  std::size_t l_size0 = l_encoded.size();
+  tsunami_lab::io::Rans::encode( l_streams[1].size(),
+                                 l_streams[1].data(),
+                                 l_encoded );
+
+  // the entropy of the geometric distribution is about 2.9 bits
+  REQUIRE( l_size0 < 100000 * 3 / 8 );
+  REQUIRE( l_encoded.size() - l_size0 < 100000 * 1.01 );
+
+  std::vector< std::uint8_t > l_decoded( 100000 );
+  std::size_t l_size = 0;
+  REQUIRE( tsunami_lab::io::Rans::decode( l_encoded.data(),
+                                          l_encoded.size(),
+                                          100000,
+                                          l_decoded.data(),
+                                          l_size ) );
+  REQUIRE( l_size == l_size0 );
+  REQUIRE( l_decoded == l_streams[0] );
+
+  REQUIRE( tsunami_lab::io::Rans::decode( l_encoded.data() + l_size0,
+                                          l_encoded.size() - l_size0,
+                                          100000,
+                                          l_decoded.data(),
+                                          l_size ) );
+  REQUIRE( l_size == l_encoded.size() - l_size0 );
+  REQUIRE( l_decoded == l_streams[1] );
+
+  // a constant stream only costs the table and the final state
+  l_encoded.clear();
+  tsunami_lab::io::Rans::encode( l_streams[2].size(),
+                                 l_streams[2].data(),
+                                 l_encoded );
+  REQUIRE( l_encoded.size() == 2 + 3 + 4 + 4 );
+  REQUIRE( tsunami_lab::io::Rans::decode( l_encoded.data(),
+                                          l_encoded.size(),
+                                          100000,
+                                          l_decoded.data(),
+                                          l_size ) );
+  REQUIRE( l_decoded == l_streams[2] );
+
+  l_encoded.clear();
+  tsunami_lab::io::Rans::encode( 1,
+                                 l_streams[3].data(),
+                                 l_encoded );
+  REQUIRE( tsunami_lab::io::Rans::decode( l_encoded.data(),
+                                          l_encoded.size(),
+                                          1,
+                                          l_decoded.data(),
+                                          l_size ) );
+  REQUIRE( l_decoded[0] == 255 );
+
+  // truncated and corrupted streams fail
+  l_encoded.clear();
+  tsunami_lab::io::Rans::encode( l_streams[0].size(),
+                                 l_streams[0].data(),
+                                 l_encoded );
+  REQUIRE( !tsunami_lab::io::Rans::decode( l_encoded.data(),
+                                           l_encoded.size() - 1,
+                                           100000,
+                                           l_decoded.data(),
+                                           l_size ) );
+  l_encoded[ l_encoded.size() / 2 ] ^= 0x10;
+  REQUIRE( !tsunami_lab::io::Rans::decode( l_encoded.data(),
+                                           l_encoded.size(),
+                                           100000,
+                                           l_decoded.data(),
+                                           l_size ) );
+}
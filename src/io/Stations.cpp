@@ -0,0 +1,189 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Time series of the quantities at stations, e.g., tide gauges.
+ **/
+#include "Stations.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+char * tsunami_lab::io::Stations::format( t_real   i_value,
+                                          char   * o_first ) {
+  // shortest representation which round-trips; never exceeds m_maxValueLength
+  return std::to_chars( o_first,
+                        o_first + m_maxValueLength,
+                        i_value ).ptr;
+}
+
+tsunami_lab::io::Stations::Stations( std::string const & i_path,
+                                     t_real              i_dxy,
+                                     t_idx               i_nx,
+                                     t_idx               i_ny,
+                                     t_idx               i_interval,
+                                     t_idx               i_capacity,
+                                     t_real              i_timeRestart ) {
+  m_dxy = i_dxy;
+  m_nx = i_nx;
+  m_ny = i_ny;
+  m_interval = (i_interval < 1) ? 1 : i_interval;
+  m_capacity = (i_capacity < 1) ? 1 : i_capacity;
+
+  // on restarts, keep the header and the complete rows before the restart's time; the rows are ordered by time.
+  // the times are parsed in the precision t_real, in which they were formatted, since a double may round them below the restart's time
+  std::uintmax_t l_sizeKept = 0;
+  if( i_timeRestart >= 0 ) {
+    std::ifstream l_file( i_path );
+    std::string l_line;
+    if( std::getline( l_file, l_line ) && !l_file.eof() ) {
+      l_sizeKept = l_line.size() + 1;
+      while( std::getline( l_file, l_line ) && !l_file.eof() ) {
+        t_real l_time = 0;
+        std::from_chars( l_line.data(),
+                         l_line.data() + l_line.size(),
+                         l_time );
+        if( l_time >= i_timeRestart ) break;
+        l_sizeKept += l_line.size() + 1;
+      }
+    }
+  }
+
+  if( l_sizeKept > 0 ) {
+    std::error_code l_error;
+    std::filesystem::resize_file( i_path,
+                                  l_sizeKept,
+                                  l_error );
+    m_file.open( i_path,
+                 std::ios::out | std::ios::app );
+    m_failed = bool(l_error) || m_file.fail();
+  }
+  else {
+    m_file.open( i_path,
+                 std::ios::out | std::ios::trunc );
+    m_file << "time,station,height,momentum_x,momentum_y\n";
+    m_failed = m_file.fail();
+  }
+}
+
+tsunami_lab::io::Stations::~Stations() {
+  flush();
+}
+
+bool tsunami_lab::io::Stations::addStation( std::string const & i_name,
+                                            t_real              i_x,
+                                            t_real              i_y ) {
+  if( m_sampled ) return false;
+
+  // cell which contains the point; the comparisons also reject NaNs
+  t_real l_ix = std::floor( i_x / m_dxy );
+  t_real l_iy = std::floor( i_y / m_dxy );
+  if( !( l_ix >= 0 && l_ix < m_nx && l_iy >= 0 && l_iy < m_ny ) ) return false;
+
+  m_names.push_back( i_name );
+  m_ix.push_back( l_ix );
+  m_iy.push_back( l_iy );
+
+  return true;
+}
+
+bool tsunami_lab::io::Stations::addStations( std::istream & io_stream ) {
+  std::string l_line;
+  while( std::getline( io_stream, l_line ) ) {
+    if( !l_line.empty() && l_line.back() == '\r' ) l_line.pop_back();
+    if( l_line.empty() || l_line[0] == '#' ) continue;
+
+    // name,x,y
+    std::size_t l_sep0 = l_line.find( ',' );
+    if( l_sep0 == std::string::npos || l_sep0 == 0 ) return false;
+    std::size_t l_sep1 = l_line.find( ',', l_sep0+1 );
+    if( l_sep1 == std::string::npos || l_line.find( ',', l_sep1+1 ) != std::string::npos ) return false;
+
+    std::string l_coords[2] = { l_line.substr( l_sep0+1, l_sep1-l_sep0-1 ),
+                                l_line.substr( l_sep1+1 ) };
+    t_real l_xy[2] = { 0, 0 };
+    for( unsigned short l_di = 0; l_di < 2; l_di++ ) {
+      char * l_end = nullptr;
+      l_xy[l_di] = std::strtod( l_coords[l_di].c_str(), &l_end );
+      if( l_coords[l_di].empty() || *l_end != '\0' ) return false;
+    }
+
+    if( !addStation( l_line.substr( 0, l_sep0 ),
+                     l_xy[0],
+                     l_xy[1] ) ) return false;
+  }
+
+  return true;
+}
+
+bool tsunami_lab::io::Stations::sample( t_idx                i_timeStep,
+                                        t_real               i_time,
+                                        t_idx                i_stride,
+                                        t_real       const * i_h,
+                                        t_real       const * i_hu,
+                                        t_real       const * i_hv,
+                                        bool                 i_force ) {
+  if( m_names.empty() || ( i_timeStep % m_interval != 0 && !i_force ) ) return true;
+
+  // the buffer is allocated once and reused after every flush
+  if( !m_sampled ) {
+    m_samples.reserve( m_capacity * (1 + 3 * m_names.size()) );
+    m_sampled = true;
+  }
+
+  m_samples.push_back( i_time );
+  for( t_idx l_st = 0; l_st < m_names.size(); l_st++ ) {
+    t_idx l_id = m_iy[l_st] * i_stride + m_ix[l_st];
+    m_samples.push_back( i_h[l_id] );
+    m_samples.push_back( i_hu[l_id] );
+    m_samples.push_back( (i_hv != nullptr) ? i_hv[l_id] : 0 );
+  }
+
+  if( m_samples.size() >= m_capacity * (1 + 3 * m_names.size()) ) {
+    return flush();
+  }
+  return true;
+}
+
+bool tsunami_lab::io::Stations::flush() {
+  if( m_samples.empty() || !m_file.is_open() ) return isValid();
+
+  // upper bound of the block's length: a row per sample and station with four values, the name, the separators and the line break
+  t_idx l_nSamples = m_samples.size() / (1 + 3 * m_names.size());
+  t_idx l_sizeNames = 0;
+  for( std::string const & l_name : m_names ) {
+    l_sizeNames += l_name.size();
+  }
+  std::vector< char > l_buffer( l_nSamples * ( m_names.size() * 5 * (m_maxValueLength + 1) + l_sizeNames ) );
+
+  char * l_ptr = l_buffer.data();
+  t_real const * l_sample = m_samples.data();
+  for( t_idx l_sa = 0; l_sa < l_nSamples; l_sa++ ) {
+    t_real l_time = l_sample[0];
+    l_sample++;
+
+    for( t_idx l_st = 0; l_st < m_names.size(); l_st++ ) {
+      l_ptr = format( l_time, l_ptr );
+      *l_ptr++ = ',';
+      std::memcpy( l_ptr, m_names[l_st].data(), m_names[l_st].size() );
+      l_ptr += m_names[l_st].size();
+      for( unsigned short l_qt = 0; l_qt < 3; l_qt++ ) {
+        *l_ptr++ = ',';
+        l_ptr = format( l_sample[l_qt], l_ptr );
+      }
+      *l_ptr++ = '\n';
+      l_sample += 3;
+    }
+  }
+
+  m_file.write( l_buffer.data(),
+                l_ptr - l_buffer.data() );
+  m_file.flush();
+  m_failed = m_failed || m_file.fail();
+  m_samples.clear();
+
+  return isValid();
+}
@@ -0,0 +1,193 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Time series of the quantities at stations, e.g., tide gauges.
+ *
+ * Layout of the output, Comma Separated Values (CSV):
+ *   header: time,station,height,momentum_x,momentum_y
+ *   one row per sample and station; the stations appear in the order of their registration.
+ **/
+#ifndef TSUNAMI_LAB_IO_STATIONS
+#define TSUNAMI_LAB_IO_STATIONS
+
+#include "../constants.h"
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace io {
+    class Stations;
+  }
+}
+
+/**
+ * Samples the water heights and momenta at the cells of registered stations.
+ *
+ * The samples are buffered in memory and formatted and appended to a single file
+ * once the buffer is full, on request, and at destruction.
+ * Thus, sampling every time step costs a few loads per station, and the file is written in large blocks.
+ **/
+class tsunami_lab::io::Stations {
+  private:
+    //! maximum number of characters of a formatted value
+    static t_idx constexpr m_maxValueLength = 32;
+
+    //! cell width in x- and y-direction
+    t_real m_dxy = 0;
+
+    //! number of cells in x-direction
+    t_idx m_nx = 0;
+
+    //! number of cells in y-direction
+    t_idx m_ny = 0;
+
+    //! sampling interval in time steps
+    t_idx m_interval = 1;
+
+    //! number of samples which are buffered before a flush
+    t_idx m_capacity = 0;
+
+    //! names of the stations
+    std::vector< std::string > m_names;
+
+    //! cells of the stations in x-direction
+    std::vector< t_idx > m_ix;
+
+    //! cells of the stations in y-direction
+    std::vector< t_idx > m_iy;
+
+    //! buffered samples: time followed by height, momentum in x- and y-direction of every station
+    std::vector< t_real > m_samples;
+
+    //! output file
+    std::ofstream m_file;
+
+    //! true if samples were taken
+    bool m_sampled = false;
+
+    //! true if a write to the output file failed
+    bool m_failed = false;
+
+    /**
+     * Formats a value using its shortest representation which round-trips.
+     *
+     * @param i_value value which is formatted.
+     * @param o_first first character of the output; at least m_maxValueLength characters are available.
+     * @return one past the last written character.
+     **/
+    static char * format( t_real   i_value,
+                          char   * o_first );
+
+  public:
+    /**
+     * Constructor which creates the output file and writes its header.
+     * On restarts, the existing file is continued instead: rows at or after the restart's time are removed,
+     * since the restarted simulation samples them again, and new samples are appended.
+     *
+     * @param i_path path of the output file.
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_interval sampling interval in time steps; 1 samples every time step.
+     * @param i_capacity number of samples which are buffered before a flush.
+     * @param i_timeRestart simulation time of a restart; negative if the simulation starts from scratch.
+     **/
+    Stations( std::string const & i_path,
+              t_real              i_dxy,
+              t_idx               i_nx,
+              t_idx               i_ny,
+              t_idx               i_interval = 1,
+              t_idx               i_capacity = 4096,
+              t_real              i_timeRestart = -1 );
+
+    /**
+     * Destructor which flushes the buffered samples.
+     **/
+    ~Stations();
+
+    Stations( Stations const & ) = delete;
+    Stations & operator=( Stations const & ) = delete;
+
+    /**
+     * Checks whether the output file was created and all writes succeeded.
+     *
+     * @return true if valid, false otherwise.
+     **/
+    bool isValid() const {
+      return m_file.is_open() && !m_failed;
+    }
+
+    /**
+     * Registers a station at the cell containing the given point.
+     * Stations have to be registered before the first sample.
+     *
+     * @param i_name name of the station.
+     * @param i_x x-coordinate of the station.
+     * @param i_y y-coordinate of the station; use 0 in one dimension.
+     * @return true if successful, false if the point is outside of the domain or samples were taken already.
+     **/
+    bool addStation( std::string const & i_name,
+                     t_real              i_x,
+                     t_real              i_y );
+
+    /**
+     * Registers the stations given by a stream of lines name,x,y.
+     * Empty lines and lines starting with # are skipped.
+     *
+     * @param io_stream stream from which the stations are read.
+     * @return true if successful, false if a line is malformed or a station could not be registered.
+     **/
+    bool addStations( std::istream & io_stream );
+
+    /**
+     * Gets the number of registered stations.
+     *
+     * @return number of stations.
+     **/
+    t_idx getNumStations() const {
+      return m_names.size();
+    }
+
+    /**
+     * Gets the cell of a station in x-direction.
+     *
+     * @param i_station id of the station.
+     * @return cell in x-direction.
+     **/
+    t_idx getCellX( t_idx i_station ) const {
+      return m_ix[i_station];
+    }
+
+    /**
+     * Samples the quantities at the stations if the time step is a multiple of the sampling interval or if forced.
+     * Flushes the buffered samples if the buffer is full.
+     *
+     * @param i_timeStep time step counter.
+     * @param i_time simulation time.
+     * @param i_stride stride of the data arrays in y-direction (x is assumed to be stride-1).
+     * @param i_h water height of the cells.
+     * @param i_hu momentum in x-direction of the cells.
+     * @param i_hv momentum in y-direction of the cells; optional: use nullptr in one dimension, which samples zeros.
+     * @param i_force true if the quantities are sampled regardless of the interval, e.g., for the final state.
+     * @return true if successful, false if a flush failed.
+     **/
+    bool sample( t_idx                i_timeStep,
+                 t_real               i_time,
+                 t_idx                i_stride,
+                 t_real       const * i_h,
+                 t_real       const * i_hu,
+                 t_real       const * i_hv,
+                 bool                 i_force = false );
+
+    /**
+     * Formats the buffered samples and appends them to the output file.
+     *
+     * @return true if successful, false otherwise.
+     **/
+    bool flush();
+};
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the time series at stations.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "Stations.h"
+
+TEST_CASE( "Test the time series at stations in a 2D setting.", "[Stations]" ) {
+  // 3 x 2 cells with a stride of 4 and a width of 10
+  tsunami_lab::t_real l_h[8]  = { 1, 2, 3, 0,
+                                  4, 5, 6, 0 };
+  tsunami_lab::t_real l_hu[8] = { 0.5, 0,  0, 0,
+                                  0,   0, -1, 0 };
+  tsunami_lab::t_real l_hv[8] = { 0, 0, 0, 0,
+                                  0, 0, 2.25, 0 };
+
+  std::string l_path = "test_stations.csv";
+  {
+    // interval of two time steps, two samples per flush
+    tsunami_lab::io::Stations l_stations( l_path,
+                                          10,
+                                          3,
+                                          2,
+                                          2,
+                                          2 );
+    REQUIRE( l_stations.isValid() );
+
+    REQUIRE( l_stations.addStation( "a", 0, 0 ) );
+    REQUIRE( !l_stations.addStation( "outside", 30, 5 ) );
+    REQUIRE( !l_stations.addStation( "negative", -0.1, 5 ) );
+
+    std::istringstream l_list( "# name,x,y\n"
+                               "\n"
+                               "b,29.5,19.9\r\n" );
+    REQUIRE( l_stations.addStations( l_list ) );
+    REQUIRE( l_stations.getNumStations() == 2 );
+
+    std::istringstream l_malformed( "c,1\n" );
+    REQUIRE( !l_stations.addStations( l_malformed ) );
+    std::istringstream l_invalid( "c,1,y\n" );
+    REQUIRE( !l_stations.addStations( l_invalid ) );
+
+    // time steps 0, 2 and 4 are sampled; the first two are flushed when the buffer is full
+    for( tsunami_lab::t_idx l_ts = 0; l_ts < 5; l_ts++ ) {
+      REQUIRE( l_stations.sample( l_ts,
+                                  l_ts * 0.5f,
+                                  4,
+                                  l_h,
+                                  l_hu,
+                                  l_hv ) );
+      l_h[0] += 1;
+    }
+    REQUIRE( !l_stations.addStation( "late", 0, 0 ) );
+
+    std::ifstream l_file( l_path );
+    std::stringstream l_stream;
+    l_stream << l_file.rdbuf();
+    REQUIRE( l_stream.str() == "time,station,height,momentum_x,momentum_y\n"
+                               "0,a,1,0.5,0\n"
+                               "0,b,6,-1,2.25\n"
+                               "1,a,3,0.5,0\n"
+                               "1,b,6,-1,2.25\n" );
+  }
+
+  // the remaining sample is flushed at destruction
+  std::ifstream l_file( l_path );
+  std::stringstream l_stream;
+  l_stream << l_file.rdbuf();
+  REQUIRE( l_stream.str() == "time,station,height,momentum_x,momentum_y\n"
+                             "0,a,1,0.5,0\n"
+                             "0,b,6,-1,2.25\n"
+                             "1,a,3,0.5,0\n"
+                             "1,b,6,-1,2.25\n"
+                             "2,a,5,0.5,0\n"
+                             "2,b,6,-1,2.25\n" );
+  l_file.close();
+
+  std::remove( l_path.c_str() );
+}
+
+TEST_CASE( "Test the time series at stations in a 1D setting.", "[Stations1d]" ) {
+  tsunami_lab::t_real l_h[4]  = { 1, 2, 3, 4 };
+  tsunami_lab::t_real l_hu[4] = { 5, 6, 7, 8 };
+
+  std::string l_path = "test_stations_1d.csv";
+  {
+    tsunami_lab::io::Stations l_stations( l_path,
+                                          0.25,
+                                          4,
+                                          1 );
+    REQUIRE( l_stations.addStation( "gauge", 0.6, 0 ) );
+
+    REQUIRE( l_stations.sample( 0, 0, 4, l_h, l_hu, nullptr ) );
+    REQUIRE( l_stations.sample( 1, 0.125, 4, l_h, l_hu, nullptr ) );
+    REQUIRE( l_stations.flush() );
+  }
+
+  std::ifstream l_file( l_path );
+  std::stringstream l_stream;
+  l_stream << l_file.rdbuf();
+  REQUIRE( l_stream.str() == "time,station,height,momentum_x,momentum_y\n"
+                             "0,gauge,3,7,0\n"
+                             "0.125,gauge,3,7,0\n" );
+  l_file.close();
+
+  std::remove( l_path.c_str() );
+}
+
+TEST_CASE( "Test forced samples and restarts of the time series at stations.", "[StationsRestart]" ) {
+  tsunami_lab::t_real l_h[2]  = { 1, 2 };
+  tsunami_lab::t_real l_hu[2] = { 3, 4 };
+
+  // simulation times accumulated from time steps of 0.1: the third one is not exactly representable,
+  // and its shortest representation 0.3 is below it if read in double precision
+  tsunami_lab::t_real l_times[5] = { 0, 0, 0, 0, 0 };
+  for( unsigned short l_ts = 1; l_ts < 5; l_ts++ ) {
+    l_times[l_ts] = l_times[l_ts-1] + tsunami_lab::t_real(0.1);
+  }
+  REQUIRE( std::strtod( "0.3", nullptr ) < l_times[3] );
+
+  std::string l_path = "test_stations_restart.csv";
+  {
+    tsunami_lab::io::Stations l_stations( l_path,
+                                          1,
+                                          2,
+                                          1,
+                                          3 );
+    REQUIRE( l_stations.addStation( "g", 1.5, 0 ) );
+
+    // time steps 0 and 3 are sampled; the final time step 4 only if forced
+    for( tsunami_lab::t_idx l_ts = 0; l_ts < 4; l_ts++ ) {
+      REQUIRE( l_stations.sample( l_ts, l_times[l_ts], 2, l_h, l_hu, nullptr ) );
+    }
+    REQUIRE( l_stations.sample( 4, l_times[4], 2, l_h, l_hu, nullptr, true ) );
+  }
+
+  {
+    // a restart at the time of time step 3 drops the rows at and after the restart's time and appends the new ones
+    tsunami_lab::io::Stations l_stations( l_path,
+                                          1,
+                                          2,
+                                          1,
+                                          3,
+                                          4096,
+                                          l_times[3] );
+    REQUIRE( l_stations.isValid() );
+    REQUIRE( l_stations.addStation( "g", 1.5, 0 ) );
+
+    l_h[1] = 5;
+    REQUIRE( l_stations.sample( 3, l_times[3], 2, l_h, l_hu, nullptr ) );
+  }
+
+  std::ifstream l_file( l_path );
+  std::stringstream l_stream;
+  l_stream << l_file.rdbuf();
+  REQUIRE( l_stream.str() == "time,station,height,momentum_x,momentum_y\n"
+                             "0,g,2,4,0\n"
+                             "0.3,g,5,4,0\n" );
+  l_file.close();
+
+  // a restart without an existing file starts a new one
+  std::remove( l_path.c_str() );
+  {
+    tsunami_lab::io::Stations l_stations( l_path,
+                                          1,
+                                          2,
+                                          1,
+                                          1,
+                                          4096,
+                                          0.5 );
+    REQUIRE( l_stations.isValid() );
+  }
+  l_file.open( l_path );
+  std::string l_header;
+  std::getline( l_file, l_header );
+  REQUIRE( l_header == "time,station,height,momentum_x,momentum_y" );
+  l_file.close();
+
+  std::remove( l_path.c_str() );
+}
@@ -0,0 +1,39 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Vectored IO-routines, which transfer scattered memory regions with few system calls.
+ **/
+#include "Vectored.h"
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+
+bool tsunami_lab::io::Vectored::transfer( int                    i_fd,
+                                          std::vector< iovec > & io_iov,
+                                          bool                   i_write ) {
+  std::size_t l_first = 0;
+
+  while( l_first < io_iov.size() ) {
+    int l_nIov = io_iov.size() - l_first;
+    l_nIov = (l_nIov < IOV_MAX) ? l_nIov : IOV_MAX;
+
+    ssize_t l_nBytes = i_write ? writev( i_fd, io_iov.data() + l_first, l_nIov )
+                               : readv(  i_fd, io_iov.data() + l_first, l_nIov );
+    if( l_nBytes < 0 && errno == EINTR ) continue;
+    if( l_nBytes <= 0 ) return false;
+
+    // skip fully transferred vectors and advance into the partial one
+    std::size_t l_rem = l_nBytes;
+    while( l_first < io_iov.size() && l_rem >= io_iov[l_first].iov_len ) {
+      l_rem -= io_iov[l_first].iov_len;
+      l_first++;
+    }
+    if( l_rem > 0 ) {
+      io_iov[l_first].iov_base = static_cast< char * >( io_iov[l_first].iov_base ) + l_rem;
+      io_iov[l_first].iov_len -= l_rem;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,36 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Vectored IO-routines, which transfer scattered memory regions with few system calls.
+ **/
+#ifndef TSUNAMI_LAB_IO_VECTORED
+#define TSUNAMI_LAB_IO_VECTORED
+
+#include <vector>
+#include <sys/uio.h>
+
+namespace tsunami_lab {
+  namespace io {
+    class Vectored;
+  }
+}
+
+class tsunami_lab::io::Vectored {
+  public:
+    /**
+     * Transfers all bytes described by the I/O vectors.
+     * At most IOV_MAX vectors are passed per call of readv or writev;
+     * interrupted and partial transfers are continued until all bytes are processed.
+     *
+     * @param i_fd file descriptor.
+     * @param io_iov I/O vectors; modified.
+     * @param i_write true for writev, false for readv.
+     * @return true if successful, false otherwise, e.g., at the end of the file while reading.
+     **/
+    static bool transfer( int                    i_fd,
+                          std::vector< iovec > & io_iov,
+                          bool                   i_write );
+};
+
+#endif
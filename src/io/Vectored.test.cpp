@@ -0,0 +1,58 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the vectored IO-routines.
+ **/
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Vectored.h"
+
+TEST_CASE( "Test vectored transfers of more than IOV_MAX vectors.", "[Vectored]" ) {
+  // vectors of 1 to 7 bytes, which exceed the limit of a single call of writev
+  std::size_t l_nIov = 2 * IOV_MAX + 3;
+  std::vector< std::uint8_t > l_data;
+  for( std::size_t l_io = 0; l_io < l_nIov; l_io++ ) {
+    l_data.resize( l_data.size() + l_io % 7 + 1, std::uint8_t( l_io ) );
+  }
+
+  std::vector< iovec > l_iov;
+  std::size_t l_offset = 0;
+  for( std::size_t l_io = 0; l_io < l_nIov; l_io++ ) {
+    l_iov.push_back( { l_data.data() + l_offset, l_io % 7 + 1 } );
+    l_offset += l_io % 7 + 1;
+  }
+
+  std::string l_path = "test_vectored.bin";
+  int l_fd = open( l_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  REQUIRE( l_fd >= 0 );
+  REQUIRE( tsunami_lab::io::Vectored::transfer( l_fd, l_iov, true ) );
+  close( l_fd );
+
+  // read back in vectors of 3 bytes and the remainder
+  std::vector< std::uint8_t > l_dataRead( l_data.size(), 0 );
+  l_iov.clear();
+  for( l_offset = 0; l_offset < l_dataRead.size(); l_offset += 3 ) {
+    std::size_t l_size = std::min< std::size_t >( 3, l_dataRead.size() - l_offset );
+    l_iov.push_back( { l_dataRead.data() + l_offset, l_size } );
+  }
+
+  l_fd = open( l_path.c_str(), O_RDONLY );
+  REQUIRE( l_fd >= 0 );
+  REQUIRE( tsunami_lab::io::Vectored::transfer( l_fd, l_iov, false ) );
+  REQUIRE( l_dataRead == l_data );
+
+  // reading beyond the end of the file fails
+  std::uint8_t l_byte = 0;
+  l_iov = { { &l_byte, 1 } };
+  REQUIRE( !tsunami_lab::io::Vectored::transfer( l_fd, l_iov, false ) );
+  close( l_fd );
+
+  std::remove( l_path.c_str() );
+}
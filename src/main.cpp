@@ -5,13 +5,118 @@
  * Entry-point for simulations.
  **/
 #include "patches/WavePropagation1d.h"
+#include "patches/WavePropagation2d.h"
+#include "patches/WavePropagationAmr1d.h"
+#include "patches/WavePropagationCompact1d.h"
+#include "patches/WavePropagationWrapper.h"
+#include "solvers/Roe.h"
+#include "solvers/FWave.h"
+#include "solvers/Hll.h"
 #include "setups/DamBreak1d.h"
-#include "io/Csv.h"
+#include "io/AsyncWriter.h"
+#include "io/Stations.h"
+#include "instrumentation/Profiler.h"
 #include <cstdlib>
 #include <iostream>
 #include <cmath>
 #include <fstream>
-#include <limits>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+  /**
+   * Constructs a patch which uses the given Riemann solver.
+   *
+   * @tparam T_solver Riemann solver, templated on the floating point type.
+   * @param i_nx number of cells in x-direction.
+   * @param i_ny number of cells in y-direction; a one-dimensional patch is constructed if 1.
+   * @param i_nLevels number of levels of the adaptive mesh refinement; only supported in one dimension.
+   * @param i_nTimeLevels number of time levels of the local time stepping; only supported by one-dimensional patches without refinement.
+   * @param i_hugePages true if the fields should be backed by transparent huge pages.
+   * @param i_compact true if the one-dimensional patch with single precision storage and double precision computations is constructed.
+   * @return patch behind the type-erased interface.
+   **/
+  template< template< typename > class T_solver >
+  tsunami_lab::patches::WavePropagation * constructPatch( tsunami_lab::t_idx i_nx,
+                                                          tsunami_lab::t_idx i_ny,
+                                                          unsigned short     i_nLevels,
+                                                          unsigned short     i_nTimeLevels,
+                                                          bool               i_hugePages,
+                                                          bool               i_compact ) {
+    typedef T_solver< tsunami_lab::t_real > t_solver;
+
+    if( i_compact ) {
+      typedef tsunami_lab::patches::WavePropagationCompact1d< double, T_solver< double > > t_patch;
+      return new tsunami_lab::patches::WavePropagationWrapper< t_patch >( i_nx );
+    }
+    else if( i_nLevels > 1 ) {
+      typedef tsunami_lab::patches::WavePropagationAmr1d< tsunami_lab::t_real, t_solver > t_patch;
+      return new tsunami_lab::patches::WavePropagationWrapper< t_patch >( i_nx,
+                                                                          i_nLevels );
+    }
+    else if( i_ny == 1 ) {
+      typedef tsunami_lab::patches::WavePropagation1d< tsunami_lab::t_real, t_solver > t_patch;
+      tsunami_lab::patches::WavePropagationWrapper< t_patch > * l_wrapper = new tsunami_lab::patches::WavePropagationWrapper< t_patch >( i_nx,
+                                                                                                                                         i_hugePages );
+      l_wrapper->getPatch().setNumTimeLevels( i_nTimeLevels );
+      return l_wrapper;
+    }
+    else {
+      typedef tsunami_lab::patches::WavePropagation2d< tsunami_lab::t_real, t_solver > t_patch;
+      return new tsunami_lab::patches::WavePropagationWrapper< t_patch >( i_nx,
+                                                                          i_ny,
+                                                                          i_hugePages );
+    }
+  }
+
+  /**
+   * Samples the quantities at the stations.
+   * Patches with refined data are sampled at the resolution of their finest data, which is gathered at the stations' cells only.
+   *
+   * @param io_waveProp patch.
+   * @param io_stations stations, registered at the resolution of the patch's finest data.
+   * @param i_timeStep time step counter.
+   * @param i_time simulation time.
+   * @param io_hFine buffer of the finest water heights; has to hold all cells if the patch is refined.
+   * @param io_huFine buffer of the finest momenta in x-direction; has to hold all cells if the patch is refined.
+   * @param i_force true if the quantities are sampled regardless of the interval.
+   * @return true if successful, false otherwise.
+   **/
+  bool sampleStations( tsunami_lab::patches::WavePropagation & io_waveProp,
+                       tsunami_lab::io::Stations             & io_stations,
+                       tsunami_lab::t_idx                      i_timeStep,
+                       tsunami_lab::t_real                     i_time,
+                       std::vector< tsunami_lab::t_real >    & io_hFine,
+                       std::vector< tsunami_lab::t_real >    & io_huFine,
+                       bool                                    i_force = false ) {
+    if( io_waveProp.getRefinement() == 1 ) {
+      return io_stations.sample( i_timeStep,
+                                 i_time,
+                                 io_waveProp.getStride(),
+                                 io_waveProp.getHeight(),
+                                 io_waveProp.getMomentumX(),
+                                 io_waveProp.getMomentumY(),
+                                 i_force );
+    }
+
+    for( tsunami_lab::t_idx l_st = 0; l_st < io_stations.getNumStations(); l_st++ ) {
+      tsunami_lab::t_idx l_ix = io_stations.getCellX( l_st );
+      io_waveProp.getFinest( l_ix,
+                             1,
+                             io_hFine.data() + l_ix,
+                             io_huFine.data() + l_ix );
+    }
+    return io_stations.sample( i_timeStep,
+                               i_time,
+                               io_hFine.size(),
+                               io_hFine.data(),
+                               io_huFine.data(),
+                               nullptr,
+                               i_force );
+  }
+}
 
 int main( int   i_argc,
           char *i_argv[] ) {
@@ -28,78 +133,262 @@ int main( int   i_argc,
   std::cout << "### https://scalable.uni-jena.de ###" << std::endl;
   std::cout << "####################################" << std::endl;
 
-  if( i_argc != 2 ) {
-    std::cerr << "invalid number of arguments, usage:" << std::endl;
-    std::cerr << "  ./build/tsunami_lab N_CELLS_X" << std::endl;
-    std::cerr << "where N_CELLS_X is the number of cells in x-direction." << std::endl;
+  // output format of the snapshots
+  std::string l_outFormat = "csv";
+
+  // path of the checkpoint which is written; empty if disabled
+  std::string l_checkpointPath = "";
+
+  // path of the checkpoint from which the simulation is restarted; empty if disabled
+  std::string l_restartPath = "";
+
+  // true if the fields of the patch should be backed by transparent huge pages
+  bool l_hugePages = false;
+
+  // path of the machine-readable instrumentation report; empty if disabled
+  std::string l_reportPath = "";
+
+  // true if the instrumentation should read hardware counters
+  bool l_counters = false;
+
+  // Riemann solver
+  std::string l_solver = "roe";
+
+  // number of levels of the adaptive mesh refinement; 1 disables the refinement
+  int l_nLevels = 1;
+
+  // number of time levels of the local time stepping; 1 disables the local time stepping
+  int l_nTimeLevels = 1;
+
+  // path of the list of stations whose time series are written; empty if disabled
+  std::string l_stationsPath = "";
+
+  // sampling interval of the stations in time steps
+  int l_stationsInterval = 1;
+
+  // storage of the one-dimensional patch: full or compact
+  std::string l_storage = "full";
+
+  // parse options
+  bool l_argsValid = true;
+  int l_opt = 0;
+  while( (l_opt = getopt( i_argc, i_argv, "o:c:r:Hp:es:a:l:g:i:m:" )) != -1 ) {
+    if( l_opt == 'o' ) {
+      l_outFormat = optarg;
+    }
+    else if( l_opt == 'c' ) {
+      l_checkpointPath = optarg;
+    }
+    else if( l_opt == 'r' ) {
+      l_restartPath = optarg;
+    }
+    else if( l_opt == 'H' ) {
+      l_hugePages = true;
+    }
+    else if( l_opt == 'p' ) {
+      l_reportPath = optarg;
+    }
+    else if( l_opt == 'e' ) {
+      l_counters = true;
+    }
+    else if( l_opt == 's' ) {
+      l_solver = optarg;
+    }
+    else if( l_opt == 'a' ) {
+      l_nLevels = atoi( optarg );
+    }
+    else if( l_opt == 'l' ) {
+      l_nTimeLevels = atoi( optarg );
+    }
+    else if( l_opt == 'g' ) {
+      l_stationsPath = optarg;
+    }
+    else if( l_opt == 'i' ) {
+      l_stationsInterval = atoi( optarg );
+    }
+    else if( l_opt == 'm' ) {
+      l_storage = optarg;
+    }
+    else {
+      l_argsValid = false;
+    }
+  }
+  if( l_outFormat != "csv" && l_outFormat != "binary" && l_outFormat != "compressed" ) {
+    l_argsValid = false;
+  }
+  if( l_solver != "roe" && l_solver != "fwave" && l_solver != "hll" ) {
+    l_argsValid = false;
+  }
+  if( l_nLevels < 1 || l_nLevels > 16 ) {
+    l_argsValid = false;
+  }
+  if( l_nTimeLevels < 1 || l_nTimeLevels > 16 ) {
+    l_argsValid = false;
+  }
+  if( l_stationsInterval < 1 ) {
+    l_argsValid = false;
+  }
+  if( l_storage != "full" && l_storage != "compact" ) {
+    l_argsValid = false;
+  }
+
+  int l_nArgs = i_argc - optind;
+  if( !l_argsValid || (l_nArgs != 1 && l_nArgs != 2) ) {
+    std::cerr << "invalid arguments, usage:" << std::endl;
+    std::cerr << "  ./build/tsunami_lab [-o FORMAT] [-c CHECKPOINT] [-r RESTART] [-H] [-p REPORT] [-e] [-s SOLVER] [-a LEVELS] [-l TIME_LEVELS] [-g STATIONS] [-i INTERVAL] [-m STORAGE] N_CELLS_X [N_CELLS_Y]" << std::endl;
+    std::cerr << "where N_CELLS_X is the number of cells in x-direction" << std::endl;
+    std::cerr << "and the optional N_CELLS_Y is the number of cells in y-direction (default: 1)." << std::endl;
+    std::cerr << "FORMAT is the output format of the snapshots: csv (default), binary or compressed (lossless)." << std::endl;
+    std::cerr << "CHECKPOINT is a file which is overwritten with a checkpoint whenever a snapshot is written." << std::endl;
+    std::cerr << "RESTART is a checkpoint from which the simulation is continued." << std::endl;
+    std::cerr << "-H backs the fields by transparent huge pages." << std::endl;
+    std::cerr << "REPORT is a JSON file to which the timings of the program's phases are written at exit." << std::endl;
+    std::cerr << "-e adds hardware counters (cycles, instructions, LLC misses) to the timings." << std::endl;
+    std::cerr << "SOLVER is the Riemann solver: roe (default), fwave or hll; fwave and hll take the bathymetry into account." << std::endl;
+    std::cerr << "LEVELS is the number of levels of the adaptive mesh refinement (default: 1, i.e., none); one-dimensional only." << std::endl;
+    std::cerr << "  The snapshots solution_N hold the averages at the resolution of N_CELLS_X, the snapshots solution_N_fine and the stations the finest data." << std::endl;
+    std::cerr << "TIME_LEVELS is the number of time levels of the local time stepping (default: 1, i.e., none); one-dimensional only, without refinement." << std::endl;
+    std::cerr << "STATIONS is a file with lines name,x,y; the time series at these points are written to stations.csv." << std::endl;
+    std::cerr << "INTERVAL is the sampling interval of the stations in time steps (default: 1)." << std::endl;
+    std::cerr << "STORAGE is the storage of the quantities: full (default) or compact, i.e., single precision with double precision computations; one-dimensional only, without refinement and local time stepping." << std::endl;
     return EXIT_FAILURE;
   }
   else {
-    l_nx = atoi( i_argv[1] );
-    if( l_nx < 1 ) {
+    l_nx = atoi( i_argv[optind] );
+    if( l_nArgs == 2 ) {
+      l_ny = atoi( i_argv[optind+1] );
+    }
+    if( l_nx < 1 || l_ny < 1 ) {
       std::cerr << "invalid number of cells" << std::endl;
       return EXIT_FAILURE;
     }
+    if( l_nLevels > 1 && l_ny > 1 ) {
+      std::cerr << "the adaptive mesh refinement is only supported in one dimension" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if( l_nTimeLevels > 1 && ( l_ny > 1 || l_nLevels > 1 ) ) {
+      std::cerr << "the local time stepping is only supported in one dimension without refinement" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if( l_storage == "compact" && ( l_ny > 1 || l_nLevels > 1 || l_nTimeLevels > 1 || l_hugePages ) ) {
+      std::cerr << "the compact storage is only supported in one dimension without refinement, local time stepping and huge pages" << std::endl;
+      return EXIT_FAILURE;
+    }
     l_dxy = 10.0 / l_nx;
   }
   std::cout << "runtime configuration" << std::endl;
   std::cout << "  number of cells in x-direction: " << l_nx << std::endl;
   std::cout << "  number of cells in y-direction: " << l_ny << std::endl;
   std::cout << "  cell size:                      " << l_dxy << std::endl;
+  std::cout << "  output format:                  " << l_outFormat << std::endl;
+  std::cout << "  Riemann solver:                 " << l_solver << std::endl;
+  std::cout << "  number of refinement levels:    " << l_nLevels << std::endl;
+  std::cout << "  number of time levels:          " << l_nTimeLevels << std::endl;
+  std::cout << "  storage:                        " << l_storage << std::endl;
+  if( l_stationsPath != "" ) {
+    std::cout << "  stations:                       " << l_stationsPath << std::endl;
+    std::cout << "  sampling interval of stations:  " << l_stationsInterval << std::endl;
+  }
 
-  // construct setup
-  tsunami_lab::setups::Setup *l_setup;
-  l_setup = new tsunami_lab::setups::DamBreak1d( 10,
-                                                 5,
-                                                 5 );
-  // construct solver
-  tsunami_lab::patches::WavePropagation *l_waveProp;
-  l_waveProp = new tsunami_lab::patches::WavePropagation1d( l_nx );
+  // instrumentation of the program's phases; constructed first to cover all threads
+  tsunami_lab::instrumentation::Profiler l_profiler( l_counters );
+  tsunami_lab::t_idx l_regInit = l_profiler.addRegion( "init" );
+  tsunami_lab::t_idx l_regOutput = l_profiler.addRegion( "output" );
+  tsunami_lab::t_idx l_regGhost = l_profiler.addRegion( "setGhostOutflow" );
+  tsunami_lab::t_idx l_regTimeStep = l_profiler.addRegion( "timeStep" );
+  tsunami_lab::t_idx l_regStations = l_profiler.addRegion( "stations" );
 
-  // maximum observed height in the setup
-  tsunami_lab::t_real l_hMax = std::numeric_limits< tsunami_lab::t_real >::lowest();
+  tsunami_lab::setups::Setup *l_setup = nullptr;
+  tsunami_lab::patches::WavePropagation *l_waveProp = nullptr;
+  tsunami_lab::io::Stations *l_stations = nullptr;
 
-  // set up solver
-  for( tsunami_lab::t_idx l_cy = 0; l_cy < l_ny; l_cy++ ) {
-    tsunami_lab::t_real l_y = l_cy * l_dxy; 
+  // maximum wave speed in the setup
+  tsunami_lab::t_real l_speedMax = 0;
 
-    for( tsunami_lab::t_idx l_cx = 0; l_cx < l_nx; l_cx++ ) {
-      tsunami_lab::t_real l_x = l_cx * l_dxy; 
+  // refinement factor of the finest data; the finest data of refined patches is gathered into the buffers for the output
+  tsunami_lab::t_idx l_refinement = 1;
+  std::vector< tsunami_lab::t_real > l_hFine;
+  std::vector< tsunami_lab::t_real > l_huFine;
 
-      // get initial values of the setup
-      tsunami_lab::t_real l_h = l_setup->getHeight( l_x,
-                                                    l_y );
-      l_hMax = std::max( l_h, l_hMax );
+  {
+    tsunami_lab::instrumentation::Profiler::Scope l_scope( l_profiler,
+                                                           l_regInit );
 
-      tsunami_lab::t_real l_hu = l_setup->getMomentumX( l_x,
-                                                        l_y );
-      tsunami_lab::t_real l_hv = l_setup->getMomentumY( l_x,
-                                                        l_y );
+    // construct setup
+    l_setup = new tsunami_lab::setups::DamBreak1d( 10,
+                                                   5,
+                                                   5 );
+    // construct solver
+    if( l_solver == "fwave" ) {
+      l_waveProp = constructPatch< tsunami_lab::solvers::FWave >( l_nx,
+                                                                  l_ny,
+                                                                  l_nLevels,
+                                                                  l_nTimeLevels,
+                                                                  l_hugePages,
+                                                                  l_storage == "compact" );
+    }
+    else if( l_solver == "hll" ) {
+      l_waveProp = constructPatch< tsunami_lab::solvers::Hll >( l_nx,
+                                                                l_ny,
+                                                                l_nLevels,
+                                                                l_nTimeLevels,
+                                                                l_hugePages,
+                                                                l_storage == "compact" );
+    }
+    else {
+      l_waveProp = constructPatch< tsunami_lab::solvers::Roe >( l_nx,
+                                                                l_ny,
+                                                                l_nLevels,
+                                                                l_nTimeLevels,
+                                                                l_hugePages,
+                                                                l_storage == "compact" );
+    }
 
-      // set initial values in wave propagation solver
-      l_waveProp->setHeight( l_cx,
-                             l_cy,
-                             l_h );
+    l_refinement = l_waveProp->getRefinement();
+    if( l_refinement > 1 ) {
+      l_hFine.resize( l_nx * l_refinement );
+      l_huFine.resize( l_nx * l_refinement );
+    }
 
-      l_waveProp->setMomentumX( l_cx,
-                                l_cy,
-                                l_hu );
+    // set up solver in blocks of rows, which bounds the size of the temporary arrays
+    tsunami_lab::t_idx l_blockX = std::min< tsunami_lab::t_idx >( l_nx, 65536 );
+    tsunami_lab::t_idx l_blockY = std::max< tsunami_lab::t_idx >( 1, 65536 / l_blockX );
+    std::vector< tsunami_lab::t_real > l_hInit(  l_blockX * l_blockY );
+    std::vector< tsunami_lab::t_real > l_huInit( l_blockX * l_blockY );
+    std::vector< tsunami_lab::t_real > l_hvInit( l_blockX * l_blockY );
+    std::vector< tsunami_lab::t_real > l_bInit(  l_blockX * l_blockY );
 
-      l_waveProp->setMomentumY( l_cx,
-                                l_cy,
-                                l_hv );
+    for( tsunami_lab::t_idx l_by = 0; l_by < l_ny; l_by += l_blockY ) {
+      tsunami_lab::t_idx l_nyBlock = std::min( l_blockY, l_ny - l_by );
 
-    }
-  }
-
-  // derive maximum wave speed in setup; the momentum is ignored
-  tsunami_lab::t_real l_speedMax = std::sqrt( 9.81 * l_hMax );
+      for( tsunami_lab::t_idx l_bx = 0; l_bx < l_nx; l_bx += l_blockX ) {
+        tsunami_lab::t_idx l_nxBlock = std::min( l_blockX, l_nx - l_bx );
 
-  // derive constant time step; changes at simulation time are ignored
-  tsunami_lab::t_real l_dt = 0.5 * l_dxy / l_speedMax;
+        // get initial values of the setup
+        l_setup->getValues( l_dxy,
+                            l_bx,
+                            l_by,
+                            l_nxBlock,
+                            l_nyBlock,
+                            l_blockX,
+                            l_hInit.data(),
+                            l_huInit.data(),
+                            l_hvInit.data(),
+                            l_bInit.data() );
 
-  // derive scaling for a time step
-  tsunami_lab::t_real l_scaling = l_dt / l_dxy;
+        // set initial values in wave propagation solver
+        l_waveProp->setValues( l_bx,
+                               l_by,
+                               l_nxBlock,
+                               l_nyBlock,
+                               l_blockX,
+                               l_hInit.data(),
+                               l_huInit.data(),
+                               l_hvInit.data(),
+                               l_bInit.data() );
+      }
+    }
+  }
 
   // set up time and print control
   tsunami_lab::t_idx  l_timeStep = 0;
@@ -107,45 +396,223 @@ int main( int   i_argc,
   tsunami_lab::t_real l_endTime = 1.25;
   tsunami_lab::t_real l_simTime = 0;
 
+  {
+    tsunami_lab::instrumentation::Profiler::Scope l_scope( l_profiler,
+                                                           l_regInit );
+
+    // restore the state of an earlier run
+    if( l_restartPath != "" ) {
+      std::cout << "restarting from " << l_restartPath << std::endl;
+      if( !l_waveProp->readCheckpoint( l_restartPath,
+                                       l_simTime,
+                                       l_timeStep,
+                                       l_speedMax ) ) {
+        std::cerr << "failed to read checkpoint " << l_restartPath << std::endl;
+        return EXIT_FAILURE;
+      }
+      std::cout << "  simulation time / #time steps: "
+                << l_simTime << " / " << l_timeStep << std::endl;
+
+      // number of snapshots which were written before the checkpoint's time step
+      l_nOut = (l_timeStep + 24) / 25;
+    }
+    else {
+      // derive maximum wave speed of the initial state: particle velocity plus gravity wave speed;
+      // a restart continues with the speed stored in the checkpoint instead, which reproduces the time steps of an uninterrupted run
+      for( tsunami_lab::t_idx l_cy = 0; l_cy < l_ny; l_cy++ ) {
+        for( tsunami_lab::t_idx l_cx = 0; l_cx < l_nx; l_cx++ ) {
+          tsunami_lab::t_idx l_id = l_cy * l_waveProp->getStride() + l_cx;
+
+          tsunami_lab::t_real l_h = l_waveProp->getHeight()[l_id];
+          tsunami_lab::t_real l_hu = l_waveProp->getMomentumX()[l_id];
+          tsunami_lab::t_real l_hv = 0;
+          if( l_waveProp->getMomentumY() != nullptr ) {
+            l_hv = l_waveProp->getMomentumY()[l_id];
+          }
+
+          if( l_h > 0 ) {
+            tsunami_lab::t_real l_speed  = std::max( std::abs( l_hu ), std::abs( l_hv ) ) / l_h;
+                                l_speed += std::sqrt( 9.81 * l_h );
+            l_speedMax = std::max( l_speed, l_speedMax );
+          }
+        }
+      }
+    }
+
+    // register the stations
+    if( l_stationsPath != "" ) {
+      // a restart continues the time series of the earlier run
+      l_stations = new tsunami_lab::io::Stations( "stations.csv",
+                                                  l_dxy / l_refinement,
+                                                  l_nx * l_refinement,
+                                                  l_ny,
+                                                  l_stationsInterval,
+                                                  4096,
+                                                  (l_restartPath != "") ? l_simTime : -1 );
+
+      std::ifstream l_list( l_stationsPath );
+      if( !l_list.is_open() || !l_stations->addStations( l_list ) || !l_stations->isValid() ) {
+        std::cerr << "failed to set up the stations of " << l_stationsPath << std::endl;
+        return EXIT_FAILURE;
+      }
+      std::cout << "  registered " << l_stations->getNumStations() << " station(s)" << std::endl;
+    }
+  }
+
+  // CFL number used to derive the time steps from the maximum wave speed
+  tsunami_lab::t_real l_cfl = 0.5;
+
+  // derive initial time step; later time steps adapt to the wave speeds of the previous step
+  tsunami_lab::t_real l_dt = l_cfl * l_dxy / l_speedMax;
+
+  // background writer of the snapshots, double-buffered
+  tsunami_lab::io::AsyncWriter l_writer( 2 );
+
   std::cout << "entering time loop" << std::endl;
 
   // iterate over time
   while( l_simTime < l_endTime ){
+    if( l_stations != nullptr ) {
+      tsunami_lab::instrumentation::Profiler::Scope l_scope( l_profiler,
+                                                             l_regStations );
+      if( !sampleStations( *l_waveProp,
+                           *l_stations,
+                           l_timeStep,
+                           l_simTime,
+                           l_hFine,
+                           l_huFine ) ) {
+        std::cerr << "  failed to write the time series of the stations" << std::endl;
+      }
+    }
+
     if( l_timeStep % 25 == 0 ) {
+      tsunami_lab::instrumentation::Profiler::Scope l_scope( l_profiler,
+                                                             l_regOutput );
+
       std::cout << "  simulation time / #time steps: "
                 << l_simTime << " / " << l_timeStep << std::endl;
 
-      std::string l_path = "solution_" + std::to_string(l_nOut) + ".csv";
+      std::string l_path = "solution_" + std::to_string(l_nOut) + "." + l_outFormat;
       std::cout << "  writing wave field to " << l_path << std::endl;
 
-      std::ofstream l_file;
-      l_file.open( l_path  );
-
-      tsunami_lab::io::Csv::write( l_dxy,
-                                   l_nx,
-                                   1,
-                                   1,
-                                   l_waveProp->getHeight(),
-                                   l_waveProp->getMomentumX(),
-                                   nullptr,
-                                   l_file );
-      l_file.close();
+      l_writer.submit( l_path,
+                       l_outFormat,
+                       l_dxy,
+                       l_nx,
+                       l_ny,
+                       l_waveProp->getStride(),
+                       l_simTime,
+                       l_waveProp->getHeight(),
+                       l_waveProp->getMomentumX(),
+                       l_waveProp->getMomentumY() );
+
+      // refined patches also write their finest data
+      if( l_refinement > 1 ) {
+        l_waveProp->getFinest( 0,
+                               l_hFine.size(),
+                               l_hFine.data(),
+                               l_huFine.data() );
+
+        std::string l_pathFine = "solution_" + std::to_string(l_nOut) + "_fine." + l_outFormat;
+        std::cout << "  writing finest wave field to " << l_pathFine << std::endl;
+
+        l_writer.submit( l_pathFine,
+                         l_outFormat,
+                         l_dxy / l_refinement,
+                         l_hFine.size(),
+                         1,
+                         l_hFine.size(),
+                         l_simTime,
+                         l_hFine.data(),
+                         l_huFine.data(),
+                         nullptr );
+      }
       l_nOut++;
+
+      if( l_checkpointPath != "" ) {
+        std::cout << "  writing checkpoint to " << l_checkpointPath << std::endl;
+        if( !l_waveProp->writeCheckpoint( l_checkpointPath,
+                                          l_simTime,
+                                          l_timeStep,
+                                          l_speedMax ) ) {
+          std::cerr << "  failed to write checkpoint " << l_checkpointPath << std::endl;
+        }
+
+        // the time series on disk cover the checkpoint, which a restart continues
+        if( l_stations != nullptr && !l_stations->flush() ) {
+          std::cerr << "  failed to write the time series of the stations" << std::endl;
+        }
+      }
     }
 
-    l_waveProp->setGhostOutflow();
-    l_waveProp->timeStep( l_scaling );
+    {
+      tsunami_lab::instrumentation::Profiler::Scope l_scope( l_profiler,
+                                                             l_regGhost );
+      l_waveProp->setGhostOutflow();
+    }
+    {
+      tsunami_lab::instrumentation::Profiler::Scope l_scope( l_profiler,
+                                                             l_regTimeStep );
+      l_speedMax = l_waveProp->timeStep( l_dt / l_dxy );
+    }
 
     l_timeStep++;
     l_simTime += l_dt;
+
+    // adapt the time step to the maximum wave speed of the previous step
+    if( l_speedMax > 0 ) {
+      l_dt = l_cfl * l_dxy / l_speedMax;
+    }
   }
 
   std::cout << "finished time loop" << std::endl;
 
+  // sample the final state and write the buffered samples
+  if( l_stations != nullptr ) {
+    tsunami_lab::instrumentation::Profiler::Scope l_scope( l_profiler,
+                                                           l_regStations );
+    if(    !sampleStations( *l_waveProp,
+                            *l_stations,
+                            l_timeStep,
+                            l_simTime,
+                            l_hFine,
+                            l_huFine,
+                            true )
+        || !l_stations->flush() ) {
+      std::cerr << "failed to write the time series of the stations" << std::endl;
+    }
+  }
+
+  // wait for pending output
+  {
+    tsunami_lab::instrumentation::Profiler::Scope l_scope( l_profiler,
+                                                           l_regOutput );
+
+    tsunami_lab::t_idx l_nFailed = l_writer.flush();
+    if( l_nFailed > 0 ) {
+      std::cerr << "failed to write " << l_nFailed << " snapshot(s)" << std::endl;
+    }
+  }
+
+  // report the instrumentation
+  std::cout << "instrumentation summary" << std::endl;
+  l_profiler.writeTable( std::cout );
+
+  if( l_reportPath != "" ) {
+    std::ofstream l_report( l_reportPath );
+    l_profiler.writeJson( l_report );
+    l_report.close();
+
+    if( l_report.fail() ) {
+      std::cerr << "failed to write instrumentation report " << l_reportPath << std::endl;
+    }
+  }
+
   // free memory
   std::cout << "freeing memory" << std::endl;
   delete l_setup;
   delete l_waveProp;
+  delete l_stations;
 
   std::cout << "finished, exiting" << std::endl;
   return EXIT_SUCCESS;
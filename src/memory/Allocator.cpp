@@ -0,0 +1,40 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Allocation of aligned memory for the fields of patches.
+ **/
+#include "Allocator.h"
+#include <cstdlib>
+#include <new>
+#include <sys/mman.h>
+
+void * tsunami_lab::memory::Allocator::allocateBytes( t_idx i_nBytes,
+                                                      bool  i_hugePages ) {
+  t_idx l_nBytes = (i_nBytes > 0) ? i_nBytes : m_alignment;
+
+  // align to huge pages only if at least one huge page is covered
+  bool l_huge = i_hugePages && l_nBytes >= m_hugePageSize;
+  t_idx l_alignment = l_huge ? m_hugePageSize : m_alignment;
+
+  // round up to full huge pages, which keeps the tail from sharing a huge page with other data
+  if( l_huge ) {
+    l_nBytes = (l_nBytes + m_hugePageSize - 1) / m_hugePageSize * m_hugePageSize;
+  }
+
+  void * l_mem = nullptr;
+  if( posix_memalign( &l_mem, l_alignment, l_nBytes ) != 0 ) {
+    throw std::bad_alloc();
+  }
+
+#ifdef MADV_HUGEPAGE
+  // the advice has to precede the first touch; failures are ignored since huge pages are optional
+  if( l_huge ) madvise( l_mem, l_nBytes, MADV_HUGEPAGE );
+#endif
+
+  return l_mem;
+}
+
+void tsunami_lab::memory::Allocator::free( void * io_values ) {
+  std::free( io_values );
+}
@@ -0,0 +1,69 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Allocation of aligned memory for the fields of patches.
+ **/
+#ifndef TSUNAMI_LAB_MEMORY_ALLOCATOR
+#define TSUNAMI_LAB_MEMORY_ALLOCATOR
+
+#include "../constants.h"
+
+namespace tsunami_lab {
+  namespace memory {
+    class Allocator;
+  }
+}
+
+/**
+ * Allocates field arrays aligned to cache lines, optionally backed by transparent huge pages.
+ *
+ * The memory is not initialized.
+ * Physical pages are placed on the NUMA node of the thread which touches them first.
+ * Thus, the fields should be initialized in parallel with the same thread decomposition as the computations.
+ **/
+class tsunami_lab::memory::Allocator {
+  public:
+    //! alignment of all allocations in bytes
+    static t_idx constexpr m_alignment = 64;
+
+    //! size of a huge page in bytes
+    static t_idx constexpr m_hugePageSize = 2 * 1024 * 1024;
+
+    /**
+     * Allocates raw memory.
+     * If huge pages are requested, allocations of at least one huge page are aligned to huge pages and advised to the kernel as such.
+     * The advice is a hint only: the allocation succeeds if transparent huge pages are unavailable.
+     *
+     * @param i_nBytes number of bytes.
+     * @param i_hugePages true if transparent huge pages are requested.
+     * @return aligned memory; throws std::bad_alloc on failure.
+     **/
+    static void * allocateBytes( t_idx i_nBytes,
+                                 bool  i_hugePages = false );
+
+    /**
+     * Allocates an array of values.
+     *
+     * @param i_nValues number of values.
+     * @param i_hugePages true if transparent huge pages are requested.
+     * @return aligned array; throws std::bad_alloc on failure.
+     *
+     * @tparam T_value type of the values.
+     **/
+    template< typename T_value = t_real >
+    static T_value * allocate( t_idx i_nValues,
+                               bool  i_hugePages = false ) {
+      return static_cast< T_value * >( allocateBytes( i_nValues * sizeof(T_value),
+                                                      i_hugePages ) );
+    }
+
+    /**
+     * Frees memory allocated through allocate or allocateBytes.
+     *
+     * @param io_values memory which is freed; nullptr is ignored.
+     **/
+    static void free( void * io_values );
+};
+
+#endif
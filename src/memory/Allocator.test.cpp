@@ -0,0 +1,39 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the allocation of aligned memory.
+ **/
+#include <catch2/catch.hpp>
+#include "Allocator.h"
+#include <cstdint>
+
+TEST_CASE( "Test the allocation of aligned memory.", "[Allocator]" ) {
+  for( tsunami_lab::t_idx l_nValues : { 0, 1, 7, 1000, 1024 * 1024 } ) {
+    for( bool l_hugePages : { false, true } ) {
+      tsunami_lab::t_real * l_values = tsunami_lab::memory::Allocator::allocate( l_nValues,
+                                                                                 l_hugePages );
+
+      REQUIRE( l_values != nullptr );
+      REQUIRE( reinterpret_cast< std::uintptr_t >( l_values ) % tsunami_lab::memory::Allocator::m_alignment == 0 );
+
+      // the memory is usable
+      for( tsunami_lab::t_idx l_va = 0; l_va < l_nValues; l_va++ ) {
+        l_values[l_va] = l_va;
+      }
+      if( l_nValues > 0 ) {
+        REQUIRE( l_values[l_nValues-1] == tsunami_lab::t_real(l_nValues-1) );
+      }
+
+      tsunami_lab::memory::Allocator::free( l_values );
+    }
+  }
+
+  // huge page alignment of large arrays
+  tsunami_lab::t_real * l_values = tsunami_lab::memory::Allocator::allocate( 1024 * 1024,
+                                                                             true );
+  REQUIRE( reinterpret_cast< std::uintptr_t >( l_values ) % tsunami_lab::memory::Allocator::m_hugePageSize == 0 );
+  tsunami_lab::memory::Allocator::free( l_values );
+
+  tsunami_lab::memory::Allocator::free( nullptr );
+}
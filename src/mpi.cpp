@@ -0,0 +1,237 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Entry-point for domain-decomposed one-dimensional simulations using MPI.
+ **/
+#include "patches/WavePropagation1d.h"
+#include "setups/DamBreak1d.h"
+#include "io/AsyncWriter.h"
+// C API only; the deprecated C++ bindings do not compile without warnings
+#define OMPI_SKIP_MPICXX 1
+#define MPICH_SKIP_MPICXX 1
+#include <mpi.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+
+int main( int   i_argc,
+          char *i_argv[] ) {
+  int l_provided = 0;
+  MPI_Init_thread( &i_argc,
+                   &i_argv,
+                   MPI_THREAD_FUNNELED,
+                   &l_provided );
+
+  int l_rank = 0;
+  int l_nRanks = 1;
+  MPI_Comm_rank( MPI_COMM_WORLD, &l_rank );
+  MPI_Comm_size( MPI_COMM_WORLD, &l_nRanks );
+
+  // only the main thread calls MPI; the solver's OpenMP threads and the writer threads do not
+  if( l_provided < MPI_THREAD_FUNNELED ) {
+    if( l_rank == 0 ) {
+      std::cerr << "the MPI library does not support MPI_THREAD_FUNNELED" << std::endl;
+    }
+    MPI_Finalize();
+    return EXIT_FAILURE;
+  }
+
+  MPI_Datatype l_typeReal = std::is_same< tsunami_lab::t_real, float >::value ? MPI_FLOAT : MPI_DOUBLE;
+
+  // number of cells of the global domain
+  tsunami_lab::t_idx l_nx = 0;
+
+  // output format of the snapshots; empty if disabled
+  std::string l_outFormat = "csv";
+
+  // parse options
+  bool l_argsValid = true;
+  int l_opt = 0;
+  while( (l_opt = getopt( i_argc, i_argv, "o:" )) != -1 ) {
+    if( l_opt == 'o' ) {
+      l_outFormat = optarg;
+      if( l_outFormat == "none" ) l_outFormat = "";
+    }
+    else {
+      l_argsValid = false;
+    }
+  }
+  if( l_argsValid && i_argc - optind == 1 ) {
+    l_nx = std::strtoull( i_argv[optind], nullptr, 10 );
+  }
+
+  if( !l_argsValid || l_nx < tsunami_lab::t_idx( l_nRanks ) ) {
+    if( l_rank == 0 ) {
+      std::cerr << "invalid arguments, usage:" << std::endl;
+      std::cerr << "  mpirun -n N_RANKS ./build/tsunami_lab_mpi [-o FORMAT] N_CELLS_X" << std::endl;
+      std::cerr << "where N_CELLS_X is the number of cells in x-direction, which has to be at least N_RANKS." << std::endl;
+      std::cerr << "FORMAT is the output format of the snapshots: csv (default), binary, compressed (lossless) or none." << std::endl;
+      std::cerr << "Every rank writes its subdomain to solution_<SNAPSHOT>_<RANK>.<FORMAT>; the ranks' cells are consecutive." << std::endl;
+    }
+    MPI_Finalize();
+    return EXIT_FAILURE;
+  }
+  tsunami_lab::t_real l_dxy = 10.0 / l_nx;
+
+  // contiguous subdomains of (almost) equal size; the rank owns cells l_first to l_first+l_nxLocal-1
+  tsunami_lab::t_idx l_first = l_nx * l_rank / l_nRanks;
+  tsunami_lab::t_idx l_nxLocal = l_nx * (l_rank+1) / l_nRanks - l_first;
+
+  // neighboring ranks; the global boundaries have none
+  int l_rankL = (l_rank > 0) ? l_rank-1 : MPI_PROC_NULL;
+  int l_rankR = (l_rank < l_nRanks-1) ? l_rank+1 : MPI_PROC_NULL;
+
+  if( l_rank == 0 ) {
+    std::cout << "runtime configuration" << std::endl;
+    std::cout << "  number of cells in x-direction: " << l_nx << std::endl;
+    std::cout << "  cell size:                      " << l_dxy << std::endl;
+    std::cout << "  number of ranks:                " << l_nRanks << std::endl;
+    std::cout << "  output format:                  " << ( l_outFormat == "" ? "none" : l_outFormat ) << std::endl;
+  }
+
+  // construct setup and the rank's patch
+  tsunami_lab::setups::DamBreak1d l_setup( 10,
+                                           5,
+                                           5 );
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp( l_nxLocal );
+  {
+    std::vector< tsunami_lab::t_real > l_h( l_nxLocal );
+    std::vector< tsunami_lab::t_real > l_hu( l_nxLocal );
+    l_setup.getValues( l_dxy,
+                       l_first,
+                       0,
+                       l_nxLocal,
+                       1,
+                       l_nxLocal,
+                       l_h.data(),
+                       l_hu.data(),
+                       nullptr,
+                       nullptr );
+    l_waveProp.setValues( 0,
+                          0,
+                          l_nxLocal,
+                          1,
+                          l_nxLocal,
+                          l_h.data(),
+                          l_hu.data(),
+                          nullptr,
+                          nullptr );
+  }
+
+  // derive maximum wave speed of the initial state: particle velocity plus gravity wave speed
+  tsunami_lab::t_real l_speedMax = 0;
+  for( tsunami_lab::t_idx l_cx = 0; l_cx < l_nxLocal; l_cx++ ) {
+    tsunami_lab::t_real l_h = l_waveProp.getHeight()[l_cx];
+    tsunami_lab::t_real l_hu = l_waveProp.getMomentumX()[l_cx];
+
+    if( l_h > 0 ) {
+      tsunami_lab::t_real l_speed  = std::abs( l_hu ) / l_h;
+                          l_speed += std::sqrt( 9.81 * l_h );
+      l_speedMax = std::max( l_speed, l_speedMax );
+    }
+  }
+  MPI_Allreduce( MPI_IN_PLACE, &l_speedMax, 1, l_typeReal, MPI_MAX, MPI_COMM_WORLD );
+
+  // set up time and print control
+  tsunami_lab::t_idx  l_timeStep = 0;
+  tsunami_lab::t_idx  l_nOut = 0;
+  tsunami_lab::t_real l_endTime = 1.25;
+  tsunami_lab::t_real l_simTime = 0;
+  tsunami_lab::t_real l_cfl = 0.5;
+  tsunami_lab::t_real l_dt = l_cfl * l_dxy / l_speedMax;
+
+  // every rank writes its subdomain in the background; no rank holds the global domain
+  tsunami_lab::io::AsyncWriter l_writer( 2 );
+
+  // ghost cells are either received from the neighbors or follow outflow conditions at the global boundaries
+  l_waveProp.setGhostOutflow();
+
+  double l_timeStart = MPI_Wtime();
+  double l_timeWait = 0;
+
+  if( l_rank == 0 ) std::cout << "entering time loop" << std::endl;
+
+  while( l_simTime < l_endTime ) {
+    if( l_timeStep % 25 == 0 && l_outFormat != "" ) {
+      if( l_rank == 0 ) {
+        std::cout << "  simulation time / #time steps: "
+                  << l_simTime << " / " << l_timeStep << std::endl;
+        std::cout << "  writing wave field to solution_" << l_nOut << "_*." << l_outFormat << std::endl;
+      }
+
+      std::string l_path = "solution_" + std::to_string(l_nOut) + "_" + std::to_string(l_rank) + "." + l_outFormat;
+      l_writer.submit( l_path,
+                       l_outFormat,
+                       l_dxy,
+                       l_nxLocal,
+                       1,
+                       l_nxLocal,
+                       l_simTime,
+                       l_waveProp.getHeight(),
+                       l_waveProp.getMomentumX(),
+                       nullptr,
+                       l_first );
+      l_nOut++;
+    }
+
+    // exchange the first and last cells with the neighbors; messages to the right carry tag 1, to the left tag 0
+    tsunami_lab::t_real l_sendL[2] = { l_waveProp.getHeight()[0], l_waveProp.getMomentumX()[0] };
+    tsunami_lab::t_real l_sendR[2] = { l_waveProp.getHeight()[l_nxLocal-1], l_waveProp.getMomentumX()[l_nxLocal-1] };
+    tsunami_lab::t_real l_recvL[2] = { 0, 0 };
+    tsunami_lab::t_real l_recvR[2] = { 0, 0 };
+
+    MPI_Request l_requests[4];
+    MPI_Irecv( l_recvL, 2, l_typeReal, l_rankL, 1, MPI_COMM_WORLD, l_requests+0 );
+    MPI_Irecv( l_recvR, 2, l_typeReal, l_rankR, 0, MPI_COMM_WORLD, l_requests+1 );
+    MPI_Isend( l_sendL, 2, l_typeReal, l_rankL, 0, MPI_COMM_WORLD, l_requests+2 );
+    MPI_Isend( l_sendR, 2, l_typeReal, l_rankR, 1, MPI_COMM_WORLD, l_requests+3 );
+
+    // update the interior while the halos are in flight
+    l_speedMax = l_waveProp.timeStepInterior( l_dt / l_dxy );
+
+    double l_timeWaitStart = MPI_Wtime();
+    MPI_Waitall( 4, l_requests, MPI_STATUSES_IGNORE );
+    l_timeWait += MPI_Wtime() - l_timeWaitStart;
+
+    if( l_rankL != MPI_PROC_NULL ) l_waveProp.setGhostCell( 0, l_recvL[0], l_recvL[1] );
+    if( l_rankR != MPI_PROC_NULL ) l_waveProp.setGhostCell( 1, l_recvR[0], l_recvR[1] );
+
+    l_speedMax = std::max( l_waveProp.timeStepBoundary( l_dt / l_dxy ), l_speedMax );
+    MPI_Allreduce( MPI_IN_PLACE, &l_speedMax, 1, l_typeReal, MPI_MAX, MPI_COMM_WORLD );
+
+    l_timeStep++;
+    l_simTime += l_dt;
+
+    // adapt the time step to the maximum wave speed of the previous step
+    if( l_speedMax > 0 ) {
+      l_dt = l_cfl * l_dxy / l_speedMax;
+    }
+  }
+
+  double l_time = MPI_Wtime() - l_timeStart;
+  MPI_Allreduce( MPI_IN_PLACE, &l_timeWait, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+
+  unsigned long long l_nFailed = l_writer.flush();
+  MPI_Allreduce( MPI_IN_PLACE, &l_nFailed, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
+
+  if( l_rank == 0 ) {
+    std::cout << "finished time loop" << std::endl;
+    std::cout << "  #time steps:                    " << l_timeStep << std::endl;
+    std::cout << "  time:                           " << l_time << " s" << std::endl;
+    std::cout << "  max. time waiting for halos:    " << l_timeWait << " s" << std::endl;
+
+    if( l_nFailed > 0 ) {
+      std::cerr << "failed to write " << l_nFailed << " snapshot(s)" << std::endl;
+    }
+    std::cout << "finished, exiting" << std::endl;
+  }
+
+  MPI_Finalize();
+  return EXIT_SUCCESS;
+}
@@ -2,12 +2,13 @@
  * @author Alexander Breuer (alex.breuer AT uni-jena.de)
  *
  * @section DESCRIPTION
- * Base class of the wave propagation patches.
+ * Type-erased interface of the wave propagation patches.
  **/
 #ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION
 #define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION
 
 #include "../constants.h"
+#include <string>
 
 namespace tsunami_lab {
   namespace patches {
@@ -15,6 +16,11 @@ namespace tsunami_lab {
   }
 }
 
+/**
+ * Runtime-polymorphic interface of the patches for the entry point.
+ * The patches themselves are templates without virtual functions; WavePropagationWrapper adapts them to this interface.
+ * Thus, virtual calls only happen per time step or per bulk operation, never inside the patches' loops.
+ **/
 class tsunami_lab::patches::WavePropagation {
   public:
     /**
@@ -26,8 +32,9 @@ class tsunami_lab::patches::WavePropagation {
      * Performs a time step.
      *
      * @param i_scaling scaling of the time step.
+     * @return maximum wave speed of the Riemann problems solved in the time step.
      **/
-    virtual void timeStep( t_real i_scaling ) = 0;
+    virtual t_real timeStep( t_real i_scaling ) = 0;
 
     /**
      * Sets the values of the ghost cells according to outflow boundary conditions.
@@ -62,6 +69,34 @@ class tsunami_lab::patches::WavePropagation {
      **/
     virtual t_real const * getMomentumY() = 0;
 
+    /**
+     * Gets the cells' bathymetry.
+     *
+     * @return bathymetry.
+     **/
+    virtual t_real const * getBathymetry() = 0;
+
+    /**
+     * Gets the refinement factor of the finest data w.r.t. the cells of the getters.
+     *
+     * @return refinement factor; 1 if the patch has a single resolution.
+     **/
+    virtual t_idx getRefinement() = 0;
+
+    /**
+     * Gets the water heights and momenta in x-direction of a range of cells at the resolution of the finest data.
+     * One-dimensional only: for patches with a single resolution, these are the values of the getters.
+     *
+     * @param i_first first cell in the index space of the finest data.
+     * @param i_nCells number of cells.
+     * @param o_h will be set to the water heights.
+     * @param o_hu will be set to the momenta in x-direction.
+     **/
+    virtual void getFinest( t_idx    i_first,
+                            t_idx    i_nCells,
+                            t_real * o_h,
+                            t_real * o_hu ) = 0;
+
     /**
      * Sets the height of the cell to the given value.
      *
@@ -94,6 +129,69 @@ class tsunami_lab::patches::WavePropagation {
     virtual void setMomentumY( t_idx  i_ix,
                                t_idx  i_iy,
                                t_real i_hv ) = 0;
+
+    /**
+     * Sets the bathymetry of the cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_b bathymetry.
+     **/
+    virtual void setBathymetry( t_idx  i_ix,
+                                t_idx  i_iy,
+                                t_real i_b ) = 0;
+
+    /**
+     * Sets the values of a block of cells in bulk.
+     * The values of cell (i_ix+ix, i_iy+iy) are read from offset iy * i_stride + ix of the input arrays.
+     *
+     * @param i_ix id of the block's first cell in x-direction.
+     * @param i_iy id of the block's first cell in y-direction.
+     * @param i_nx number of cells of the block in x-direction.
+     * @param i_ny number of cells of the block in y-direction.
+     * @param i_stride stride of the input arrays in y-direction (x is assumed to be stride-1).
+     * @param i_h water heights; optional: use nullptr if not required.
+     * @param i_hu momenta in x-direction; optional: use nullptr if not required.
+     * @param i_hv momenta in y-direction; optional: use nullptr if not required.
+     * @param i_b bathymetry; optional: use nullptr if not required.
+     **/
+    virtual void setValues( t_idx                i_ix,
+                            t_idx                i_iy,
+                            t_idx                i_nx,
+                            t_idx                i_ny,
+                            t_idx                i_stride,
+                            t_real       const * i_h,
+                            t_real       const * i_hu,
+                            t_real       const * i_hv,
+                            t_real       const * i_b ) = 0;
+
+    /**
+     * Writes a checkpoint of the patch's active state, including ghost cells.
+     *
+     * @param i_path path of the checkpoint.
+     * @param i_time simulation time.
+     * @param i_timeStep time step counter.
+     * @param i_speedMax maximum wave speed of the last time step, from which the next time step is derived.
+     * @return true if successful, false otherwise.
+     **/
+    virtual bool writeCheckpoint( std::string const & i_path,
+                                  t_real              i_time,
+                                  t_idx               i_timeStep,
+                                  t_real              i_speedMax ) = 0;
+
+    /**
+     * Restores the patch's state from a checkpoint.
+     *
+     * @param i_path path of the checkpoint.
+     * @param o_time will be set to the simulation time.
+     * @param o_timeStep will be set to the time step counter.
+     * @param o_speedMax will be set to the maximum wave speed of the last time step.
+     * @return true if successful, false otherwise; the state is undefined on failure.
+     **/
+    virtual bool readCheckpoint( std::string const & i_path,
+                                 t_real            & o_time,
+                                 t_idx             & o_timeStep,
+                                 t_real            & o_speedMax ) = 0;
 };
 
 #endif
\ No newline at end of file
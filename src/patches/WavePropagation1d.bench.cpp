@@ -0,0 +1,131 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the one-dimensional wave propagation patch.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "WavePropagation1d.h"
+#include "../solvers/FWave.h"
+#include <cmath>
+#include <string>
+
+namespace {
+  /**
+   * Measures time steps of dam break problems for grid sizes from L1-resident to DRAM-bound.
+   * The tracked variants only solve the tiles reached by the waves; the MLUPS refer to all cells.
+   * The blocked variants perform 16 time steps per sweep over the domain.
+   *
+   * @param io_benchmark benchmark which records the results.
+   * @param i_type name of the floating point type.
+   **/
+  template< typename T_real >
+  void runType( tsunami_lab::benchmarks::Benchmark & io_benchmark,
+                std::string const                  & i_type ) {
+    // about 32 (float) or 64 (double) bytes per cell including the scratch memory
+    for( tsunami_lab::t_idx l_nCells : { tsunami_lab::t_idx(1) << 10,
+                                         tsunami_lab::t_idx(1) << 13,
+                                         tsunami_lab::t_idx(1) << 16,
+                                         tsunami_lab::t_idx(1) << 19,
+                                         tsunami_lab::t_idx(1) << 22 } ) {
+      for( bool l_tracking : { false, true } ) {
+        tsunami_lab::patches::WavePropagation1d< T_real > l_waveProp( l_nCells );
+        l_waveProp.setTracking( l_tracking );
+
+        for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+          l_waveProp.setHeight( l_ce,
+                                0,
+                                (l_ce < l_nCells / 2) ? 10 : 5 );
+          l_waveProp.setMomentumX( l_ce,
+                                   0,
+                                   0 );
+        }
+
+        double l_seconds = io_benchmark.measure( [&]() {
+          l_waveProp.setGhostOutflow();
+          l_waveProp.timeStep( T_real(0.01) );
+        } );
+
+        io_benchmark.report( "WavePropagation1d::timeStep/" + i_type + "/" + std::to_string( l_nCells )
+                             + ( l_tracking ? "/tracked" : "" ),
+                             "MLUPS",
+                             l_nCells / l_seconds * 1E-6 );
+      }
+
+      tsunami_lab::patches::WavePropagation1d< T_real > l_waveProp( l_nCells );
+      for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+        l_waveProp.setHeight( l_ce,
+                              0,
+                              (l_ce < l_nCells / 2) ? 10 : 5 );
+        l_waveProp.setMomentumX( l_ce,
+                                 0,
+                                 0 );
+      }
+      l_waveProp.setGhostOutflow();
+
+      double l_seconds = io_benchmark.measure( [&]() {
+        l_waveProp.timeSteps( T_real(0.01),
+                              16 );
+      } );
+
+      io_benchmark.report( "WavePropagation1d::timeSteps/" + i_type + "/" + std::to_string( l_nCells ) + "/blocked",
+                           "MLUPS",
+                           l_nCells * 16 / l_seconds * 1E-6 );
+    }
+  }
+
+  /**
+   * Measures the local time stepping on an ocean of 2^20 cells whose first eighth is deep (b=-4000) and the rest shallow (b=-50).
+   * The wave speeds differ by about a factor of 9, thus with four time levels only the deep tiles sub-cycle.
+   * Every run advances by the same time with global time steps or with the same number of finest sub-steps;
+   * the reported rate refers to global time steps of the finest level's size.
+   * The tracking is disabled since the local time stepping solves all tiles.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void runLocal( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    typedef tsunami_lab::patches::WavePropagation1d< float,
+                                                     tsunami_lab::solvers::FWave< float > > t_patch;
+    tsunami_lab::t_idx l_nCells = tsunami_lab::t_idx(1) << 20;
+
+    for( unsigned short l_nLevels : { 1, 2, 4 } ) {
+      t_patch l_waveProp( l_nCells );
+      l_waveProp.setNumTimeLevels( l_nLevels );
+      l_waveProp.setTracking( false );
+
+      for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+        float l_b = (l_ce < l_nCells / 8) ? -4000 : -50;
+        float l_eta = (l_ce >= l_nCells / 32 && l_ce < l_nCells / 16) ? 1 : 0;
+        l_waveProp.setBathymetry( l_ce, 0, l_b );
+        l_waveProp.setHeight( l_ce, 0, l_eta - l_b );
+      }
+
+      // CFL number of 0.45 w.r.t. the fastest waves for the finest level
+      tsunami_lab::t_idx l_nSubSteps = tsunami_lab::t_idx(1) << (l_nLevels-1);
+      float l_scaling = 0.45f * l_nSubSteps / std::sqrt( 9.81f * 4001 );
+
+      double l_seconds = io_benchmark.measure( [&]() {
+        l_waveProp.setGhostOutflow();
+        l_waveProp.timeStep( l_scaling );
+      } );
+
+      io_benchmark.report( "WavePropagation1d::timeStep/local/" + std::to_string( l_nLevels ) + "_levels",
+                           "steps/s",
+                           l_nSubSteps / l_seconds );
+    }
+  }
+
+  /**
+   * Runs the case.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    runType< float >( io_benchmark, "float" );
+    runType< double >( io_benchmark, "double" );
+    runLocal( io_benchmark );
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "WavePropagation1d",
+                                                                         run );
+}
@@ -5,82 +5,674 @@
  * One-dimensional wave propagation patch.
  **/
 #include "WavePropagation1d.h"
-#include "../solvers/Roe.h"
+#include "../solvers/FWave.h"
+#include "../solvers/Hll.h"
+#include "../io/Checkpoint.h"
+#include "../memory/Allocator.h"
+#include <algorithm>
 
-tsunami_lab::patches::WavePropagation1d::WavePropagation1d( t_idx i_nCells ) {
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::WavePropagation1d( t_idx i_nCells,
+                                                                                bool  i_hugePages ) {
   m_nCells = i_nCells;
 
   // allocate memory including a single ghost cell on each side
   for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
-    m_h[l_st] = new t_real[  m_nCells + 2 ];
-    m_hu[l_st] = new t_real[ m_nCells + 2 ];
+    m_h[l_st]  = memory::Allocator::allocate< T_real >( m_nCells + 2, i_hugePages );
+    m_hu[l_st] = memory::Allocator::allocate< T_real >( m_nCells + 2, i_hugePages );
   }
+  m_b = memory::Allocator::allocate< T_real >( m_nCells + 2, i_hugePages );
 
-  // init to zero
-  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
-    for( t_idx l_ce = 0; l_ce < m_nCells; l_ce++ ) {
-      m_h[l_st][l_ce] = 0;
-      m_hu[l_st][l_ce] = 0;
+  // allocate scratch memory for the net-updates of all edges
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    m_netUpdatesL[l_qt] = memory::Allocator::allocate< T_real >( m_nCells + 1, i_hugePages );
+    m_netUpdatesR[l_qt] = memory::Allocator::allocate< T_real >( m_nCells + 1, i_hugePages );
+  }
+
+  // tiles of edges, which are the unit of the active-region tracking
+  m_nTiles = (m_nCells+1 + m_batchSize-1) / m_batchSize;
+  m_active.assign( m_nTiles, 1 );
+  m_nonZero.assign( m_nTiles, 0 );
+  m_speedsMax.assign( m_nTiles, T_real(0) );
+  m_timeLevels.assign( m_nTiles, 0 );
+
+  // first touch: each tile's cells and edges are zeroed by the thread to which timeStep's static schedule assigns the tile
+#pragma omp parallel for schedule(static)
+  for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+    t_idx l_first = 0;
+    t_idx l_end = 0;
+    getCells( l_ti, l_first, l_end );
+
+    for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+      std::fill( m_h[l_st] + l_first, m_h[l_st] + l_end, T_real(0) );
+      std::fill( m_hu[l_st] + l_first, m_hu[l_st] + l_end, T_real(0) );
+    }
+    std::fill( m_b + l_first, m_b + l_end, T_real(0) );
+
+    t_idx l_ed = l_ti * m_batchSize;
+    t_idx l_nEdges = std::min( m_batchSize, m_nCells+1 - l_ed );
+    for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+      std::fill_n( m_netUpdatesL[l_qt] + l_ed, l_nEdges, T_real(0) );
+      std::fill_n( m_netUpdatesR[l_qt] + l_ed, l_nEdges, T_real(0) );
     }
   }
+
+  // ghost cells
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    m_h[l_st][0] = m_h[l_st][m_nCells+1] = 0;
+    m_hu[l_st][0] = m_hu[l_st][m_nCells+1] = 0;
+  }
+  m_b[0] = m_b[m_nCells+1] = 0;
 }
 
-tsunami_lab::patches::WavePropagation1d::~WavePropagation1d() {
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::~WavePropagation1d() {
   for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
-    delete[] m_h[l_st];
-    delete[] m_hu[l_st];
+    memory::Allocator::free( m_h[l_st] );
+    memory::Allocator::free( m_hu[l_st] );
+  }
+  memory::Allocator::free( m_b );
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    memory::Allocator::free( m_netUpdatesL[l_qt] );
+    memory::Allocator::free( m_netUpdatesR[l_qt] );
   }
 }
 
-void tsunami_lab::patches::WavePropagation1d::timeStep( t_real i_scaling ) {
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::timeStep( T_real i_scaling ) {
+  if( m_nTimeLevels > 1 ) return timeStepLocal( i_scaling );
+
   // pointers to old and new data
-  t_real * l_hOld = m_h[m_step];
-  t_real * l_huOld = m_hu[m_step];
+  T_real * l_hOld = m_h[m_step];
+  T_real * l_huOld = m_hu[m_step];
 
   m_step = (m_step+1) % 2;
-  t_real * l_hNew =  m_h[m_step];
-  t_real * l_huNew = m_hu[m_step];
+  T_real * l_hNew =  m_h[m_step];
+  T_real * l_huNew = m_hu[m_step];
+
+  // solve all tiles after external changes or if the tracking is disabled
+  if( m_allActive || !m_tracking ) {
+    std::fill( m_active.begin(), m_active.end(), 1 );
+    m_allActive = false;
+  }
+
+  // maximum wave speed of all edges
+  T_real l_speedMax = 0;
+
+  // the edges' net-updates are computed first and applied afterwards, without copying the old quantities;
+  // every thread only writes to its own edges or cells, which makes the result independent of the number of threads.
+  //
+  // the tracking relies on two invariants:
+  //   1) inactive tiles hold zero net-updates, since they had no non-zero net-updates when they were solved last,
+  //   2) the cells of a tile are identical in both time step buffers, if neither the tile nor its right neighbor is active;
+  //      the update skips the cells of such tiles.
+#pragma omp parallel
+  {
+    // compute net-updates of the active tiles; edge i is located between cells i and i+1
+#pragma omp for schedule(static) reduction(max:l_speedMax)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      if( m_active[l_ti] ) {
+        t_idx l_ed = l_ti * m_batchSize;
+        t_idx l_nEdges = std::min( m_batchSize, m_nCells+1 - l_ed );
+
+        T_real * l_netUpdatesL[2] = { m_netUpdatesL[0] + l_ed,
+                                      m_netUpdatesL[1] + l_ed };
+        T_real * l_netUpdatesR[2] = { m_netUpdatesR[0] + l_ed,
+                                      m_netUpdatesR[1] + l_ed };
+
+        m_speedsMax[l_ti] = T_solver::netUpdatesBatch( l_nEdges,
+                                                       l_hOld + l_ed,
+                                                       l_hOld + l_ed+1,
+                                                       l_huOld + l_ed,
+                                                       l_huOld + l_ed+1,
+                                                       m_b + l_ed,
+                                                       m_b + l_ed+1,
+                                                       l_netUpdatesL,
+                                                       l_netUpdatesR );
+
+        // detect the edges which change their adjacent cells
+        bool l_nonZero = false;
+#pragma omp simd reduction(||:l_nonZero)
+        for( t_idx l_be = 0; l_be < l_nEdges; l_be++ ) {
+          l_nonZero = l_nonZero || l_netUpdatesL[0][l_be] != 0 || l_netUpdatesL[1][l_be] != 0
+                                || l_netUpdatesR[0][l_be] != 0 || l_netUpdatesR[1][l_be] != 0;
+        }
+
+        t_idx l_last = l_nEdges-1;
+        m_nonZero[l_ti]  = l_nonZero ? 1 : 0;
+        m_nonZero[l_ti] |= ( l_netUpdatesL[0][0] != 0 || l_netUpdatesL[1][0] != 0 ) ? 2 : 0;
+        m_nonZero[l_ti] |= ( l_netUpdatesR[0][l_last] != 0 || l_netUpdatesR[1][l_last] != 0 ) ? 4 : 0;
+      }
+      else {
+        m_nonZero[l_ti] = 0;
+      }
+
+      // skipped tiles did not change since they were solved last
+      l_speedMax = std::max( m_speedsMax[l_ti], l_speedMax );
+    }
+
+    // compute the cells' new quantities in a single pass from the net-updates of the left (l_ce-1) and right (l_ce) edge
+#pragma omp for schedule(static)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      if( !m_active[l_ti] && !( l_ti+1 < m_nTiles && m_active[l_ti+1] ) ) continue;
+
+      t_idx l_first = 0;
+      t_idx l_end = 0;
+      getCells( l_ti, l_first, l_end );
+
+      for( t_idx l_ce = l_first; l_ce < l_end; l_ce++ ) {
+        l_hNew[l_ce]  = l_hOld[l_ce]  - i_scaling * m_netUpdatesR[0][l_ce-1] - i_scaling * m_netUpdatesL[0][l_ce];
+        l_huNew[l_ce] = l_huOld[l_ce] - i_scaling * m_netUpdatesR[1][l_ce-1] - i_scaling * m_netUpdatesL[1][l_ce];
+      }
+    }
+
+    // the active region grows by at most one cell per time step (CFL condition):
+    // a tile is active if one of its input cells changed
+#pragma omp for schedule(static)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      bool l_active = m_nonZero[l_ti] & 1;
+      if( l_ti > 0 )          l_active = l_active || ( m_nonZero[l_ti-1] & 4 );
+      if( l_ti+1 < m_nTiles ) l_active = l_active || ( m_nonZero[l_ti+1] & 2 );
+      m_active[l_ti] = l_active ? 1 : 0;
+    }
+  }
+
+  // outflow boundary conditions for the new quantities
+  setGhostOutflow();
+
+  return l_speedMax;
+}
+
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::timeStepLocal( T_real i_scaling ) {
+  // the cells are updated in place; the second buffer accumulates their updates until the end of their time steps
+  T_real * l_h = m_h[m_step];
+  T_real * l_hu = m_hu[m_step];
+  T_real * l_hAcc = m_h[(m_step+1) % 2];
+  T_real * l_huAcc = m_hu[(m_step+1) % 2];
+
+  unsigned short l_finest = m_nTimeLevels-1;
+  t_idx l_nSubSteps = t_idx(1) << l_finest;
+
+  // the tiles' wave speeds are outdated after external changes
+  if( m_allActive ) {
+#pragma omp parallel for schedule(static)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      t_idx l_ed = l_ti * m_batchSize;
+      t_idx l_nEdges = std::min( m_batchSize, m_nCells+1 - l_ed );
+
+      T_real * l_netUpdatesL[2] = { m_netUpdatesL[0] + l_ed,
+                                    m_netUpdatesL[1] + l_ed };
+      T_real * l_netUpdatesR[2] = { m_netUpdatesR[0] + l_ed,
+                                    m_netUpdatesR[1] + l_ed };
+
+      m_speedsMax[l_ti] = T_solver::netUpdatesBatch( l_nEdges,
+                                                     l_h + l_ed,
+                                                     l_h + l_ed+1,
+                                                     l_hu + l_ed,
+                                                     l_hu + l_ed+1,
+                                                     m_b + l_ed,
+                                                     m_b + l_ed+1,
+                                                     l_netUpdatesL,
+                                                     l_netUpdatesR );
+    }
+    m_allActive = false;
+  }
+
+  // assign the tiles to time levels from their CFL limits
+  T_real l_speedMax = *std::max_element( m_speedsMax.begin(), m_speedsMax.end() );
+  for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+    unsigned short l_level = 0;
+    while( l_level < l_finest && m_speedsMax[l_ti] * T_real(l_nSubSteps) > l_speedMax * T_real( t_idx(1) << l_level ) ) {
+      l_level++;
+    }
+    m_timeLevels[l_ti] = l_level;
+  }
+
+  // levels of neighboring tiles differ by at most one
+  for( t_idx l_ti = 1; l_ti < m_nTiles; l_ti++ ) {
+    if( m_timeLevels[l_ti-1] > m_timeLevels[l_ti]+1 ) m_timeLevels[l_ti] = m_timeLevels[l_ti-1]-1;
+  }
+  for( t_idx l_ti = m_nTiles-1; l_ti > 0; l_ti-- ) {
+    if( m_timeLevels[l_ti] > m_timeLevels[l_ti-1]+1 ) m_timeLevels[l_ti-1] = m_timeLevels[l_ti]-1;
+  }
+
+  // scalings of the tiles' edges in the current sub-step, zero if not solved; the first edge belongs to the finer level of two tiles
+  std::vector< T_real > l_scalings( m_nTiles, T_real(0) );
+  std::vector< T_real > l_scalingsFirst( m_nTiles, T_real(0) );
+
+#pragma omp parallel
+  {
+#pragma omp for schedule(static)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      t_idx l_first = 0;
+      t_idx l_end = 0;
+      getCells( l_ti, l_first, l_end );
+      std::fill( l_hAcc + l_first, l_hAcc + l_end, T_real(0) );
+      std::fill( l_huAcc + l_first, l_huAcc + l_end, T_real(0) );
+
+      m_speedsMax[l_ti] = 0;
+    }
+
+    for( t_idx l_st = 0; l_st < l_nSubSteps; l_st++ ) {
+      // solve the edges of the levels whose time steps start with the sub-step
+#pragma omp for schedule(static)
+      for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+        unsigned short l_level = m_timeLevels[l_ti];
+        unsigned short l_levelFirst = (l_ti > 0) ? std::max( m_timeLevels[l_ti-1], l_level ) : l_level;
+        bool l_solve = l_st % (t_idx(1) << (l_finest - l_level)) == 0;
+        bool l_solveFirst = l_st % (t_idx(1) << (l_finest - l_levelFirst)) == 0;
+
+        l_scalings[l_ti] = l_solve ? i_scaling / T_real( t_idx(1) << l_level ) : T_real(0);
+        l_scalingsFirst[l_ti] = l_solveFirst ? i_scaling / T_real( t_idx(1) << l_levelFirst ) : T_real(0);
+
+        t_idx l_ed = l_ti * m_batchSize;
+        t_idx l_nEdges = 0;
+        if( l_solve )           l_nEdges = std::min( m_batchSize, m_nCells+1 - l_ed );
+        else if( l_solveFirst ) l_nEdges = 1;
+        if( l_nEdges == 0 ) continue;
+
+        T_real * l_netUpdatesL[2] = { m_netUpdatesL[0] + l_ed,
+                                      m_netUpdatesL[1] + l_ed };
+        T_real * l_netUpdatesR[2] = { m_netUpdatesR[0] + l_ed,
+                                      m_netUpdatesR[1] + l_ed };
+
+        T_real l_speed = T_solver::netUpdatesBatch( l_nEdges,
+                                                    l_h + l_ed,
+                                                    l_h + l_ed+1,
+                                                    l_hu + l_ed,
+                                                    l_hu + l_ed+1,
+                                                    m_b + l_ed,
+                                                    m_b + l_ed+1,
+                                                    l_netUpdatesL,
+                                                    l_netUpdatesR );
+        m_speedsMax[l_ti] = std::max( l_speed, m_speedsMax[l_ti] );
+      }
+
+      // accumulate the net-updates of the solved edges and update the cells whose time steps end with the sub-step
+#pragma omp for schedule(static)
+      for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+        t_idx l_first = 0;
+        t_idx l_end = 0;
+        getCells( l_ti, l_first, l_end );
+
+        // the last cell's right edge is the first edge of the next tile, if the tile is full
+        T_real l_scalingLast = ( l_end == l_first + m_batchSize ) ? l_scalingsFirst[l_ti+1] : l_scalings[l_ti];
+        if( l_scalings[l_ti] != 0 ) {
+          for( t_idx l_ce = l_first; l_ce < l_end; l_ce++ ) {
+            T_real l_scalingL = (l_ce == l_first) ? l_scalingsFirst[l_ti] : l_scalings[l_ti];
+            T_real l_scalingR = (l_ce+1 == l_end) ? l_scalingLast : l_scalings[l_ti];
+
+            l_hAcc[l_ce]  -= l_scalingL * m_netUpdatesR[0][l_ce-1] + l_scalingR * m_netUpdatesL[0][l_ce];
+            l_huAcc[l_ce] -= l_scalingL * m_netUpdatesR[1][l_ce-1] + l_scalingR * m_netUpdatesL[1][l_ce];
+          }
+        }
+        else if( l_first < l_end ) {
+          // only the outermost edges of the tile may belong to finer levels
+          l_hAcc[l_first]  -= l_scalingsFirst[l_ti] * m_netUpdatesR[0][l_first-1];
+          l_huAcc[l_first] -= l_scalingsFirst[l_ti] * m_netUpdatesR[1][l_first-1];
+          l_hAcc[l_end-1]  -= l_scalingLast * m_netUpdatesL[0][l_end-1];
+          l_huAcc[l_end-1] -= l_scalingLast * m_netUpdatesL[1][l_end-1];
+        }
+
+        if( (l_st+1) % (t_idx(1) << (l_finest - m_timeLevels[l_ti])) == 0 ) {
+          for( t_idx l_ce = l_first; l_ce < l_end; l_ce++ ) {
+            l_h[l_ce]  += l_hAcc[l_ce];
+            l_hu[l_ce] += l_huAcc[l_ce];
+            l_hAcc[l_ce] = 0;
+            l_huAcc[l_ce] = 0;
+          }
+        }
+      }
+
+      // outflow boundary conditions for the cells' current quantities
+#pragma omp single
+      setGhostOutflow();
+    }
+  }
+
+  // the time step buffers differ, thus all tiles are solved in the next time step;
+  // unlike after external changes, the tiles' wave speeds are up to date
+  std::fill( m_active.begin(), m_active.end(), 1 );
+
+  l_speedMax = *std::max_element( m_speedsMax.begin(), m_speedsMax.end() );
+  return l_speedMax / T_real(l_nSubSteps);
+}
+
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::timeStepInterior( T_real i_scaling ) {
+  // the step is completed in timeStepBoundary, which also switches the buffers
+  T_real const * l_hOld = m_h[m_step];
+  T_real const * l_huOld = m_hu[m_step];
+  T_real * l_hNew =  m_h[(m_step+1) % 2];
+  T_real * l_huNew = m_hu[(m_step+1) % 2];
+
+  T_real l_speedMax = 0;
+
+#pragma omp parallel
+  {
+    // net-updates of the inner edges 1, ..., #cells-1
+#pragma omp for schedule(static) reduction(max:l_speedMax)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      t_idx l_ed = std::max< t_idx >( l_ti * m_batchSize, 1 );
+      t_idx l_end = std::min( (l_ti+1) * m_batchSize, m_nCells );
+      if( l_ed >= l_end ) continue;
+
+      T_real * l_netUpdatesL[2] = { m_netUpdatesL[0] + l_ed,
+                                    m_netUpdatesL[1] + l_ed };
+      T_real * l_netUpdatesR[2] = { m_netUpdatesR[0] + l_ed,
+                                    m_netUpdatesR[1] + l_ed };
+
+      T_real l_speed = T_solver::netUpdatesBatch( l_end - l_ed,
+                                                  l_hOld + l_ed,
+                                                  l_hOld + l_ed+1,
+                                                  l_huOld + l_ed,
+                                                  l_huOld + l_ed+1,
+                                                  m_b + l_ed,
+                                                  m_b + l_ed+1,
+                                                  l_netUpdatesL,
+                                                  l_netUpdatesR );
+      l_speedMax = std::max( l_speed, l_speedMax );
+    }
+
+    // cells 2, ..., #cells-1, whose edges are both inner edges
+#pragma omp for schedule(static)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      t_idx l_first = 0;
+      t_idx l_end = 0;
+      getCells( l_ti, l_first, l_end );
+      l_first = std::max< t_idx >( l_first, 2 );
+      l_end = std::min( l_end, m_nCells );
 
-  // init new cell quantities
-  for( t_idx l_ce = 1; l_ce < m_nCells+1; l_ce++ ) {
-    l_hNew[l_ce] = l_hOld[l_ce];
-    l_huNew[l_ce] = l_huOld[l_ce];
+      for( t_idx l_ce = l_first; l_ce < l_end; l_ce++ ) {
+        l_hNew[l_ce]  = l_hOld[l_ce]  - i_scaling * m_netUpdatesR[0][l_ce-1] - i_scaling * m_netUpdatesL[0][l_ce];
+        l_huNew[l_ce] = l_huOld[l_ce] - i_scaling * m_netUpdatesR[1][l_ce-1] - i_scaling * m_netUpdatesL[1][l_ce];
+      }
+    }
   }
 
-  // iterate over edges and update with Riemann solutions
-  for( t_idx l_ed = 0; l_ed < m_nCells+1; l_ed++ ) {
-    // determine left and right cell-id
-    t_idx l_ceL = l_ed;
-    t_idx l_ceR = l_ed+1;
+  // the tiles' net-updates and wave speeds are not tracked
+  m_allActive = true;
+
+  return l_speedMax;
+}
+
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::timeStepBoundary( T_real i_scaling ) {
+  T_real const * l_hOld = m_h[m_step];
+  T_real const * l_huOld = m_hu[m_step];
+  T_real * l_hNew =  m_h[(m_step+1) % 2];
+  T_real * l_huNew = m_hu[(m_step+1) % 2];
 
-    // compute net-updates
-    t_real l_netUpdates[2][2];
+  T_real l_speedMax = 0;
 
-    solvers::Roe::netUpdates( l_hOld[l_ceL],
-                              l_hOld[l_ceR],
-                              l_huOld[l_ceL],
-                              l_huOld[l_ceR],
-                              l_netUpdates[0],
-                              l_netUpdates[1] );
+  // net-updates of the outermost edges 0 and #cells
+  for( t_idx l_ed : { t_idx(0), m_nCells } ) {
+    T_real * l_netUpdatesL[2] = { m_netUpdatesL[0] + l_ed,
+                                  m_netUpdatesL[1] + l_ed };
+    T_real * l_netUpdatesR[2] = { m_netUpdatesR[0] + l_ed,
+                                  m_netUpdatesR[1] + l_ed };
 
-    // update the cells' quantities
-    l_hNew[l_ceL]  -= i_scaling * l_netUpdates[0][0];
-    l_huNew[l_ceL] -= i_scaling * l_netUpdates[0][1];
+    T_real l_speed = T_solver::netUpdatesBatch( 1,
+                                                l_hOld + l_ed,
+                                                l_hOld + l_ed+1,
+                                                l_huOld + l_ed,
+                                                l_huOld + l_ed+1,
+                                                m_b + l_ed,
+                                                m_b + l_ed+1,
+                                                l_netUpdatesL,
+                                                l_netUpdatesR );
+    l_speedMax = std::max( l_speed, l_speedMax );
+  }
 
-    l_hNew[l_ceR]  -= i_scaling * l_netUpdates[1][0];
-    l_huNew[l_ceR] -= i_scaling * l_netUpdates[1][1];
+  // first and last cell, which coincide for a single cell
+  for( t_idx l_ce : { t_idx(1), m_nCells } ) {
+    l_hNew[l_ce]  = l_hOld[l_ce]  - i_scaling * m_netUpdatesR[0][l_ce-1] - i_scaling * m_netUpdatesL[0][l_ce];
+    l_huNew[l_ce] = l_huOld[l_ce] - i_scaling * m_netUpdatesR[1][l_ce-1] - i_scaling * m_netUpdatesL[1][l_ce];
   }
+
+  m_step = (m_step+1) % 2;
+
+  // outflow boundary conditions for the new quantities
+  setGhostOutflow();
+  m_allActive = true;
+
+  return l_speedMax;
 }
 
-void tsunami_lab::patches::WavePropagation1d::setGhostOutflow() {
-  t_real * l_h = m_h[m_step];
-  t_real * l_hu = m_hu[m_step];
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::timeStepsBlocked( T_real i_scaling,
+                                                                                      t_idx  i_nSteps ) {
+  // pointers to old and new data
+  T_real const * l_hOld = m_h[m_step];
+  T_real const * l_huOld = m_hu[m_step];
+
+  m_step = (m_step+1) % 2;
+  T_real * l_hNew =  m_h[m_step];
+  T_real * l_huNew = m_hu[m_step];
+
+  // cells of a block including the halos of one cell per time step on each side
+  t_idx l_nBlocks = (m_nCells + m_blockCells-1) / m_blockCells;
+  t_idx l_nCellsLocal = m_blockCells + 2*i_nSteps;
+
+  // maximum wave speed of all edges
+  T_real l_speedMax = 0;
+
+#pragma omp parallel reduction(max:l_speedMax)
+  {
+    // thread-local quantities of a block for the current and next time step and the net-updates of its edges
+    T_real * l_h[2] = { nullptr, nullptr };
+    T_real * l_hu[2] = { nullptr, nullptr };
+    T_real * l_netUpdatesL[2] = { nullptr, nullptr };
+    T_real * l_netUpdatesR[2] = { nullptr, nullptr };
+    for( unsigned short l_id = 0; l_id < 2; l_id++ ) {
+      l_h[l_id] = memory::Allocator::allocate< T_real >( l_nCellsLocal );
+      l_hu[l_id] = memory::Allocator::allocate< T_real >( l_nCellsLocal );
+      l_netUpdatesL[l_id] = memory::Allocator::allocate< T_real >( l_nCellsLocal );
+      l_netUpdatesR[l_id] = memory::Allocator::allocate< T_real >( l_nCellsLocal );
+    }
+
+#pragma omp for schedule(static)
+    for( t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++ ) {
+      // cells of the block, including ghost cells
+      t_idx l_first = l_bl * m_blockCells + 1;
+      t_idx l_end = std::min( l_first + m_blockCells, m_nCells+1 );
+
+      // range of valid cells which shrinks by one cell per time step and side, except at the domain's boundaries
+      t_idx l_lo = (l_first > i_nSteps) ? l_first - i_nSteps : 0;
+      t_idx l_hi = std::min( l_end + i_nSteps, m_nCells+2 );
+
+      // the thread-local arrays start at cell l_lo; from here on, the ranges are given in local ids
+      std::copy( l_hOld + l_lo, l_hOld + l_hi, l_h[0] );
+      std::copy( l_huOld + l_lo, l_huOld + l_hi, l_hu[0] );
+
+      bool l_boundaryL = l_lo == 0;
+      bool l_boundaryR = l_hi == m_nCells+2;
+      t_idx l_offset = l_lo;
+
+      // the bathymetry is constant in time and thus read in place
+      T_real const * l_b = m_b + l_offset;
+      l_first -= l_offset;
+      l_end -= l_offset;
+      l_hi -= l_offset;
+      l_lo = 0;
+
+      for( t_idx l_st = 0; l_st < i_nSteps; l_st++ ) {
+        T_real const * l_hSrc = l_h[l_st%2];
+        T_real const * l_huSrc = l_hu[l_st%2];
+        T_real * l_hDes = l_h[(l_st+1)%2];
+        T_real * l_huDes = l_hu[(l_st+1)%2];
+
+        // edges between the valid cells; edge l_lo+i is stored at position i
+        T_real l_speed = T_solver::netUpdatesBatch( l_hi - l_lo - 1,
+                                                    l_hSrc + l_lo,
+                                                    l_hSrc + l_lo+1,
+                                                    l_huSrc + l_lo,
+                                                    l_huSrc + l_lo+1,
+                                                    l_b + l_lo,
+                                                    l_b + l_lo+1,
+                                                    l_netUpdatesL,
+                                                    l_netUpdatesR );
+        l_speedMax = std::max( l_speed, l_speedMax );
+
+        // same update as in the individual time steps
+        for( t_idx l_ce = l_lo+1; l_ce < l_hi-1; l_ce++ ) {
+          t_idx l_ed = l_ce - l_lo;
+          l_hDes[l_ce]  = l_hSrc[l_ce]  - i_scaling * l_netUpdatesR[0][l_ed-1] - i_scaling * l_netUpdatesL[0][l_ed];
+          l_huDes[l_ce] = l_huSrc[l_ce] - i_scaling * l_netUpdatesR[1][l_ed-1] - i_scaling * l_netUpdatesL[1][l_ed];
+        }
+
+        // outflow boundary conditions
+        if( l_boundaryL ) {
+          l_hDes[0] = l_hDes[1];
+          l_huDes[0] = l_huDes[1];
+        }
+        else {
+          l_lo++;
+        }
+        if( l_boundaryR ) {
+          l_hDes[l_hi-1] = l_hDes[l_hi-2];
+          l_huDes[l_hi-1] = l_huDes[l_hi-2];
+        }
+        else {
+          l_hi--;
+        }
+      }
+
+      // write back the block's cells and the adjacent ghost cells
+      if( l_boundaryL && l_first == 1 ) l_first = 0;
+      if( l_boundaryR && l_end == l_hi-1 ) l_end = l_hi;
+
+      std::copy( l_h[i_nSteps%2] + l_first, l_h[i_nSteps%2] + l_end, l_hNew + l_offset + l_first );
+      std::copy( l_hu[i_nSteps%2] + l_first, l_hu[i_nSteps%2] + l_end, l_huNew + l_offset + l_first );
+    }
+
+    for( unsigned short l_id = 0; l_id < 2; l_id++ ) {
+      memory::Allocator::free( l_h[l_id] );
+      memory::Allocator::free( l_hu[l_id] );
+      memory::Allocator::free( l_netUpdatesL[l_id] );
+      memory::Allocator::free( l_netUpdatesR[l_id] );
+    }
+  }
+
+  return l_speedMax;
+}
+
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::timeSteps( T_real i_scaling,
+                                                                               t_idx  i_nSteps ) {
+  T_real l_speedMax = 0;
+
+  for( t_idx l_st = 0; l_st < i_nSteps; l_st += m_blockSteps ) {
+    T_real l_speed = timeStepsBlocked( i_scaling,
+                                       std::min( m_blockSteps, i_nSteps - l_st ) );
+    l_speedMax = std::max( l_speed, l_speedMax );
+  }
+
+  // the tiles' net-updates and wave speeds are outdated
+  m_allActive = true;
+
+  return l_speedMax;
+}
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::t_idx tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::getNumActiveTiles() const {
+  if( m_allActive || !m_tracking ) return m_nTiles;
+
+  return std::count( m_active.begin(), m_active.end(), 1 );
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::setGhostOutflow() {
+  T_real * l_h = m_h[m_step];
+  T_real * l_hu = m_hu[m_step];
 
   // set left boundary
   l_h[0] = l_h[1];
   l_hu[0] = l_hu[1];
+  m_b[0] = m_b[1];
 
   // set right boundary
   l_h[m_nCells+1] = l_h[m_nCells];
   l_hu[m_nCells+1] = l_hu[m_nCells];
-}
\ No newline at end of file
+  m_b[m_nCells+1] = m_b[m_nCells];
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::setValues( t_idx                i_ix,
+                                                                             t_idx,
+                                                                             t_idx                i_nx,
+                                                                             t_idx,
+                                                                             t_idx,
+                                                                             T_real       const * i_h,
+                                                                             T_real       const * i_hu,
+                                                                             T_real       const *,
+                                                                             T_real       const * i_b ) {
+  T_real * l_h  = m_h[m_step]  + i_ix+1;
+  T_real * l_hu = m_hu[m_step] + i_ix+1;
+  T_real * l_b  = m_b + i_ix+1;
+  m_allActive = true;
+
+#pragma omp parallel for schedule(static)
+  for( t_idx l_ce = 0; l_ce < i_nx; l_ce++ ) {
+    if( i_h  != nullptr ) l_h[l_ce]  = i_h[l_ce];
+    if( i_hu != nullptr ) l_hu[l_ce] = i_hu[l_ce];
+    if( i_b  != nullptr ) l_b[l_ce]  = i_b[l_ce];
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+bool tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::writeCheckpoint( std::string const & i_path,
+                                                                                   T_real              i_time,
+                                                                                   t_idx               i_timeStep,
+                                                                                   T_real              i_speedMax ) {
+  T_real const * l_fields[2] = { m_h[m_step], m_hu[m_step] };
+
+  return io::Checkpoint::write< T_real >( i_path,
+                                m_nCells+2,
+                                1,
+                                2,
+                                l_fields,
+                                i_time,
+                                i_timeStep,
+                                i_speedMax );
+}
+
+template< typename T_real,
+          typename T_solver >
+bool tsunami_lab::patches::WavePropagation1d< T_real, T_solver >::readCheckpoint( std::string const & i_path,
+                                                                                  T_real            & o_time,
+                                                                                  t_idx             & o_timeStep,
+                                                                                  T_real            & o_speedMax ) {
+  T_real * l_fields[2] = { m_h[m_step], m_hu[m_step] };
+  m_allActive = true;
+
+  return io::Checkpoint::read< T_real >( i_path,
+                               m_nCells+2,
+                               1,
+                               2,
+                               l_fields,
+                               o_time,
+                               o_timeStep,
+                               o_speedMax );
+}
+
+// explicit instantiations
+template class tsunami_lab::patches::WavePropagation1d< float,  tsunami_lab::solvers::Roe< float > >;
+template class tsunami_lab::patches::WavePropagation1d< double, tsunami_lab::solvers::Roe< double > >;
+template class tsunami_lab::patches::WavePropagation1d< float,  tsunami_lab::solvers::FWave< float > >;
+template class tsunami_lab::patches::WavePropagation1d< double, tsunami_lab::solvers::FWave< double > >;
+template class tsunami_lab::patches::WavePropagation1d< float,  tsunami_lab::solvers::Hll< float > >;
+template class tsunami_lab::patches::WavePropagation1d< double, tsunami_lab::solvers::Hll< double > >;
@@ -7,16 +7,54 @@
 #ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_1D
 #define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_1D
 
-#include "WavePropagation.h"
+#include "../constants.h"
+#include "../solvers/Roe.h"
+#include <algorithm>
+#include <string>
+#include <vector>
 
 namespace tsunami_lab {
   namespace patches {
+    template< typename T_real = t_real,
+              typename T_solver = solvers::Roe< T_real > >
     class WavePropagation1d;
   }
 }
 
-class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
+/**
+ * One-dimensional wave propagation patch.
+ *
+ * The patch is templated on the floating point type and on the Riemann solver.
+ * The solver has to provide a static netUpdatesBatch which takes the bathymetry, even if it ignores it,
+ * and is called for batches of edges.
+ * The member functions are non-virtual; use WavePropagationWrapper for runtime polymorphism.
+ * Instantiations for float and double with the Roe, the f-wave and the HLL solver are provided.
+ *
+ * The edges are grouped in tiles of m_batchSize edges.
+ * By default only active tiles are solved, i.e., tiles whose input cells changed in the previous time step.
+ * Since the solvers give zero net-updates for edges without jumps, the result is identical to solving all edges.
+ *
+ * Optionally, the tiles advance with local time steps (see setNumTimeLevels).
+ * Every tile is assigned to a time level k from its own CFL limit and advances with 2^-k times the time step,
+ * i.e., tiles with fast waves sub-cycle while tiles with slow waves take one big step.
+ **/
+template< typename T_real,
+          typename T_solver >
+class tsunami_lab::patches::WavePropagation1d {
+  public:
+    //! floating point type of the patch
+    typedef T_real t_realPatch;
+
   private:
+    //! number of edges which are passed to the Riemann solver as one batch
+    static t_idx constexpr m_batchSize = 1024;
+
+    //! number of cells per block in temporally blocked time stepping; sized for the blocks to be L2-resident
+    static t_idx constexpr m_blockCells = 4096;
+
+    //! maximum number of time steps which are performed per block in one sweep over the domain
+    static t_idx constexpr m_blockSteps = 16;
+
     //! current step which indicates the active values in the arrays below
     unsigned short m_step = 0;
 
@@ -24,18 +62,102 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
     t_idx m_nCells = 0;
 
     //! water heights for the current and next time step for all cells
-    t_real * m_h[2] = { nullptr, nullptr };
+    T_real * m_h[2] = { nullptr, nullptr };
 
     //! momenta for the current and next time step for all cells
-    t_real * m_hu[2] = { nullptr, nullptr };
+    T_real * m_hu[2] = { nullptr, nullptr };
+
+    //! bathymetry of all cells, which is constant in time
+    T_real * m_b = nullptr;
+
+    //! net-updates of the edges for the left cells; 0: heights, 1: momenta
+    T_real * m_netUpdatesL[2] = { nullptr, nullptr };
+
+    //! net-updates of the edges for the right cells; 0: heights, 1: momenta
+    T_real * m_netUpdatesR[2] = { nullptr, nullptr };
+
+    //! number of tiles, each consisting of m_batchSize edges (the last one might be smaller)
+    t_idx m_nTiles = 0;
+
+    //! true if the Riemann problems are only solved for the active tiles
+    bool m_tracking = true;
+
+    //! true if all tiles have to be solved in the next time step, e.g., after the cells were set externally
+    bool m_allActive = true;
+
+    //! flags of the tiles which are solved in the next time step
+    std::vector< unsigned char > m_active;
+
+    //! flags of the tiles' edges with non-zero net-updates in the last time step; 1: any edge, 2: first edge, 4: last edge
+    std::vector< unsigned char > m_nonZero;
+
+    //! maximum wave speeds of the tiles, computed when the tiles were solved last
+    std::vector< T_real > m_speedsMax;
+
+    //! number of time levels of the local time stepping; 1 disables the local time stepping
+    unsigned short m_nTimeLevels = 1;
+
+    //! time levels of the tiles in the last local time step
+    std::vector< unsigned short > m_timeLevels;
+
+    /**
+     * Gets the range of cells which are updated by the edges of a tile.
+     * Tile t owns the cells to the right of its edges, i.e., cells t*m_batchSize+1 to (t+1)*m_batchSize including ghost cells.
+     *
+     * @param i_tile id of the tile.
+     * @param o_first will be set to the first cell.
+     * @param o_end will be set to the cell after the last one.
+     **/
+    void getCells( t_idx   i_tile,
+                   t_idx & o_first,
+                   t_idx & o_end ) const {
+      o_first = i_tile * m_batchSize + 1;
+      o_end = std::min( o_first + m_batchSize, m_nCells+1 );
+    }
+
+    /**
+     * Performs up to m_blockSteps time steps in a single sweep over the domain.
+     * Every block of cells is copied together with a halo of one cell per time step to thread-local memory and advanced there.
+     * The halos are recomputed by the neighboring blocks; the result matches that of individual time steps bitwise.
+     *
+     * @param i_scaling scaling of the time steps (dt / dx).
+     * @param i_nSteps number of time steps.
+     * @return maximum wave speed of the Riemann problems solved in the time steps.
+     **/
+    T_real timeStepsBlocked( T_real i_scaling,
+                             t_idx  i_nSteps );
+
+    /**
+     * Performs a time step with local time stepping.
+     *
+     * Tile t is assigned to the smallest time level k_t, for which its maximum wave speed s_t satisfies s_t / 2^k_t <= s_max / 2^(K-1),
+     * with the number of time levels K and the maximum wave speed s_max of all tiles.
+     * The speeds are those of the last time step, thus the levels are consistent with a time step derived from the returned speed.
+     * Levels of neighboring tiles differ by at most one, which bounds the CFL number of waves entering a tile with a coarser level.
+     *
+     * The time step is split into 2^(K-1) sub-steps; level k is solved at every 2^(K-1-k)-th sub-step.
+     * An edge belongs to the finer level of its adjacent tiles.
+     * The cells accumulate the scaled net-updates of their edges in the second time step buffer and are updated
+     * at the end of their level's time steps; before, the cells are frozen.
+     * Thus, every cell contributes to the fluxes of both of its edges with the same state for the same time,
+     * which keeps the scheme conservative at the interfaces of the levels.
+     *
+     * @param i_scaling scaling of the time step (dt / dx) of time level 0.
+     * @return maximum wave speed of the Riemann problems solved in the time step divided by 2^(K-1).
+     **/
+    T_real timeStepLocal( T_real i_scaling );
 
   public:
     /**
      * Constructs the 1d wave propagation solver.
      *
+     * The fields are initialized to zero in parallel with the thread decomposition of the time step (first touch).
+     *
      * @param i_nCells number of cells.
+     * @param i_hugePages true if the fields should be backed by transparent huge pages.
      **/
-    WavePropagation1d( t_idx i_nCells );
+    WavePropagation1d( t_idx i_nCells,
+                       bool  i_hugePages = false );
 
     /**
      * Destructor which frees all allocated memory.
@@ -44,16 +166,136 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
 
     /**
      * Performs a time step.
+     * Uses all OpenMP threads; the result is bitwise-identical for any number of threads.
+     * Tiles without changes in their input cells are skipped if active-region tracking is enabled.
+     * The new quantities are computed in a single pass and the ghost cells are set according to outflow boundary conditions.
+     * If local time stepping is enabled, the tiles sub-cycle according to their time levels;
+     * the returned speed then bounds the time step of the coarsest level.
      *
      * @param i_scaling scaling of the time step (dt / dx).
+     * @return maximum wave speed of the Riemann problems solved in the time step; divided by 2^(K-1) for K time levels.
      **/
-    void timeStep( t_real i_scaling );
+    T_real timeStep( T_real i_scaling );
 
     /**
-     * Sets the values of the ghost cells according to outflow boundary conditions.
+     * Performs the part of a time step which is independent of the ghost cells:
+     * solves the inner edges and updates all cells except the first and the last one.
+     * Together with timeStepBoundary equivalent to timeStep; the ghost cells may be set between both calls,
+     * which allows to overlap their communication with the computations.
+     * All tiles are solved in the time step following the call.
+     *
+     * @param i_scaling scaling of the time step (dt / dx).
+     * @return maximum wave speed of the Riemann problems at the inner edges.
+     **/
+    T_real timeStepInterior( T_real i_scaling );
+
+    /**
+     * Completes a time step started by timeStepInterior:
+     * solves the two outermost edges, updates the first and the last cell and sets outflow ghost cells.
+     *
+     * @param i_scaling scaling of the time step (dt / dx); has to match that of timeStepInterior.
+     * @return maximum wave speed of the Riemann problems at the outermost edges.
+     **/
+    T_real timeStepBoundary( T_real i_scaling );
+
+    /**
+     * Performs multiple time steps with a fixed time step size in temporally blocked sweeps.
+     * The result is bitwise-identical to that of calling timeStep i_nSteps times.
+     * All tiles are solved in the time step following the call.
+     *
+     * @param i_scaling scaling of the time steps (dt / dx).
+     * @param i_nSteps number of time steps.
+     * @return maximum wave speed of the Riemann problems solved in the time steps.
+     **/
+    T_real timeSteps( T_real i_scaling,
+                      t_idx  i_nSteps );
+
+    /**
+     * Enables or disables the active-region tracking; enabled by default.
+     *
+     * @param i_tracking true if only active tiles should be solved, false if all tiles are solved in every time step.
+     **/
+    void setTracking( bool i_tracking ) {
+      m_tracking = i_tracking;
+      m_allActive = true;
+    }
+
+    /**
+     * Sets the number of time levels of the local time stepping.
+     * For K levels, the time step of the tiles with the fastest waves is 2^-(K-1) times the time step passed to timeStep.
+     *
+     * @param i_nLevels number of time levels; 1 disables the local time stepping (default).
+     **/
+    void setNumTimeLevels( unsigned short i_nLevels ) {
+      m_nTimeLevels = std::max< unsigned short >( i_nLevels, 1 );
+    }
+
+    /**
+     * Gets the time level of a tile in the last local time step.
+     *
+     * @param i_tile id of the tile.
+     * @return time level; 0 is the coarsest level.
+     **/
+    unsigned short getTimeLevel( t_idx i_tile ) const {
+      return m_timeLevels[i_tile];
+    }
+
+    /**
+     * Gets the number of tiles which are solved in the next time step.
+     *
+     * @return number of active tiles.
+     **/
+    t_idx getNumActiveTiles() const;
+
+    /**
+     * Gets the total number of tiles.
+     *
+     * @return number of tiles.
+     **/
+    t_idx getNumTiles() const {
+      return m_nTiles;
+    }
+
+    /**
+     * Sets the values of the ghost cells according to outflow boundary conditions, including the bathymetry.
      **/
     void setGhostOutflow();
 
+    /**
+     * Sets the values of a ghost cell, e.g., to those of a neighboring subdomain.
+     * The ghost cell's bathymetry is that of the adjacent cell.
+     *
+     * @param i_side side of the ghost cell: 0 for left, 1 for right.
+     * @param i_h water height.
+     * @param i_hu momentum in x-direction.
+     **/
+    void setGhostCell( unsigned short i_side,
+                       T_real         i_h,
+                       T_real         i_hu ) {
+      t_idx l_ce = (i_side == 0) ? 0 : m_nCells+1;
+      m_h[m_step][l_ce] = i_h;
+      m_hu[m_step][l_ce] = i_hu;
+      m_allActive = true;
+    }
+
+    /**
+     * Sets the values of a ghost cell including its bathymetry, e.g., to those of a coarser level.
+     *
+     * @param i_side side of the ghost cell: 0 for left, 1 for right.
+     * @param i_h water height.
+     * @param i_hu momentum in x-direction.
+     * @param i_b bathymetry.
+     **/
+    void setGhostCell( unsigned short i_side,
+                       T_real         i_h,
+                       T_real         i_hu,
+                       T_real         i_b ) {
+      setGhostCell( i_side,
+                    i_h,
+                    i_hu );
+      m_b[(i_side == 0) ? 0 : m_nCells+1] = i_b;
+    }
+
     /**
      * Gets the stride in y-direction. x-direction is stride-1.
      *
@@ -68,7 +310,7 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
      *
      * @return water heights.
      */
-    t_real const * getHeight(){
+    T_real const * getHeight(){
       return m_h[m_step]+1;
     }
 
@@ -77,17 +319,26 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
      *
      * @return momenta in x-direction.
      **/
-    t_real const * getMomentumX(){
+    T_real const * getMomentumX(){
       return m_hu[m_step]+1;
     }
 
     /**
      * Dummy function which returns a nullptr.
      **/
-    t_real const * getMomentumY(){
+    T_real const * getMomentumY(){
       return nullptr;
     }
 
+    /**
+     * Gets the cells' bathymetry.
+     *
+     * @return bathymetry.
+     **/
+    T_real const * getBathymetry(){
+      return m_b+1;
+    }
+
     /**
      * Sets the height of the cell to the given value.
      *
@@ -96,8 +347,9 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
      **/
     void setHeight( t_idx  i_ix,
                     t_idx,
-                    t_real i_h ) {
+                    T_real i_h ) {
       m_h[m_step][i_ix+1] = i_h;
+      m_allActive = true;
     }
 
     /**
@@ -108,8 +360,9 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
      **/
     void setMomentumX( t_idx  i_ix,
                        t_idx,
-                       t_real i_hu ) {
+                       T_real i_hu ) {
       m_hu[m_step][i_ix+1] = i_hu;
+      m_allActive = true;
     }
 
     /**
@@ -117,7 +370,69 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
      **/
     void setMomentumY( t_idx,
                        t_idx,
-                       t_real ) {};
+                       T_real ) {};
+
+    /**
+     * Sets the bathymetry of the cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_b bathymetry.
+     **/
+    void setBathymetry( t_idx  i_ix,
+                        t_idx,
+                        T_real i_b ) {
+      m_b[i_ix+1] = i_b;
+      m_allActive = true;
+    }
+
+    /**
+     * Sets the values of a block of cells in bulk.
+     * Only the first row of the input arrays is used; the momenta in y-direction are ignored.
+     *
+     * @param i_ix id of the block's first cell.
+     * @param i_nx number of cells of the block.
+     * @param i_h water heights; optional: use nullptr if not required.
+     * @param i_hu momenta in x-direction; optional: use nullptr if not required.
+     * @param i_b bathymetry; optional: use nullptr if not required.
+     **/
+    void setValues( t_idx                i_ix,
+                    t_idx,
+                    t_idx                i_nx,
+                    t_idx,
+                    t_idx,
+                    T_real       const * i_h,
+                    T_real       const * i_hu,
+                    T_real       const *,
+                    T_real       const * i_b );
+
+    /**
+     * Writes a checkpoint of the patch's active state, including ghost cells.
+     * The bathymetry is not part of the checkpoint since it is constant and given by the setup.
+     *
+     * @param i_path path of the checkpoint.
+     * @param i_time simulation time.
+     * @param i_timeStep time step counter.
+     * @param i_speedMax maximum wave speed of the last time step.
+     * @return true if successful, false otherwise.
+     **/
+    bool writeCheckpoint( std::string const & i_path,
+                          T_real              i_time,
+                          t_idx               i_timeStep,
+                          T_real              i_speedMax );
+
+    /**
+     * Restores the patch's state from a checkpoint.
+     *
+     * @param i_path path of the checkpoint.
+     * @param o_time will be set to the simulation time.
+     * @param o_timeStep will be set to the time step counter.
+     * @param o_speedMax will be set to the maximum wave speed of the last time step.
+     * @return true if successful, false otherwise; the state is undefined on failure.
+     **/
+    bool readCheckpoint( std::string const & i_path,
+                         T_real            & o_time,
+                         t_idx             & o_timeStep,
+                         T_real            & o_speedMax );
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,15 @@
  **/
 #include <catch2/catch.hpp>
 #include "WavePropagation1d.h"
+#include "WavePropagationWrapper.h"
+#include "../solvers/FWave.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 TEST_CASE( "Test the 1d wave propagation solver.", "[WaveProp1d]" ) {
   /*
@@ -26,7 +35,7 @@ TEST_CASE( "Test the 1d wave propagation solver.", "[WaveProp1d]" ) {
    */
 
   // construct solver and setup a dambreak problem
-  tsunami_lab::patches::WavePropagation1d m_waveProp( 100 );
+  tsunami_lab::patches::WavePropagation1d<> m_waveProp( 100 );
 
   for( std::size_t l_ce = 0; l_ce < 50; l_ce++ ) {
     m_waveProp.setHeight( l_ce,
@@ -48,8 +57,13 @@ TEST_CASE( "Test the 1d wave propagation solver.", "[WaveProp1d]" ) {
   // set outflow boundary condition
   m_waveProp.setGhostOutflow();
 
-  // perform a time step
-  m_waveProp.timeStep( 0.1 );
+  // perform a time step; steady states of height 10 have the largest wave speed
+  tsunami_lab::t_real l_speedMax = m_waveProp.timeStep( 0.1 );
+  REQUIRE( l_speedMax == Approx( std::sqrt( 9.80665 * 10 ) ) );
+
+  // the time step sets outflow values in the ghost cells
+  REQUIRE( m_waveProp.getHeight()[-1]  == m_waveProp.getHeight()[0] );
+  REQUIRE( m_waveProp.getHeight()[100] == m_waveProp.getHeight()[99] );
 
   // steady state
   for( std::size_t l_ce = 0; l_ce < 49; l_ce++ ) {
@@ -69,4 +83,508 @@ TEST_CASE( "Test the 1d wave propagation solver.", "[WaveProp1d]" ) {
     REQUIRE( m_waveProp.getHeight()[l_ce]   == Approx(8) );
     REQUIRE( m_waveProp.getMomentumX()[l_ce] == Approx(0) );
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Test the independence of the 1d wave propagation solver from the number of threads.", "[WaveProp1dThreads]" ) {
+  /*
+   * Test case:
+   *
+   *   Smooth, non-trivial initial state which is advanced by ten time steps,
+   *   once with a single thread and once with four threads.
+   *   The results have to be bitwise-identical.
+   */
+#ifdef _OPENMP
+  int l_nThreadsDefault = omp_get_max_threads();
+#endif
+
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp1( 5000 );
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp4( 5000 );
+
+  for( std::size_t l_ce = 0; l_ce < 5000; l_ce++ ) {
+    tsunami_lab::t_real l_h  = 10 + (l_ce % 17) * 0.25;
+    tsunami_lab::t_real l_hu = (l_ce % 5) * 0.5 - 1;
+
+    l_waveProp1.setHeight( l_ce, 0, l_h );
+    l_waveProp4.setHeight( l_ce, 0, l_h );
+    l_waveProp1.setMomentumX( l_ce, 0, l_hu );
+    l_waveProp4.setMomentumX( l_ce, 0, l_hu );
+  }
+
+  for( unsigned short l_ti = 0; l_ti < 10; l_ti++ ) {
+#ifdef _OPENMP
+    omp_set_num_threads( 1 );
+#endif
+    l_waveProp1.setGhostOutflow();
+    l_waveProp1.timeStep( 0.01 );
+
+#ifdef _OPENMP
+    omp_set_num_threads( 4 );
+#endif
+    l_waveProp4.setGhostOutflow();
+    l_waveProp4.timeStep( 0.01 );
+  }
+
+#ifdef _OPENMP
+  omp_set_num_threads( l_nThreadsDefault );
+#endif
+
+  for( std::size_t l_ce = 0; l_ce < 5000; l_ce++ ) {
+    REQUIRE( l_waveProp1.getHeight()[l_ce]    == l_waveProp4.getHeight()[l_ce] );
+    REQUIRE( l_waveProp1.getMomentumX()[l_ce] == l_waveProp4.getMomentumX()[l_ce] );
+  }
+}
+
+TEST_CASE( "Test checkpointing the 1d wave propagation solver.", "[WaveProp1dCheckpoint]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break which is advanced by five time steps and checkpointed.
+   *   The checkpoint is restored into a second patch.
+   *   Five further time steps have to give bitwise-identical results in both patches.
+   */
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp( 100 );
+  for( std::size_t l_ce = 0; l_ce < 100; l_ce++ ) {
+    l_waveProp.setHeight( l_ce, 0, (l_ce < 50) ? 10 : 8 );
+    l_waveProp.setMomentumX( l_ce, 0, 0 );
+  }
+
+  for( unsigned short l_ti = 0; l_ti < 5; l_ti++ ) {
+    l_waveProp.setGhostOutflow();
+    l_waveProp.timeStep( 0.05 );
+  }
+
+  std::string l_path = "test_checkpoint_1d.chk";
+  REQUIRE( l_waveProp.writeCheckpoint( l_path, 0.25, 5, 7.5 ) );
+
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp2( 100 );
+  tsunami_lab::t_real l_time = 0;
+  tsunami_lab::t_idx l_timeStep = 0;
+  tsunami_lab::t_real l_speedMax = 0;
+  REQUIRE( l_waveProp2.readCheckpoint( l_path, l_time, l_timeStep, l_speedMax ) );
+  REQUIRE( l_time == 0.25f );
+  REQUIRE( l_timeStep == 5 );
+  REQUIRE( l_speedMax == 7.5f );
+
+  // checkpoints of patches with different sizes are rejected
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp3( 99 );
+  REQUIRE( !l_waveProp3.readCheckpoint( l_path, l_time, l_timeStep, l_speedMax ) );
+
+  std::remove( l_path.c_str() );
+
+  for( unsigned short l_ti = 0; l_ti < 5; l_ti++ ) {
+    l_waveProp.setGhostOutflow();
+    l_waveProp.timeStep( 0.05 );
+
+    l_waveProp2.setGhostOutflow();
+    l_waveProp2.timeStep( 0.05 );
+  }
+
+  for( std::size_t l_ce = 0; l_ce < 100; l_ce++ ) {
+    REQUIRE( l_waveProp.getHeight()[l_ce]    == l_waveProp2.getHeight()[l_ce] );
+    REQUIRE( l_waveProp.getMomentumX()[l_ce] == l_waveProp2.getMomentumX()[l_ce] );
+  }
+}
+
+TEST_CASE( "Test the initialization of the 1d wave propagation solver.", "[WaveProp1dInit]" ) {
+  for( bool l_hugePages : { false, true } ) {
+    tsunami_lab::patches::WavePropagation1d<> l_waveProp( 1000000,
+                                                        l_hugePages );
+
+    // all cells are zero, including the last ones
+    tsunami_lab::t_real const * l_h  = l_waveProp.getHeight();
+    tsunami_lab::t_real const * l_hu = l_waveProp.getMomentumX();
+    std::size_t l_nNonZero = 0;
+    for( std::size_t l_ce = 0; l_ce < 1000000; l_ce++ ) {
+      if( l_h[l_ce] != 0 || l_hu[l_ce] != 0 ) l_nNonZero++;
+    }
+    REQUIRE( l_nNonZero == 0 );
+    REQUIRE( l_h[999999] == 0 );
+
+    // the ghost cells are zero as well
+    REQUIRE( l_h[-1] == 0 );
+    REQUIRE( l_h[1000000] == 0 );
+  }
+}
+
+TEST_CASE( "Test the 1d wave propagation solver in float and double precision.", "[WaveProp1dPrecision]" ) {
+  tsunami_lab::patches::WavePropagation1d< float >  l_waveProp4( 500 );
+  tsunami_lab::patches::WavePropagation1d< double > l_waveProp8( 500 );
+
+  for( std::size_t l_ce = 0; l_ce < 500; l_ce++ ) {
+    l_waveProp4.setHeight( l_ce, 0, (l_ce < 250) ? 10 : 8 );
+    l_waveProp8.setHeight( l_ce, 0, (l_ce < 250) ? 10 : 8 );
+    l_waveProp4.setMomentumX( l_ce, 0, 0 );
+    l_waveProp8.setMomentumX( l_ce, 0, 0 );
+  }
+
+  for( unsigned short l_ti = 0; l_ti < 50; l_ti++ ) {
+    l_waveProp4.setGhostOutflow();
+    l_waveProp8.setGhostOutflow();
+
+    float  l_speedMax4 = l_waveProp4.timeStep( 0.05f );
+    double l_speedMax8 = l_waveProp8.timeStep( 0.05 );
+    REQUIRE( l_speedMax4 == Approx( l_speedMax8 ) );
+  }
+
+  // both precisions agree within the single-precision tolerance
+  for( std::size_t l_ce = 0; l_ce < 500; l_ce++ ) {
+    REQUIRE( l_waveProp4.getHeight()[l_ce]    == Approx( l_waveProp8.getHeight()[l_ce] ) );
+    REQUIRE( l_waveProp4.getMomentumX()[l_ce] == Approx( l_waveProp8.getMomentumX()[l_ce] ).margin( 1E-3 ) );
+  }
+
+  // mass is conserved in double precision up to the outflow, which the waves did not reach
+  double l_mass = 0;
+  for( std::size_t l_ce = 0; l_ce < 500; l_ce++ ) {
+    l_mass += l_waveProp8.getHeight()[l_ce];
+  }
+  REQUIRE( l_mass == Approx( 250 * 10 + 250 * 8 ).epsilon( 1E-12 ) );
+}
+
+TEST_CASE( "Test the type-erased wrapper of the 1d wave propagation solver.", "[WaveProp1dWrapper]" ) {
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp( 100 );
+  tsunami_lab::patches::WavePropagationWrapper< tsunami_lab::patches::WavePropagation1d<> > l_wrapper( 100 );
+  tsunami_lab::patches::WavePropagation & l_base = l_wrapper;
+
+  for( std::size_t l_ce = 0; l_ce < 100; l_ce++ ) {
+    l_waveProp.setHeight( l_ce, 0, (l_ce < 50) ? 10 : 8 );
+    l_base.setHeight( l_ce, 0, (l_ce < 50) ? 10 : 8 );
+    l_waveProp.setMomentumX( l_ce, 0, 0 );
+    l_base.setMomentumX( l_ce, 0, 0 );
+  }
+
+  l_waveProp.setGhostOutflow();
+  l_base.setGhostOutflow();
+  REQUIRE( l_waveProp.timeStep( 0.1 ) == l_base.timeStep( 0.1 ) );
+
+  REQUIRE( l_base.getStride() == 102 );
+  REQUIRE( l_base.getMomentumY() == nullptr );
+  REQUIRE( l_base.getHeight() == l_wrapper.getPatch().getHeight() );
+  for( std::size_t l_ce = 0; l_ce < 100; l_ce++ ) {
+    REQUIRE( l_base.getHeight()[l_ce]    == l_waveProp.getHeight()[l_ce] );
+    REQUIRE( l_base.getMomentumX()[l_ce] == l_waveProp.getMomentumX()[l_ce] );
+  }
+}
+
+TEST_CASE( "Test the active-region tracking of the 1d wave propagation solver.", "[WaveProp1dTracking]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break in the middle of 20000 cells, advanced with and without tracking.
+   *   The waves cover only a few tiles in the beginning and grow by at most one cell per time step.
+   *   The results and the maximum wave speeds have to be bitwise-identical.
+   */
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp( 20000 );
+  tsunami_lab::patches::WavePropagation1d<> l_wavePropAll( 20000 );
+  l_wavePropAll.setTracking( false );
+
+  for( std::size_t l_ce = 0; l_ce < 20000; l_ce++ ) {
+    tsunami_lab::t_real l_h = (l_ce < 10000) ? 10 : 8;
+    l_waveProp.setHeight( l_ce, 0, l_h );
+    l_wavePropAll.setHeight( l_ce, 0, l_h );
+    l_waveProp.setMomentumX( l_ce, 0, 0 );
+    l_wavePropAll.setMomentumX( l_ce, 0, 0 );
+  }
+  REQUIRE( l_waveProp.getNumTiles() == 20 );
+  REQUIRE( l_waveProp.getNumActiveTiles() == 20 );
+
+  for( unsigned short l_ti = 0; l_ti < 1500; l_ti++ ) {
+    l_waveProp.setGhostOutflow();
+    l_wavePropAll.setGhostOutflow();
+
+    REQUIRE( l_waveProp.timeStep( 0.05 ) == l_wavePropAll.timeStep( 0.05 ) );
+
+    // only the tile of the dam is active after the first step
+    if( l_ti == 0 ) {
+      REQUIRE( l_waveProp.getNumActiveTiles() == 1 );
+    }
+  }
+  REQUIRE( l_waveProp.getNumActiveTiles() < 20 );
+  REQUIRE( l_wavePropAll.getNumActiveTiles() == 20 );
+
+  for( std::size_t l_ce = 0; l_ce < 20000; l_ce++ ) {
+    REQUIRE( l_waveProp.getHeight()[l_ce]    == l_wavePropAll.getHeight()[l_ce] );
+    REQUIRE( l_waveProp.getMomentumX()[l_ce] == l_wavePropAll.getMomentumX()[l_ce] );
+  }
+
+  // external changes activate all tiles
+  l_waveProp.setHeight( 0, 0, 9 );
+  REQUIRE( l_waveProp.getNumActiveTiles() == 20 );
+}
+
+TEST_CASE( "Test the temporally blocked time stepping of the 1d wave propagation solver.", "[WaveProp1dBlocked]" ) {
+  /*
+   * Test case:
+   *
+   *   Smooth, non-trivial initial state and a dam break, which are advanced by 37 time steps,
+   *   once step by step and once in temporally blocked sweeps (16 + 16 + 5 steps).
+   *   The results and the maximum wave speeds have to be bitwise-identical.
+   *   The grid sizes cover a single partial block and multiple blocks.
+   */
+  for( std::size_t l_nCells : { 20, 10000 } ) {
+    tsunami_lab::patches::WavePropagation1d<> l_waveProp( l_nCells );
+    tsunami_lab::patches::WavePropagation1d<> l_wavePropBlocked( l_nCells );
+
+    for( std::size_t l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+      tsunami_lab::t_real l_h  = 10 + (l_ce % 17) * 0.25 + ( (l_ce < l_nCells / 2) ? 2 : 0 );
+      tsunami_lab::t_real l_hu = (l_ce % 5) * 0.5 - 1;
+
+      l_waveProp.setHeight( l_ce, 0, l_h );
+      l_wavePropBlocked.setHeight( l_ce, 0, l_h );
+      l_waveProp.setMomentumX( l_ce, 0, l_hu );
+      l_wavePropBlocked.setMomentumX( l_ce, 0, l_hu );
+    }
+    l_waveProp.setGhostOutflow();
+    l_wavePropBlocked.setGhostOutflow();
+
+    tsunami_lab::t_real l_speedMax = 0;
+    for( unsigned short l_ti = 0; l_ti < 37; l_ti++ ) {
+      l_speedMax = std::max( l_waveProp.timeStep( 0.01 ), l_speedMax );
+    }
+    REQUIRE( l_wavePropBlocked.timeSteps( 0.01, 37 ) == l_speedMax );
+
+    // ghost cells included
+    for( std::size_t l_ce = 0; l_ce < l_nCells+2; l_ce++ ) {
+      REQUIRE( l_waveProp.getHeight()[l_ce-1]    == l_wavePropBlocked.getHeight()[l_ce-1] );
+      REQUIRE( l_waveProp.getMomentumX()[l_ce-1] == l_wavePropBlocked.getMomentumX()[l_ce-1] );
+    }
+
+    // individual time steps continue seamlessly
+    l_waveProp.timeStep( 0.01 );
+    l_wavePropBlocked.timeStep( 0.01 );
+    for( std::size_t l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+      REQUIRE( l_waveProp.getHeight()[l_ce]    == l_wavePropBlocked.getHeight()[l_ce] );
+      REQUIRE( l_waveProp.getMomentumX()[l_ce] == l_wavePropBlocked.getMomentumX()[l_ce] );
+    }
+  }
+}
+
+TEST_CASE( "Test the split time steps of the 1d wave propagation solver for decomposed domains.", "[WaveProp1dSplit]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break in 3000 cells, which is advanced by 50 time steps in a single patch
+   *   and in two patches of 1200 and 1800 cells, whose ghost cells are exchanged
+   *   between the interior and boundary parts of the time steps.
+   *   The results and the maximum wave speeds have to be bitwise-identical.
+   */
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp( 3000 );
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp0( 1200 );
+  tsunami_lab::patches::WavePropagation1d<> l_waveProp1( 1800 );
+
+  for( std::size_t l_ce = 0; l_ce < 3000; l_ce++ ) {
+    tsunami_lab::t_real l_h = (l_ce < 1190) ? 10 : 8;
+    tsunami_lab::t_real l_hu = (l_ce % 7) * 0.1;
+
+    l_waveProp.setHeight( l_ce, 0, l_h );
+    l_waveProp.setMomentumX( l_ce, 0, l_hu );
+    if( l_ce < 1200 ) {
+      l_waveProp0.setHeight( l_ce, 0, l_h );
+      l_waveProp0.setMomentumX( l_ce, 0, l_hu );
+    }
+    else {
+      l_waveProp1.setHeight( l_ce - 1200, 0, l_h );
+      l_waveProp1.setMomentumX( l_ce - 1200, 0, l_hu );
+    }
+  }
+  l_waveProp.setGhostOutflow();
+  l_waveProp0.setGhostOutflow();
+  l_waveProp1.setGhostOutflow();
+
+  for( unsigned short l_ti = 0; l_ti < 50; l_ti++ ) {
+    tsunami_lab::t_real l_speed = l_waveProp.timeStep( 0.04 );
+
+    tsunami_lab::t_real l_speed0 = l_waveProp0.timeStepInterior( 0.04 );
+    tsunami_lab::t_real l_speed1 = l_waveProp1.timeStepInterior( 0.04 );
+
+    // exchange the ghost cells at the internal boundary
+    tsunami_lab::t_real l_h0 = l_waveProp0.getHeight()[1199];
+    tsunami_lab::t_real l_hu0 = l_waveProp0.getMomentumX()[1199];
+    l_waveProp0.setGhostCell( 1, l_waveProp1.getHeight()[0], l_waveProp1.getMomentumX()[0] );
+    l_waveProp1.setGhostCell( 0, l_h0, l_hu0 );
+
+    l_speed0 = std::max( l_waveProp0.timeStepBoundary( 0.04 ), l_speed0 );
+    l_speed1 = std::max( l_waveProp1.timeStepBoundary( 0.04 ), l_speed1 );
+
+    REQUIRE( std::max( l_speed0, l_speed1 ) == l_speed );
+  }
+
+  for( std::size_t l_ce = 0; l_ce < 3000; l_ce++ ) {
+    if( l_ce < 1200 ) {
+      REQUIRE( l_waveProp0.getHeight()[l_ce]    == l_waveProp.getHeight()[l_ce] );
+      REQUIRE( l_waveProp0.getMomentumX()[l_ce] == l_waveProp.getMomentumX()[l_ce] );
+    }
+    else {
+      REQUIRE( l_waveProp1.getHeight()[l_ce - 1200]    == l_waveProp.getHeight()[l_ce] );
+      REQUIRE( l_waveProp1.getMomentumX()[l_ce - 1200] == l_waveProp.getMomentumX()[l_ce] );
+    }
+  }
+}
+
+TEST_CASE( "Test the 1d wave propagation solver with the f-wave solver and bathymetry.", "[WaveProp1dFWave]" ) {
+  typedef tsunami_lab::patches::WavePropagation1d< double,
+                                                   tsunami_lab::solvers::FWave< double > > t_patch;
+
+  SECTION( "lake at rest" ) {
+    /*
+     * Test case:
+     *
+     *   Constant water surface at zero over a bathymetry with steps and slopes in 5000 cells.
+     *   The state has to remain unchanged bitwise and the tiles become inactive.
+     */
+    t_patch l_waveProp( 5000 );
+    for( std::size_t l_ce = 0; l_ce < 5000; l_ce++ ) {
+      double l_b = (l_ce < 2000) ? -50 : -20 - (l_ce % 100) * 0.25;
+      l_waveProp.setBathymetry( l_ce, 0, l_b );
+      l_waveProp.setHeight( l_ce, 0, -l_b );
+    }
+
+    for( unsigned short l_ti = 0; l_ti < 20; l_ti++ ) {
+      l_waveProp.setGhostOutflow();
+      l_waveProp.timeStep( 0.01 );
+    }
+    REQUIRE( l_waveProp.getNumActiveTiles() == 0 );
+
+    for( std::size_t l_ce = 0; l_ce < 5000; l_ce++ ) {
+      REQUIRE( l_waveProp.getHeight()[l_ce] + l_waveProp.getBathymetry()[l_ce] == 0 );
+      REQUIRE( l_waveProp.getMomentumX()[l_ce] == 0 );
+    }
+  }
+
+  SECTION( "flat bathymetry" ) {
+    /*
+     * Test case:
+     *
+     *   Dam break without bathymetry in 1000 cells.
+     *   The f-wave solver agrees with the Roe solver up to rounding and the Roe solver's truncated square root of gravity.
+     */
+    t_patch l_waveProp( 1000 );
+    tsunami_lab::patches::WavePropagation1d< double > l_wavePropRoe( 1000 );
+    for( std::size_t l_ce = 0; l_ce < 1000; l_ce++ ) {
+      double l_h = (l_ce < 500) ? 10 : 5;
+      l_waveProp.setHeight( l_ce, 0, l_h );
+      l_wavePropRoe.setHeight( l_ce, 0, l_h );
+    }
+
+    for( unsigned short l_ti = 0; l_ti < 40; l_ti++ ) {
+      l_waveProp.setGhostOutflow();
+      l_wavePropRoe.setGhostOutflow();
+      REQUIRE( l_waveProp.timeStep( 0.05 ) == Approx( l_wavePropRoe.timeStep( 0.05 ) ) );
+    }
+
+    for( std::size_t l_ce = 0; l_ce < 1000; l_ce++ ) {
+      REQUIRE( l_waveProp.getHeight()[l_ce]    == Approx( l_wavePropRoe.getHeight()[l_ce] ).epsilon( 1E-8 ) );
+      REQUIRE( l_waveProp.getMomentumX()[l_ce] == Approx( l_wavePropRoe.getMomentumX()[l_ce] ).margin( 1E-7 ) );
+    }
+  }
+
+  SECTION( "blocked and tracked time steps" ) {
+    /*
+     * Test case:
+     *
+     *   Dam break over varying bathymetry in 10000 cells, advanced by 37 time steps
+     *   with and without tracking, and in temporally blocked sweeps.
+     *   All results have to be bitwise-identical.
+     */
+    t_patch l_waveProp( 10000 );
+    t_patch l_wavePropUntracked( 10000 );
+    t_patch l_wavePropBlocked( 10000 );
+    l_wavePropUntracked.setTracking( false );
+
+    for( std::size_t l_ce = 0; l_ce < 10000; l_ce++ ) {
+      double l_b = -20 + std::sin( l_ce * 0.01 );
+      double l_h = ( (l_ce < 5000) ? 5 : 2 ) - l_b;
+      for( t_patch * l_patch : { &l_waveProp, &l_wavePropUntracked, &l_wavePropBlocked } ) {
+        l_patch->setBathymetry( l_ce, 0, l_b );
+        l_patch->setHeight( l_ce, 0, l_h );
+        l_patch->setGhostOutflow();
+      }
+    }
+
+    double l_speedMax = 0;
+    for( unsigned short l_ti = 0; l_ti < 37; l_ti++ ) {
+      l_speedMax = std::max( l_waveProp.timeStep( 0.01 ), l_speedMax );
+      l_wavePropUntracked.timeStep( 0.01 );
+    }
+    REQUIRE( l_wavePropBlocked.timeSteps( 0.01, 37 ) == l_speedMax );
+
+    for( std::size_t l_ce = 0; l_ce < 10000; l_ce++ ) {
+      REQUIRE( l_waveProp.getHeight()[l_ce]    == l_wavePropUntracked.getHeight()[l_ce] );
+      REQUIRE( l_waveProp.getMomentumX()[l_ce] == l_wavePropUntracked.getMomentumX()[l_ce] );
+      REQUIRE( l_waveProp.getHeight()[l_ce]    == l_wavePropBlocked.getHeight()[l_ce] );
+      REQUIRE( l_waveProp.getMomentumX()[l_ce] == l_wavePropBlocked.getMomentumX()[l_ce] );
+    }
+  }
+}
+
+TEST_CASE( "Test the local time stepping of the 1d wave propagation solver.", "[WaveProp1dLocal]" ) {
+  /*
+   * Test case:
+   *
+   *   Lake at rest with a deep (b=-100) and a shallow part (b=-1) in 12288 cells and humps of the water surface in both parts.
+   *   The wave speeds differ by a factor of 10, thus four time levels assign the deep tiles to level 3 and the shallow ones to level 0.
+   *   The local time stepping is compared to global time steps of the finest level's size.
+   *
+   *   In the deep part, all cells sub-cycle with the global time step; the results match up to rounding.
+   *   In the shallow part, the waves of the hump pass the interface of the levels 0 and 1; the results match up to the larger time steps.
+   *   The waves do not reach the boundaries, thus the mass is conserved.
+   */
+  typedef tsunami_lab::patches::WavePropagation1d< double,
+                                                   tsunami_lab::solvers::FWave< double > > t_patch;
+  t_patch l_waveProp( 12288 );
+  t_patch l_wavePropGlobal( 12288 );
+  l_waveProp.setNumTimeLevels( 4 );
+
+  for( std::size_t l_ce = 0; l_ce < 12288; l_ce++ ) {
+    double l_b = (l_ce < 6144) ? -100 : -1;
+    double l_eta = 0;
+    if( l_ce >= 2560 && l_ce < 3584 ) l_eta = 1;
+    if( l_ce >= 9100 && l_ce < 9200 ) l_eta = 0.1;
+
+    for( t_patch * l_patch : { &l_waveProp, &l_wavePropGlobal } ) {
+      l_patch->setBathymetry( l_ce, 0, l_b );
+      l_patch->setHeight( l_ce, 0, l_eta - l_b );
+      l_patch->setMomentumX( l_ce, 0, 0 );
+    }
+  }
+
+  double l_massInit = 0;
+  for( std::size_t l_ce = 0; l_ce < 12288; l_ce++ ) l_massInit += l_waveProp.getHeight()[l_ce];
+
+  // CFL number of 0.45 for the finest level
+  double l_scaling = 0.45 * 8 / std::sqrt( 9.81 * 101 );
+
+  for( unsigned short l_st = 0; l_st < 600; l_st++ ) {
+    l_waveProp.setGhostOutflow();
+    double l_speed = l_waveProp.timeStep( l_scaling );
+
+    for( unsigned short l_sub = 0; l_sub < 8; l_sub++ ) {
+      l_wavePropGlobal.setGhostOutflow();
+      l_wavePropGlobal.timeStep( l_scaling / 8 );
+    }
+
+    // tile 6 contains the edge between the deep and the shallow part, the following tiles are coarsened gradually
+    if( l_st == 0 ) {
+      REQUIRE( l_waveProp.getTimeLevel( 0 ) == 3 );
+      REQUIRE( l_waveProp.getTimeLevel( 6 ) == 3 );
+      REQUIRE( l_waveProp.getTimeLevel( 7 ) == 2 );
+      REQUIRE( l_waveProp.getTimeLevel( 8 ) == 1 );
+      REQUIRE( l_waveProp.getTimeLevel( 9 ) == 0 );
+      REQUIRE( l_waveProp.getTimeLevel( 12 ) == 0 );
+    }
+
+    l_scaling = 0.45 / l_speed;
+  }
+
+  double l_mass = 0;
+  for( std::size_t l_ce = 0; l_ce < 12288; l_ce++ ) {
+    l_mass += l_waveProp.getHeight()[l_ce];
+
+    double l_margin = (l_ce < 6144) ? 1E-10 : 1E-2;
+    REQUIRE( l_waveProp.getHeight()[l_ce]    == Approx( l_wavePropGlobal.getHeight()[l_ce] ).margin( l_margin ) );
+    REQUIRE( l_waveProp.getMomentumX()[l_ce] == Approx( l_wavePropGlobal.getMomentumX()[l_ce] ).margin( l_margin ) );
+  }
+  REQUIRE( l_mass == Approx( l_massInit ).epsilon( 1E-14 ) );
+
+  // the waves of the shallow hump reached the tile of level 1
+  REQUIRE( std::abs( l_waveProp.getHeight()[9000] - 1 ) > 1E-3 );
+}
@@ -0,0 +1,385 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Two-dimensional wave propagation patch using dimensional splitting.
+ **/
+#include "WavePropagation2d.h"
+#include "../solvers/FWave.h"
+#include "../solvers/Hll.h"
+#include "../io/Checkpoint.h"
+#include "../memory/Allocator.h"
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::WavePropagation2d( t_idx i_nCellsX,
+                                                                                t_idx i_nCellsY,
+                                                                                bool  i_hugePages ) {
+  m_nCellsX = i_nCellsX;
+  m_nCellsY = i_nCellsY;
+
+  // allocate memory including a single ghost cell on each side
+  t_idx l_nCellsAll = (m_nCellsX + 2) * (m_nCellsY + 2);
+
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    m_h[l_st]  = memory::Allocator::allocate< T_real >( l_nCellsAll, i_hugePages );
+    m_hu[l_st] = memory::Allocator::allocate< T_real >( l_nCellsAll, i_hugePages );
+    m_hv[l_st] = memory::Allocator::allocate< T_real >( l_nCellsAll, i_hugePages );
+  }
+  m_b = memory::Allocator::allocate< T_real >( l_nCellsAll, i_hugePages );
+
+  // allocate scratch memory for the net-updates of a row of edges per thread
+#ifdef _OPENMP
+  m_nThreads = omp_get_max_threads();
+#endif
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    m_netUpdatesL[l_qt] = memory::Allocator::allocate< T_real >( m_nThreads * (m_nCellsX + 1), i_hugePages );
+    m_netUpdatesR[l_qt] = memory::Allocator::allocate< T_real >( m_nThreads * (m_nCellsX + 1), i_hugePages );
+  }
+
+  // init to zero; rows are distributed as in the sweeps, which places the pages close to the threads using them
+  t_idx l_stride = getStride();
+
+#pragma omp parallel num_threads( m_nThreads )
+  {
+#pragma omp for schedule(static)
+    for( t_idx l_cy = 1; l_cy < m_nCellsY+1; l_cy++ ) {
+      for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+        std::fill_n( m_h[l_st]  + l_cy * l_stride, l_stride, T_real(0) );
+        std::fill_n( m_hu[l_st] + l_cy * l_stride, l_stride, T_real(0) );
+        std::fill_n( m_hv[l_st] + l_cy * l_stride, l_stride, T_real(0) );
+      }
+      std::fill_n( m_b + l_cy * l_stride, l_stride, T_real(0) );
+    }
+
+    // every thread touches its own scratch memory
+    T_real * l_netUpdatesL[2] = { nullptr, nullptr };
+    T_real * l_netUpdatesR[2] = { nullptr, nullptr };
+    getScratch( l_netUpdatesL,
+                l_netUpdatesR );
+
+    for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+      std::fill_n( l_netUpdatesL[l_qt], m_nCellsX+1, T_real(0) );
+      std::fill_n( l_netUpdatesR[l_qt], m_nCellsX+1, T_real(0) );
+    }
+  }
+
+  // bottom and top ghost rows
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    t_idx l_rowT = (m_nCellsY+1) * l_stride;
+
+    for( T_real * l_field : { m_h[l_st], m_hu[l_st], m_hv[l_st] } ) {
+      std::fill_n( l_field,          l_stride, T_real(0) );
+      std::fill_n( l_field + l_rowT, l_stride, T_real(0) );
+    }
+  }
+  std::fill_n( m_b,                            l_stride, T_real(0) );
+  std::fill_n( m_b + (m_nCellsY+1) * l_stride, l_stride, T_real(0) );
+}
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::~WavePropagation2d() {
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    memory::Allocator::free( m_h[l_st] );
+    memory::Allocator::free( m_hu[l_st] );
+    memory::Allocator::free( m_hv[l_st] );
+  }
+  memory::Allocator::free( m_b );
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    memory::Allocator::free( m_netUpdatesL[l_qt] );
+    memory::Allocator::free( m_netUpdatesR[l_qt] );
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::getScratch( T_real * o_netUpdatesL[2],
+                                                                              T_real * o_netUpdatesR[2] ) {
+  t_idx l_th = 0;
+#ifdef _OPENMP
+  l_th = omp_get_thread_num();
+#endif
+  t_idx l_offset = l_th * (m_nCellsX + 1);
+
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    o_netUpdatesL[l_qt] = m_netUpdatesL[l_qt] + l_offset;
+    o_netUpdatesR[l_qt] = m_netUpdatesR[l_qt] + l_offset;
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::sweepX( T_real i_scaling ) {
+  t_idx l_stride = getStride();
+
+  // pointers to old and new data
+  T_real * l_hOld  = m_h[m_step];
+  T_real * l_huOld = m_hu[m_step];
+  T_real * l_hvOld = m_hv[m_step];
+
+  m_step = (m_step+1) % 2;
+  T_real * l_hNew  = m_h[m_step];
+  T_real * l_huNew = m_hu[m_step];
+  T_real * l_hvNew = m_hv[m_step];
+
+  // maximum wave speed of all edges
+  T_real l_speedMax = 0;
+
+  // rows are independent in the x-sweep, thus every thread owns entire rows
+#pragma omp parallel num_threads( m_nThreads )
+  {
+    T_real * l_netUpdatesL[2] = { nullptr, nullptr };
+    T_real * l_netUpdatesR[2] = { nullptr, nullptr };
+    getScratch( l_netUpdatesL,
+                l_netUpdatesR );
+
+#pragma omp for schedule(static) reduction(max:l_speedMax)
+    for( t_idx l_cy = 1; l_cy < m_nCellsY+1; l_cy++ ) {
+      t_idx l_row = l_cy * l_stride;
+
+      // init new cell quantities
+      for( t_idx l_cx = 1; l_cx < m_nCellsX+1; l_cx++ ) {
+        l_hNew[l_row + l_cx]  = l_hOld[l_row + l_cx];
+        l_huNew[l_row + l_cx] = l_huOld[l_row + l_cx];
+        l_hvNew[l_row + l_cx] = l_hvOld[l_row + l_cx];
+      }
+
+      // compute net-updates of the row's vertical edges; edge i is located between cells i and i+1
+      T_real l_speed = T_solver::netUpdatesBatch( m_nCellsX+1,
+                                                  l_hOld  + l_row,
+                                                  l_hOld  + l_row + 1,
+                                                  l_huOld + l_row,
+                                                  l_huOld + l_row + 1,
+                                                  m_b     + l_row,
+                                                  m_b     + l_row + 1,
+                                                  l_netUpdatesL,
+                                                  l_netUpdatesR );
+      l_speedMax = std::max( l_speed, l_speedMax );
+
+      // update the cells' quantities
+      for( t_idx l_ed = 0; l_ed < m_nCellsX+1; l_ed++ ) {
+        t_idx l_ceL = l_row + l_ed;
+        t_idx l_ceR = l_row + l_ed + 1;
+
+        l_hNew[l_ceL]  -= i_scaling * l_netUpdatesL[0][l_ed];
+        l_huNew[l_ceL] -= i_scaling * l_netUpdatesL[1][l_ed];
+
+        l_hNew[l_ceR]  -= i_scaling * l_netUpdatesR[0][l_ed];
+        l_huNew[l_ceR] -= i_scaling * l_netUpdatesR[1][l_ed];
+      }
+    }
+  }
+
+  return l_speedMax;
+}
+
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::sweepY( T_real i_scaling ) {
+  t_idx l_stride = getStride();
+
+  // pointers to old and new data
+  T_real * l_hOld  = m_h[m_step];
+  T_real * l_huOld = m_hu[m_step];
+  T_real * l_hvOld = m_hv[m_step];
+
+  m_step = (m_step+1) % 2;
+  T_real * l_hNew  = m_h[m_step];
+  T_real * l_huNew = m_hu[m_step];
+  T_real * l_hvNew = m_hv[m_step];
+
+  // maximum wave speed of all edges
+  T_real l_speedMax = 0;
+
+#pragma omp parallel num_threads( m_nThreads )
+  {
+    // init new cell quantities
+#pragma omp for schedule(static)
+    for( t_idx l_cy = 1; l_cy < m_nCellsY+1; l_cy++ ) {
+      for( t_idx l_cx = 1; l_cx < m_nCellsX+1; l_cx++ ) {
+        t_idx l_ce = l_cy * l_stride + l_cx;
+
+        l_hNew[l_ce]  = l_hOld[l_ce];
+        l_huNew[l_ce] = l_huOld[l_ce];
+        l_hvNew[l_ce] = l_hvOld[l_ce];
+      }
+    }
+
+    T_real * l_netUpdatesL[2] = { nullptr, nullptr };
+    T_real * l_netUpdatesR[2] = { nullptr, nullptr };
+    getScratch( l_netUpdatesL,
+                l_netUpdatesR );
+
+    // iterate over tiles of columns; every thread owns entire tiles, whose rows stay in cache while moving upwards
+#pragma omp for schedule(static) reduction(max:l_speedMax)
+    for( t_idx l_tx = 1; l_tx < m_nCellsX+1; l_tx += m_tileSizeX ) {
+      t_idx l_nx = m_nCellsX+1 - l_tx;
+      l_nx = (l_nx < m_tileSizeX) ? l_nx : m_tileSizeX;
+
+      // iterate over pairs of rows; the horizontal edges between them form a stride-1 batch
+      for( t_idx l_ey = 0; l_ey < m_nCellsY+1; l_ey++ ) {
+        t_idx l_rowB = l_ey * l_stride + l_tx;
+        t_idx l_rowT = l_rowB + l_stride;
+
+        T_real l_speed = T_solver::netUpdatesBatch( l_nx,
+                                                    l_hOld  + l_rowB,
+                                                    l_hOld  + l_rowT,
+                                                    l_hvOld + l_rowB,
+                                                    l_hvOld + l_rowT,
+                                                    m_b     + l_rowB,
+                                                    m_b     + l_rowT,
+                                                    l_netUpdatesL,
+                                                    l_netUpdatesR );
+        l_speedMax = std::max( l_speed, l_speedMax );
+
+        // update the cells' quantities
+        for( t_idx l_ex = 0; l_ex < l_nx; l_ex++ ) {
+          l_hNew[l_rowB + l_ex]  -= i_scaling * l_netUpdatesL[0][l_ex];
+          l_hvNew[l_rowB + l_ex] -= i_scaling * l_netUpdatesL[1][l_ex];
+
+          l_hNew[l_rowT + l_ex]  -= i_scaling * l_netUpdatesR[0][l_ex];
+          l_hvNew[l_rowT + l_ex] -= i_scaling * l_netUpdatesR[1][l_ex];
+        }
+      }
+    }
+  }
+
+  return l_speedMax;
+}
+
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::timeStep( T_real i_scaling ) {
+  T_real l_speedMaxX = sweepX( i_scaling );
+
+  // the y-sweep requires the ghost cells of the intermediate solution
+  setGhostOutflow();
+
+  T_real l_speedMaxY = sweepY( i_scaling );
+
+  return std::max( l_speedMaxX, l_speedMaxY );
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::setGhostOutflow() {
+  t_idx l_stride = getStride();
+
+  T_real * l_h  = m_h[m_step];
+  T_real * l_hu = m_hu[m_step];
+  T_real * l_hv = m_hv[m_step];
+
+  // set left and right boundary
+  for( t_idx l_cy = 1; l_cy < m_nCellsY+1; l_cy++ ) {
+    t_idx l_row = l_cy * l_stride;
+
+    l_h[l_row]  = l_h[l_row + 1];
+    l_hu[l_row] = l_hu[l_row + 1];
+    l_hv[l_row] = l_hv[l_row + 1];
+    m_b[l_row]  = m_b[l_row + 1];
+
+    l_h[l_row + m_nCellsX+1]  = l_h[l_row + m_nCellsX];
+    l_hu[l_row + m_nCellsX+1] = l_hu[l_row + m_nCellsX];
+    l_hv[l_row + m_nCellsX+1] = l_hv[l_row + m_nCellsX];
+    m_b[l_row + m_nCellsX+1]  = m_b[l_row + m_nCellsX];
+  }
+
+  // set bottom and top boundary, including the corners
+  t_idx l_rowB = 0;
+  t_idx l_rowT = (m_nCellsY+1) * l_stride;
+
+  for( t_idx l_cx = 0; l_cx < m_nCellsX+2; l_cx++ ) {
+    l_h[l_rowB + l_cx]  = l_h[l_rowB + l_stride + l_cx];
+    l_hu[l_rowB + l_cx] = l_hu[l_rowB + l_stride + l_cx];
+    l_hv[l_rowB + l_cx] = l_hv[l_rowB + l_stride + l_cx];
+    m_b[l_rowB + l_cx]  = m_b[l_rowB + l_stride + l_cx];
+
+    l_h[l_rowT + l_cx]  = l_h[l_rowT - l_stride + l_cx];
+    l_hu[l_rowT + l_cx] = l_hu[l_rowT - l_stride + l_cx];
+    l_hv[l_rowT + l_cx] = l_hv[l_rowT - l_stride + l_cx];
+    m_b[l_rowT + l_cx]  = m_b[l_rowT - l_stride + l_cx];
+  }
+}
+
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::setValues( t_idx                i_ix,
+                                                                             t_idx                i_iy,
+                                                                             t_idx                i_nx,
+                                                                             t_idx                i_ny,
+                                                                             t_idx                i_stride,
+                                                                             T_real       const * i_h,
+                                                                             T_real       const * i_hu,
+                                                                             T_real       const * i_hv,
+                                                                             T_real       const * i_b ) {
+  t_idx l_stride = getStride();
+  t_idx l_offset = (i_iy+1) * l_stride + i_ix+1;
+
+  T_real * l_h  = m_h[m_step]  + l_offset;
+  T_real * l_hu = m_hu[m_step] + l_offset;
+  T_real * l_hv = m_hv[m_step] + l_offset;
+  T_real * l_b  = m_b + l_offset;
+
+#pragma omp parallel for collapse(2) schedule(static)
+  for( t_idx l_cy = 0; l_cy < i_ny; l_cy++ ) {
+    for( t_idx l_cx = 0; l_cx < i_nx; l_cx++ ) {
+      t_idx l_in  = l_cy * i_stride + l_cx;
+      t_idx l_out = l_cy * l_stride + l_cx;
+
+      if( i_h  != nullptr ) l_h[l_out]  = i_h[l_in];
+      if( i_hu != nullptr ) l_hu[l_out] = i_hu[l_in];
+      if( i_hv != nullptr ) l_hv[l_out] = i_hv[l_in];
+      if( i_b  != nullptr ) l_b[l_out]  = i_b[l_in];
+    }
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+bool tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::writeCheckpoint( std::string const & i_path,
+                                                                                   T_real              i_time,
+                                                                                   t_idx               i_timeStep,
+                                                                                   T_real              i_speedMax ) {
+  T_real const * l_fields[3] = { m_h[m_step], m_hu[m_step], m_hv[m_step] };
+
+  return io::Checkpoint::write< T_real >( i_path,
+                                m_nCellsX+2,
+                                m_nCellsY+2,
+                                3,
+                                l_fields,
+                                i_time,
+                                i_timeStep,
+                                i_speedMax );
+}
+
+template< typename T_real,
+          typename T_solver >
+bool tsunami_lab::patches::WavePropagation2d< T_real, T_solver >::readCheckpoint( std::string const & i_path,
+                                                                                  T_real            & o_time,
+                                                                                  t_idx             & o_timeStep,
+                                                                                  T_real            & o_speedMax ) {
+  T_real * l_fields[3] = { m_h[m_step], m_hu[m_step], m_hv[m_step] };
+
+  return io::Checkpoint::read< T_real >( i_path,
+                               m_nCellsX+2,
+                               m_nCellsY+2,
+                               3,
+                               l_fields,
+                               o_time,
+                               o_timeStep,
+                               o_speedMax );
+}
+
+// explicit instantiations
+template class tsunami_lab::patches::WavePropagation2d< float,  tsunami_lab::solvers::Roe< float > >;
+template class tsunami_lab::patches::WavePropagation2d< double, tsunami_lab::solvers::Roe< double > >;
+template class tsunami_lab::patches::WavePropagation2d< float,  tsunami_lab::solvers::FWave< float > >;
+template class tsunami_lab::patches::WavePropagation2d< double, tsunami_lab::solvers::FWave< double > >;
+template class tsunami_lab::patches::WavePropagation2d< float,  tsunami_lab::solvers::Hll< float > >;
+template class tsunami_lab::patches::WavePropagation2d< double, tsunami_lab::solvers::Hll< double > >;
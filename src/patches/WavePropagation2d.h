@@ -0,0 +1,285 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Two-dimensional wave propagation patch using dimensional splitting.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D
+#define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D
+
+#include "../constants.h"
+#include "../solvers/Roe.h"
+#include <string>
+
+namespace tsunami_lab {
+  namespace patches {
+    template< typename T_real = t_real,
+              typename T_solver = solvers::Roe< T_real > >
+    class WavePropagation2d;
+  }
+}
+
+/**
+ * Two-dimensional wave propagation patch.
+ *
+ * The patch is templated on the floating point type and on the Riemann solver.
+ * The solver has to provide a static netUpdatesBatch, which is called for rows of edges.
+ * Every row is passed with its bathymetry; the Roe solver's overload ignores it.
+ * The member functions are non-virtual; use WavePropagationWrapper for runtime polymorphism.
+ * Instantiations for float and double with the Roe, the f-wave and the HLL solver are provided.
+ **/
+template< typename T_real,
+          typename T_solver >
+class tsunami_lab::patches::WavePropagation2d {
+  public:
+    //! floating point type of the patch
+    typedef T_real t_realPatch;
+
+  private:
+    //! number of columns processed as one tile in the y-sweep; fixed to keep results independent of the number of threads
+    static t_idx constexpr m_tileSizeX = 128;
+
+    //! number of threads for which scratch memory is allocated
+    t_idx m_nThreads = 1;
+
+    //! current step which indicates the active values in the arrays below
+    unsigned short m_step = 0;
+
+    //! number of cells in x-direction discretizing the computational domain
+    t_idx m_nCellsX = 0;
+
+    //! number of cells in y-direction discretizing the computational domain
+    t_idx m_nCellsY = 0;
+
+    //! water heights for the current and next time step for all cells
+    T_real * m_h[2] = { nullptr, nullptr };
+
+    //! momenta in x-direction for the current and next time step for all cells
+    T_real * m_hu[2] = { nullptr, nullptr };
+
+    //! momenta in y-direction for the current and next time step for all cells
+    T_real * m_hv[2] = { nullptr, nullptr };
+
+    //! bathymetry of all cells, which is constant in time
+    T_real * m_b = nullptr;
+
+    //! per-thread net-updates of a row of edges for the left (x-sweep) or lower (y-sweep) cells; 0: heights, 1: momenta
+    T_real * m_netUpdatesL[2] = { nullptr, nullptr };
+
+    //! per-thread net-updates of a row of edges for the right (x-sweep) or upper (y-sweep) cells; 0: heights, 1: momenta
+    T_real * m_netUpdatesR[2] = { nullptr, nullptr };
+
+    /**
+     * Gets the calling thread's scratch memory for the net-updates of a row of edges.
+     *
+     * @param o_netUpdatesL will be set to the scratch memory for the left or lower cells; 0: heights, 1: momenta.
+     * @param o_netUpdatesR will be set to the scratch memory for the right or upper cells; 0: heights, 1: momenta.
+     **/
+    void getScratch( T_real * o_netUpdatesL[2],
+                     T_real * o_netUpdatesR[2] );
+
+    /**
+     * Performs the sweep in x-direction by solving the Riemann problems at all vertical edges.
+     * The y-momenta are copied.
+     *
+     * @param i_scaling scaling of the time step (dt / dx).
+     * @return maximum wave speed of the sweep.
+     **/
+    T_real sweepX( T_real i_scaling );
+
+    /**
+     * Performs the sweep in y-direction by solving the Riemann problems at all horizontal edges.
+     * The domain is tiled in x-direction and the edges between two rows of a tile are processed as one stride-1 batch.
+     * Thus, no transposition is required and each row is reused from cache by the next pair of rows.
+     * The x-momenta are copied.
+     *
+     * @param i_scaling scaling of the time step (dt / dy).
+     * @return maximum wave speed of the sweep.
+     **/
+    T_real sweepY( T_real i_scaling );
+
+  public:
+    /**
+     * Constructs the 2d wave propagation solver.
+     *
+     * The fields are initialized to zero in parallel with the row decomposition of the sweeps (first touch).
+     *
+     * @param i_nCellsX number of cells in x-direction.
+     * @param i_nCellsY number of cells in y-direction.
+     * @param i_hugePages true if the fields should be backed by transparent huge pages.
+     **/
+    WavePropagation2d( t_idx i_nCellsX,
+                       t_idx i_nCellsY,
+                       bool  i_hugePages = false );
+
+    /**
+     * Destructor which frees all allocated memory.
+     **/
+    ~WavePropagation2d();
+
+    /**
+     * Performs a time step through an x-sweep followed by a y-sweep.
+     * Uses the number of OpenMP threads available at construction; the result is bitwise-identical for any number of threads.
+     *
+     * @param i_scaling scaling of the time step (dt / dxy).
+     * @return maximum wave speed of the Riemann problems solved in the time step.
+     **/
+    T_real timeStep( T_real i_scaling );
+
+    /**
+     * Sets the values of the ghost cells according to outflow boundary conditions, including the bathymetry.
+     **/
+    void setGhostOutflow();
+
+    /**
+     * Gets the stride in y-direction. x-direction is stride-1.
+     *
+     * @return stride in y-direction.
+     **/
+    t_idx getStride(){
+      return m_nCellsX+2;
+    }
+
+    /**
+     * Gets cells' water heights.
+     *
+     * @return water heights.
+     */
+    T_real const * getHeight(){
+      return m_h[m_step] + getStride() + 1;
+    }
+
+    /**
+     * Gets the cells' momenta in x-direction.
+     *
+     * @return momenta in x-direction.
+     **/
+    T_real const * getMomentumX(){
+      return m_hu[m_step] + getStride() + 1;
+    }
+
+    /**
+     * Gets the cells' momenta in y-direction.
+     *
+     * @return momenta in y-direction.
+     **/
+    T_real const * getMomentumY(){
+      return m_hv[m_step] + getStride() + 1;
+    }
+
+    /**
+     * Gets the cells' bathymetry.
+     *
+     * @return bathymetry.
+     **/
+    T_real const * getBathymetry(){
+      return m_b + getStride() + 1;
+    }
+
+    /**
+     * Sets the height of the cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_h water height.
+     **/
+    void setHeight( t_idx  i_ix,
+                    t_idx  i_iy,
+                    T_real i_h ) {
+      m_h[m_step][ (i_iy+1) * getStride() + i_ix+1 ] = i_h;
+    }
+
+    /**
+     * Sets the momentum in x-direction to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_hu momentum in x-direction.
+     **/
+    void setMomentumX( t_idx  i_ix,
+                       t_idx  i_iy,
+                       T_real i_hu ) {
+      m_hu[m_step][ (i_iy+1) * getStride() + i_ix+1 ] = i_hu;
+    }
+
+    /**
+     * Sets the momentum in y-direction to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_hv momentum in y-direction.
+     **/
+    void setMomentumY( t_idx  i_ix,
+                       t_idx  i_iy,
+                       T_real i_hv ) {
+      m_hv[m_step][ (i_iy+1) * getStride() + i_ix+1 ] = i_hv;
+    }
+
+    /**
+     * Sets the bathymetry of the cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_b bathymetry.
+     **/
+    void setBathymetry( t_idx  i_ix,
+                        t_idx  i_iy,
+                        T_real i_b ) {
+      m_b[ (i_iy+1) * getStride() + i_ix+1 ] = i_b;
+    }
+
+    /**
+     * Sets the values of a block of cells in bulk.
+     * The values of cell (i_ix+ix, i_iy+iy) are read from offset iy * i_stride + ix of the input arrays.
+     *
+     * @param i_ix id of the block's first cell in x-direction.
+     * @param i_iy id of the block's first cell in y-direction.
+     * @param i_nx number of cells of the block in x-direction.
+     * @param i_ny number of cells of the block in y-direction.
+     * @param i_stride stride of the input arrays in y-direction (x is assumed to be stride-1).
+     * @param i_h water heights; optional: use nullptr if not required.
+     * @param i_hu momenta in x-direction; optional: use nullptr if not required.
+     * @param i_hv momenta in y-direction; optional: use nullptr if not required.
+     * @param i_b bathymetry; optional: use nullptr if not required.
+     **/
+    void setValues( t_idx                i_ix,
+                    t_idx                i_iy,
+                    t_idx                i_nx,
+                    t_idx                i_ny,
+                    t_idx                i_stride,
+                    T_real       const * i_h,
+                    T_real       const * i_hu,
+                    T_real       const * i_hv,
+                    T_real       const * i_b );
+
+    /**
+     * Writes a checkpoint of the patch's active state, including ghost cells.
+     * The bathymetry is not part of the checkpoint since it is constant and given by the setup.
+     *
+     * @param i_path path of the checkpoint.
+     * @param i_time simulation time.
+     * @param i_timeStep time step counter.
+     * @param i_speedMax maximum wave speed of the last time step.
+     * @return true if successful, false otherwise.
+     **/
+    bool writeCheckpoint( std::string const & i_path,
+                          T_real              i_time,
+                          t_idx               i_timeStep,
+                          T_real              i_speedMax );
+
+    /**
+     * Restores the patch's state from a checkpoint.
+     *
+     * @param i_path path of the checkpoint.
+     * @param o_time will be set to the simulation time.
+     * @param o_timeStep will be set to the time step counter.
+     * @param o_speedMax will be set to the maximum wave speed of the last time step.
+     * @return true if successful, false otherwise; the state is undefined on failure.
+     **/
+    bool readCheckpoint( std::string const & i_path,
+                         T_real            & o_time,
+                         t_idx             & o_timeStep,
+                         T_real            & o_speedMax );
+};
+
+#endif
@@ -0,0 +1,264 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the two-dimensional wave propagation patch.
+ **/
+#include <catch2/catch.hpp>
+#include "WavePropagation2d.h"
+#include "../solvers/FWave.h"
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+TEST_CASE( "Test the 2d wave propagation solver with a dam break in x-direction.", "[WaveProp2dX]" ) {
+  /*
+   * Test case:
+   *
+   *   Single dam break problem between cells 49 and 50 of every row.
+   *   The y-sweep sees steady states only, thus the net-updates match the 1d case
+   *   (see derivation in Roe solver):
+   *    left          | right
+   *      9.394671362 | -9.394671362
+   *    -88.25985     | -88.25985
+   */
+  tsunami_lab::patches::WavePropagation2d<> l_waveProp( 100, 4 );
+
+  for( std::size_t l_cy = 0; l_cy < 4; l_cy++ ) {
+    for( std::size_t l_cx = 0; l_cx < 100; l_cx++ ) {
+      l_waveProp.setHeight( l_cx,
+                            l_cy,
+                            (l_cx < 50) ? 10 : 8 );
+      l_waveProp.setMomentumX( l_cx,
+                               l_cy,
+                               0 );
+      l_waveProp.setMomentumY( l_cx,
+                               l_cy,
+                               0 );
+    }
+  }
+
+  l_waveProp.setGhostOutflow();
+  tsunami_lab::t_real l_speedMax = l_waveProp.timeStep( 0.1 );
+
+  REQUIRE( l_speedMax == Approx( std::sqrt( 9.80665 * 10 ) ) );
+  REQUIRE( l_waveProp.getStride() == 102 );
+
+  for( std::size_t l_cy = 0; l_cy < 4; l_cy++ ) {
+    tsunami_lab::t_real const * l_h  = l_waveProp.getHeight()    + l_cy * l_waveProp.getStride();
+    tsunami_lab::t_real const * l_hu = l_waveProp.getMomentumX() + l_cy * l_waveProp.getStride();
+    tsunami_lab::t_real const * l_hv = l_waveProp.getMomentumY() + l_cy * l_waveProp.getStride();
+
+    for( std::size_t l_cx = 0; l_cx < 100; l_cx++ ) {
+      REQUIRE( l_hv[l_cx] == Approx(0) );
+
+      if( l_cx < 49 ) {
+        REQUIRE( l_h[l_cx]  == Approx(10) );
+        REQUIRE( l_hu[l_cx] == Approx(0) );
+      }
+      else if( l_cx > 50 ) {
+        REQUIRE( l_h[l_cx]  == Approx(8) );
+        REQUIRE( l_hu[l_cx] == Approx(0) );
+      }
+    }
+
+    REQUIRE( l_h[49]  == Approx(10 - 0.1 * 9.394671362) );
+    REQUIRE( l_hu[49] == Approx( 0 + 0.1 * 88.25985) );
+
+    REQUIRE( l_h[50]  == Approx(8 + 0.1 * 9.394671362) );
+    REQUIRE( l_hu[50] == Approx(0 + 0.1 * 88.25985) );
+  }
+}
+
+TEST_CASE( "Test the 2d wave propagation solver with a dam break in y-direction.", "[WaveProp2dY]" ) {
+  /*
+   * Test case:
+   *
+   *   Single dam break problem between rows 4 and 5, steady state in x-direction.
+   *   The net-updates of the y-sweep match the 1d case with the momentum in y-direction.
+   */
+  tsunami_lab::patches::WavePropagation2d<> l_waveProp( 1000, 10 );
+
+  for( std::size_t l_cy = 0; l_cy < 10; l_cy++ ) {
+    for( std::size_t l_cx = 0; l_cx < 1000; l_cx++ ) {
+      l_waveProp.setHeight( l_cx,
+                            l_cy,
+                            (l_cy < 5) ? 10 : 8 );
+      l_waveProp.setMomentumX( l_cx,
+                               l_cy,
+                               0 );
+      l_waveProp.setMomentumY( l_cx,
+                               l_cy,
+                               0 );
+    }
+  }
+
+  l_waveProp.setGhostOutflow();
+  l_waveProp.timeStep( 0.1 );
+
+  for( std::size_t l_cy = 0; l_cy < 10; l_cy++ ) {
+    tsunami_lab::t_real const * l_h  = l_waveProp.getHeight()    + l_cy * l_waveProp.getStride();
+    tsunami_lab::t_real const * l_hu = l_waveProp.getMomentumX() + l_cy * l_waveProp.getStride();
+    tsunami_lab::t_real const * l_hv = l_waveProp.getMomentumY() + l_cy * l_waveProp.getStride();
+
+    for( std::size_t l_cx = 0; l_cx < 1000; l_cx++ ) {
+      REQUIRE( l_hu[l_cx] == Approx(0) );
+
+      if( l_cy < 4 ) {
+        REQUIRE( l_h[l_cx]  == Approx(10) );
+        REQUIRE( l_hv[l_cx] == Approx(0) );
+      }
+      else if( l_cy == 4 ) {
+        REQUIRE( l_h[l_cx]  == Approx(10 - 0.1 * 9.394671362) );
+        REQUIRE( l_hv[l_cx] == Approx( 0 + 0.1 * 88.25985) );
+      }
+      else if( l_cy == 5 ) {
+        REQUIRE( l_h[l_cx]  == Approx(8 + 0.1 * 9.394671362) );
+        REQUIRE( l_hv[l_cx] == Approx(0 + 0.1 * 88.25985) );
+      }
+      else {
+        REQUIRE( l_h[l_cx]  == Approx(8) );
+        REQUIRE( l_hv[l_cx] == Approx(0) );
+      }
+    }
+  }
+}
+
+
+TEST_CASE( "Test the independence of the 2d wave propagation solver from the number of threads.", "[WaveProp2dThreads]" ) {
+  /*
+   * Test case:
+   *
+   *   Non-trivial initial state which is advanced by five time steps,
+   *   once with a single thread and once with four threads.
+   *   The results have to be bitwise-identical.
+   */
+#ifdef _OPENMP
+  int l_nThreadsDefault = omp_get_max_threads();
+  omp_set_num_threads( 1 );
+#endif
+  tsunami_lab::patches::WavePropagation2d<> l_waveProp1( 300, 50 );
+
+#ifdef _OPENMP
+  omp_set_num_threads( 4 );
+#endif
+  tsunami_lab::patches::WavePropagation2d<> l_waveProp4( 300, 50 );
+
+#ifdef _OPENMP
+  omp_set_num_threads( l_nThreadsDefault );
+#endif
+
+  for( std::size_t l_cy = 0; l_cy < 50; l_cy++ ) {
+    for( std::size_t l_cx = 0; l_cx < 300; l_cx++ ) {
+      tsunami_lab::t_real l_h  = 10 + ( (l_cx * 7 + l_cy * 3) % 13 ) * 0.25;
+      tsunami_lab::t_real l_hu = (l_cx % 5) * 0.5 - 1;
+      tsunami_lab::t_real l_hv = (l_cy % 3) * 0.5 - 0.5;
+
+      l_waveProp1.setHeight( l_cx, l_cy, l_h );
+      l_waveProp4.setHeight( l_cx, l_cy, l_h );
+      l_waveProp1.setMomentumX( l_cx, l_cy, l_hu );
+      l_waveProp4.setMomentumX( l_cx, l_cy, l_hu );
+      l_waveProp1.setMomentumY( l_cx, l_cy, l_hv );
+      l_waveProp4.setMomentumY( l_cx, l_cy, l_hv );
+    }
+  }
+
+  for( unsigned short l_ti = 0; l_ti < 5; l_ti++ ) {
+    l_waveProp1.setGhostOutflow();
+    l_waveProp1.timeStep( 0.01 );
+
+    l_waveProp4.setGhostOutflow();
+    l_waveProp4.timeStep( 0.01 );
+  }
+
+  for( std::size_t l_cy = 0; l_cy < 50; l_cy++ ) {
+    for( std::size_t l_cx = 0; l_cx < 300; l_cx++ ) {
+      std::size_t l_id = l_cy * l_waveProp1.getStride() + l_cx;
+
+      REQUIRE( l_waveProp1.getHeight()[l_id]    == l_waveProp4.getHeight()[l_id] );
+      REQUIRE( l_waveProp1.getMomentumX()[l_id] == l_waveProp4.getMomentumX()[l_id] );
+      REQUIRE( l_waveProp1.getMomentumY()[l_id] == l_waveProp4.getMomentumY()[l_id] );
+    }
+  }
+}
+
+TEST_CASE( "Test the bulk initialization of the 2d wave propagation solver.", "[WaveProp2dValues]" ) {
+  tsunami_lab::patches::WavePropagation2d<> l_waveProp( 5, 4 );
+
+  // block of 3x2 cells starting at cell (1, 2), stored with a stride of 4
+  tsunami_lab::t_real l_h[8];
+  tsunami_lab::t_real l_hv[8];
+  tsunami_lab::t_real l_b[8];
+  for( std::size_t l_id = 0; l_id < 8; l_id++ ) {
+    l_h[l_id]  = 10 + l_id;
+    l_hv[l_id] = 20 + l_id;
+    l_b[l_id]  = -30 - tsunami_lab::t_real( l_id );
+  }
+
+  l_waveProp.setValues( 1,
+                        2,
+                        3,
+                        2,
+                        4,
+                        l_h,
+                        nullptr,
+                        l_hv,
+                        l_b );
+
+  tsunami_lab::t_idx l_stride = l_waveProp.getStride();
+  for( std::size_t l_cy = 0; l_cy < 4; l_cy++ ) {
+    for( std::size_t l_cx = 0; l_cx < 5; l_cx++ ) {
+      tsunami_lab::t_real l_hExp = 0;
+      tsunami_lab::t_real l_hvExp = 0;
+      tsunami_lab::t_real l_bExp = 0;
+      if( l_cx >= 1 && l_cx < 4 && l_cy >= 2 ) {
+        l_hExp  = 10 + (l_cy-2) * 4 + l_cx-1;
+        l_hvExp = 20 + (l_cy-2) * 4 + l_cx-1;
+        l_bExp  = -30 - tsunami_lab::t_real( (l_cy-2) * 4 + l_cx-1 );
+      }
+
+      REQUIRE( l_waveProp.getHeight()[   l_cy * l_stride + l_cx] == l_hExp );
+      REQUIRE( l_waveProp.getMomentumX()[l_cy * l_stride + l_cx] == 0 );
+      REQUIRE( l_waveProp.getMomentumY()[l_cy * l_stride + l_cx] == l_hvExp );
+      REQUIRE( l_waveProp.getBathymetry()[l_cy * l_stride + l_cx] == l_bExp );
+    }
+  }
+}
+
+TEST_CASE( "Test the 2d wave propagation solver with the f-wave solver and bathymetry.", "[WaveProp2dFWave]" ) {
+  /*
+   * Test case (lake at rest):
+   *
+   *   Constant water surface at zero over a bathymetry with a seamount in 60x40 cells.
+   *   The state has to remain unchanged bitwise.
+   */
+  tsunami_lab::patches::WavePropagation2d< float,
+                                           tsunami_lab::solvers::FWave< float > > l_waveProp( 60, 40 );
+
+  for( std::size_t l_cy = 0; l_cy < 40; l_cy++ ) {
+    for( std::size_t l_cx = 0; l_cx < 60; l_cx++ ) {
+      float l_dist = std::sqrt( float( (l_cx-30.0)*(l_cx-30.0) + (l_cy-20.0)*(l_cy-20.0) ) );
+      float l_b = -100 + ( (l_dist < 10) ? 80 - 8 * l_dist : 0 );
+
+      l_waveProp.setBathymetry( l_cx, l_cy, l_b );
+      l_waveProp.setHeight( l_cx, l_cy, -l_b );
+    }
+  }
+
+  for( unsigned short l_ti = 0; l_ti < 10; l_ti++ ) {
+    l_waveProp.setGhostOutflow();
+    REQUIRE( l_waveProp.timeStep( 0.01f ) > 0 );
+  }
+
+  std::size_t l_stride = l_waveProp.getStride();
+  for( std::size_t l_cy = 0; l_cy < 40; l_cy++ ) {
+    for( std::size_t l_cx = 0; l_cx < 60; l_cx++ ) {
+      std::size_t l_id = l_cy * l_stride + l_cx;
+
+      REQUIRE( l_waveProp.getHeight()[l_id] + l_waveProp.getBathymetry()[l_id] == 0 );
+      REQUIRE( l_waveProp.getMomentumX()[l_id] == 0 );
+      REQUIRE( l_waveProp.getMomentumY()[l_id] == 0 );
+    }
+  }
+}
@@ -0,0 +1,95 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the adaptive mesh refinement of one-dimensional wave propagation patches.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "WavePropagationAmr1d.h"
+#include <string>
+
+namespace {
+  //! number of cells of level 0
+  tsunami_lab::t_idx constexpr g_nCells = 1 << 12;
+
+  //! number of time steps per run
+  tsunami_lab::t_idx constexpr g_nSteps = 64;
+
+  /**
+   * Sets a dam break: height 10 in the left half of the domain and height 5 in the right half.
+   *
+   * @param i_nCells number of cells.
+   * @param io_waveProp patch or hierarchy whose cells are set.
+   **/
+  template< typename T_waveProp >
+  void setDamBreak( tsunami_lab::t_idx   i_nCells,
+                    T_waveProp         & io_waveProp ) {
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < i_nCells; l_ce++ ) {
+      io_waveProp.setHeight( l_ce,
+                             0,
+                             (l_ce < i_nCells / 2) ? 10 : 5 );
+      io_waveProp.setMomentumX( l_ce,
+                                0,
+                                0 );
+    }
+  }
+
+  /**
+   * Measures runs of a dam break with hierarchies of up to four levels
+   * and with uniform patches which match the resolution of the finest levels.
+   * All runs use the same time step, which is stable on the finest level.
+   * Reports the time steps per second and the number of cells after the run.
+   * The uniform patches are measured with and without active-region tracking:
+   * the tracking skips the resting parts of the domain, which only pays off while the waves cover a small part of it.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    for( unsigned short l_nLevels = 2; l_nLevels <= 4; l_nLevels++ ) {
+      tsunami_lab::t_idx l_factor = tsunami_lab::t_idx(1) << (l_nLevels-1);
+      tsunami_lab::t_real l_scaling = tsunami_lab::t_real(0.5) / (11 * l_factor);
+
+      tsunami_lab::t_idx l_nCellsAmr = 0;
+      double l_seconds = io_benchmark.measure( [&]() {
+        tsunami_lab::patches::WavePropagationAmr1d<> l_amr( g_nCells,
+                                                            l_nLevels );
+        setDamBreak( g_nCells, l_amr );
+
+        for( tsunami_lab::t_idx l_st = 0; l_st < g_nSteps; l_st++ ) {
+          l_amr.setGhostOutflow();
+          l_amr.timeStep( l_scaling );
+        }
+        l_nCellsAmr = l_amr.getNumCells();
+      } );
+
+      std::string l_name = "WavePropagationAmr1d/" + std::to_string( l_nLevels ) + "_levels";
+      io_benchmark.report( l_name,
+                           "steps/s",
+                           g_nSteps / l_seconds );
+      io_benchmark.report( l_name + "/cells",
+                           "cells",
+                           double(l_nCellsAmr) );
+
+      tsunami_lab::t_idx l_nCellsUniform = g_nCells * l_factor;
+      for( bool l_tracking : { false, true } ) {
+        l_seconds = io_benchmark.measure( [&]() {
+          tsunami_lab::patches::WavePropagation1d<> l_waveProp( l_nCellsUniform );
+          l_waveProp.setTracking( l_tracking );
+          setDamBreak( l_nCellsUniform, l_waveProp );
+
+          for( tsunami_lab::t_idx l_st = 0; l_st < g_nSteps; l_st++ ) {
+            l_waveProp.setGhostOutflow();
+            l_waveProp.timeStep( l_scaling * l_factor );
+          }
+        } );
+
+        io_benchmark.report( "WavePropagation1d/uniform_" + std::to_string( l_nCellsUniform ) + ( l_tracking ? "/tracked" : "" ),
+                             "steps/s",
+                             g_nSteps / l_seconds );
+      }
+    }
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "WavePropagationAmr1d",
+                                                                         run );
+}
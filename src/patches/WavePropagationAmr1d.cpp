@@ -0,0 +1,463 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Block-structured adaptive mesh refinement of one-dimensional wave propagation patches.
+ **/
+#include "WavePropagationAmr1d.h"
+#include "../solvers/FWave.h"
+#include "../solvers/Hll.h"
+#include <algorithm>
+#include <cmath>
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::WavePropagationAmr1d( t_idx          i_nCells,
+                                                                                      unsigned short i_nLevels,
+                                                                                      T_real         i_threshold,
+                                                                                      t_idx          i_blockSize,
+                                                                                      t_idx          i_regridInterval ) {
+  m_nCells = i_nCells;
+  m_nLevels = std::max< unsigned short >( i_nLevels, 1 );
+  m_threshold = i_threshold;
+  m_blockSize = std::max< t_idx >( i_blockSize, 1 );
+  m_regridInterval = std::max< t_idx >( i_regridInterval, 1 );
+
+  m_levels.resize( m_nLevels );
+  m_levels[0].push_back( { 0,
+                           m_nCells,
+                           new t_patch( m_nCells ) } );
+
+  // regrid after the first time step
+  m_nStepsRegrid = m_regridInterval - 1;
+}
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::~WavePropagationAmr1d() {
+  for( std::vector< Patch > & l_level : m_levels ) {
+    for( Patch & l_patch : l_level ) {
+      delete l_patch.m_patch;
+    }
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::clearFineLevels() {
+  for( unsigned short l_le = 1; l_le < m_nLevels; l_le++ ) {
+    for( Patch & l_patch : m_levels[l_le] ) {
+      delete l_patch.m_patch;
+    }
+    m_levels[l_le].clear();
+  }
+  m_nStepsRegrid = m_regridInterval - 1;
+}
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::t_idx tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::findPatch( unsigned short i_level,
+                                                                                              t_idx          i_cell ) const {
+  std::vector< Patch > const & l_level = m_levels[i_level];
+
+  // first patch which starts right of the cell; its predecessor is the only candidate
+  auto l_it = std::upper_bound( l_level.begin(),
+                                l_level.end(),
+                                i_cell,
+                                []( t_idx i_ce, Patch const & i_patch ) { return i_ce < i_patch.m_first; } );
+  if( l_it == l_level.begin() ) return l_level.size();
+  l_it--;
+
+  if( i_cell < l_it->m_first + l_it->m_nCells ) return l_it - l_level.begin();
+  return l_level.size();
+}
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::t_idx tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::getNumCells() const {
+  t_idx l_nCells = 0;
+  for( std::vector< Patch > const & l_level : m_levels ) {
+    for( Patch const & l_patch : l_level ) {
+      l_nCells += l_patch.m_nCells;
+    }
+  }
+  return l_nCells;
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::getFinest( t_idx    i_first,
+                                                                                t_idx    i_nCells,
+                                                                                T_real * o_h,
+                                                                                T_real * o_hu ) {
+  // from the coarsest to the finest level, the patches overwrite the cells which they cover
+  for( unsigned short l_le = 0; l_le < m_nLevels; l_le++ ) {
+    t_idx l_ratio = t_idx(1) << (m_nLevels-1 - l_le);
+
+    for( Patch & l_patch : m_levels[l_le] ) {
+      // cells of the patch in the index space of the finest level, clipped to the range
+      t_idx l_begin = std::max( l_patch.m_first * l_ratio, i_first );
+      t_idx l_end = std::min( (l_patch.m_first + l_patch.m_nCells) * l_ratio, i_first + i_nCells );
+
+      T_real const * l_h = l_patch.m_patch->getHeight();
+      T_real const * l_hu = l_patch.m_patch->getMomentumX();
+      for( t_idx l_ce = l_begin; l_ce < l_end; l_ce++ ) {
+        t_idx l_cePatch = l_ce / l_ratio - l_patch.m_first;
+        o_h[l_ce - i_first] = l_h[l_cePatch];
+        o_hu[l_ce - i_first] = l_hu[l_cePatch];
+      }
+    }
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::setGhostCellsCoarse( unsigned short i_level ) {
+  t_idx l_nCellsLevel = m_nCells << i_level;
+
+  for( Patch & l_patch : m_levels[i_level] ) {
+    T_real const * l_h = l_patch.m_patch->getHeight();
+    T_real const * l_hu = l_patch.m_patch->getMomentumX();
+    T_real const * l_b = l_patch.m_patch->getBathymetry();
+
+    for( unsigned short l_sd = 0; l_sd < 2; l_sd++ ) {
+      // the fine patch's cell next to the ghost cell and the fine cell in place of the ghost cell
+      t_idx l_ceFine = (l_sd == 0) ? 0 : l_patch.m_nCells-1;
+      bool l_boundary = (l_sd == 0) ? l_patch.m_first == 0 : l_patch.m_first + l_patch.m_nCells == l_nCellsLevel;
+
+      if( l_boundary ) {
+        l_patch.m_patch->setGhostCell( l_sd,
+                                       l_h[l_ceFine],
+                                       l_hu[l_ceFine],
+                                       l_b[l_ceFine] );
+      }
+      else {
+        t_idx l_ceCoarse = (l_sd == 0) ? l_patch.m_first / 2 - 1 : (l_patch.m_first + l_patch.m_nCells) / 2;
+        Patch & l_coarse = m_levels[i_level-1][ findPatch( i_level-1, l_ceCoarse ) ];
+        l_ceCoarse -= l_coarse.m_first;
+
+        l_patch.m_patch->setGhostCell( l_sd,
+                                       l_coarse.m_patch->getHeight()[l_ceCoarse],
+                                       l_coarse.m_patch->getMomentumX()[l_ceCoarse],
+                                       l_coarse.m_patch->getBathymetry()[l_ceCoarse] );
+      }
+    }
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::getCorrections( unsigned short            i_level,
+                                                                                     std::vector< Correction > & o_corrections ) {
+  o_corrections.clear();
+  t_idx l_nCellsLevel = m_nCells << i_level;
+
+  for( Patch & l_patch : m_levels[i_level] ) {
+    T_real const * l_hFine = l_patch.m_patch->getHeight();
+    T_real const * l_huFine = l_patch.m_patch->getMomentumX();
+    T_real const * l_bFine = l_patch.m_patch->getBathymetry();
+
+    for( unsigned short l_sd = 0; l_sd < 2; l_sd++ ) {
+      bool l_boundary = (l_sd == 0) ? l_patch.m_first == 0 : l_patch.m_first + l_patch.m_nCells == l_nCellsLevel;
+      if( l_boundary ) continue;
+
+      // coarse cell adjacent to the patch and the coarse cell on the other side of the shared edge, which the patch covers
+      t_idx l_ceCoarse = (l_sd == 0) ? l_patch.m_first / 2 - 1 : (l_patch.m_first + l_patch.m_nCells) / 2;
+      t_idx l_coId = findPatch( i_level-1, l_ceCoarse );
+      Patch & l_coarse = m_levels[i_level-1][l_coId];
+      l_ceCoarse -= l_coarse.m_first;
+      t_idx l_ceCovered = (l_sd == 0) ? l_ceCoarse+1 : l_ceCoarse-1;
+      t_idx l_ceFine = (l_sd == 0) ? 0 : l_patch.m_nCells-1;
+
+      T_real const * l_hCoarse = l_coarse.m_patch->getHeight();
+      T_real const * l_huCoarse = l_coarse.m_patch->getMomentumX();
+      T_real const * l_bCoarse = l_coarse.m_patch->getBathymetry();
+
+      // net-updates of the shared edge on both levels; the fine patch's ghost cell holds the adjacent coarse cell
+      T_real l_coarseL[2] = { 0, 0 };
+      T_real l_coarseR[2] = { 0, 0 };
+      T_real l_fineL[2] = { 0, 0 };
+      T_real l_fineR[2] = { 0, 0 };
+
+      if( l_sd == 0 ) {
+        netUpdates( l_hCoarse[l_ceCoarse],  l_hCoarse[l_ceCovered],
+                    l_huCoarse[l_ceCoarse], l_huCoarse[l_ceCovered],
+                    l_bCoarse[l_ceCoarse],  l_bCoarse[l_ceCovered],
+                    l_coarseL,
+                    l_coarseR );
+        netUpdates( l_hCoarse[l_ceCoarse],  l_hFine[l_ceFine],
+                    l_huCoarse[l_ceCoarse], l_huFine[l_ceFine],
+                    l_bCoarse[l_ceCoarse],  l_bFine[l_ceFine],
+                    l_fineL,
+                    l_fineR );
+
+        o_corrections.push_back( { l_coId,
+                                   l_ceCoarse,
+                                   { l_fineL[0] - l_coarseL[0],
+                                     l_fineL[1] - l_coarseL[1] } } );
+      }
+      else {
+        netUpdates( l_hCoarse[l_ceCovered],  l_hCoarse[l_ceCoarse],
+                    l_huCoarse[l_ceCovered], l_huCoarse[l_ceCoarse],
+                    l_bCoarse[l_ceCovered],  l_bCoarse[l_ceCoarse],
+                    l_coarseL,
+                    l_coarseR );
+        netUpdates( l_hFine[l_ceFine],  l_hCoarse[l_ceCoarse],
+                    l_huFine[l_ceFine], l_huCoarse[l_ceCoarse],
+                    l_bFine[l_ceFine],  l_bCoarse[l_ceCoarse],
+                    l_fineL,
+                    l_fineR );
+
+        o_corrections.push_back( { l_coId,
+                                   l_ceCoarse,
+                                   { l_fineR[0] - l_coarseR[0],
+                                     l_fineR[1] - l_coarseR[1] } } );
+      }
+    }
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::restrictLevel( unsigned short i_level ) {
+  std::vector< T_real > l_h;
+  std::vector< T_real > l_hu;
+
+  for( Patch & l_patch : m_levels[i_level] ) {
+    t_idx l_nCoarse = l_patch.m_nCells / 2;
+    l_h.resize( l_nCoarse );
+    l_hu.resize( l_nCoarse );
+
+    T_real const * l_hFine = l_patch.m_patch->getHeight();
+    T_real const * l_huFine = l_patch.m_patch->getMomentumX();
+    for( t_idx l_ce = 0; l_ce < l_nCoarse; l_ce++ ) {
+      l_h[l_ce]  = T_real(0.5) * ( l_hFine[2*l_ce]  + l_hFine[2*l_ce+1] );
+      l_hu[l_ce] = T_real(0.5) * ( l_huFine[2*l_ce] + l_huFine[2*l_ce+1] );
+    }
+
+    Patch & l_coarse = m_levels[i_level-1][ findPatch( i_level-1, l_patch.m_first / 2 ) ];
+    l_coarse.m_patch->setValues( l_patch.m_first / 2 - l_coarse.m_first,
+                                 0,
+                                 l_nCoarse,
+                                 0,
+                                 0,
+                                 l_h.data(),
+                                 l_hu.data(),
+                                 nullptr,
+                                 nullptr );
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+T_real tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::timeStep( T_real i_scaling ) {
+  // fine ghost cells and the corrections of the coarse cells are derived from the state before the time step
+  std::vector< std::vector< Correction > > l_corrections( m_nLevels );
+  for( unsigned short l_le = 1; l_le < m_nLevels; l_le++ ) {
+    setGhostCellsCoarse( l_le );
+    getCorrections( l_le,
+                    l_corrections[l_le] );
+  }
+
+  // advance all patches with the same time step
+  T_real l_speedMax = 0;
+  for( unsigned short l_le = 0; l_le < m_nLevels; l_le++ ) {
+    T_real l_scaling = i_scaling * T_real( t_idx(1) << l_le );
+    for( Patch & l_patch : m_levels[l_le] ) {
+      l_speedMax = std::max( l_patch.m_patch->timeStep( l_scaling ),
+                             l_speedMax );
+    }
+  }
+
+  // synchronize the levels from the finest to the coarsest
+  for( unsigned short l_le = m_nLevels-1; l_le > 0; l_le-- ) {
+    restrictLevel( l_le );
+
+    T_real l_scaling = i_scaling * T_real( t_idx(1) << (l_le-1) );
+    for( Correction const & l_corr : l_corrections[l_le] ) {
+      t_patch * l_coarse = m_levels[l_le-1][l_corr.m_patch].m_patch;
+      l_coarse->setHeight( l_corr.m_cell,
+                           0,
+                           l_coarse->getHeight()[l_corr.m_cell] - l_scaling * l_corr.m_netUpdates[0] );
+      l_coarse->setMomentumX( l_corr.m_cell,
+                              0,
+                              l_coarse->getMomentumX()[l_corr.m_cell] - l_scaling * l_corr.m_netUpdates[1] );
+    }
+  }
+
+  m_nStepsRegrid++;
+  if( m_nStepsRegrid >= m_regridInterval ) {
+    regrid();
+  }
+
+  // the finest level limits the time step
+  unsigned short l_finest = 0;
+  for( unsigned short l_le = 1; l_le < m_nLevels; l_le++ ) {
+    if( m_levels[l_le].size() > 0 ) l_finest = l_le;
+  }
+
+  return l_speedMax * T_real( t_idx(1) << l_finest );
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::initPatch( unsigned short               i_level,
+                                                                                std::vector< Patch > const & i_old,
+                                                                                Patch                      & io_patch ) {
+  t_idx l_nCells = io_patch.m_nCells;
+  std::vector< T_real > l_h( l_nCells );
+  std::vector< T_real > l_hu( l_nCells );
+  std::vector< T_real > l_b( l_nCells );
+
+  // minmod-limited slope of a quantity; zero at extrema and at the coarse patch's boundaries
+  auto l_slope = []( T_real const * i_q,
+                     t_idx          i_ce,
+                     t_idx          i_nCells ) {
+    if( i_ce == 0 || i_ce+1 == i_nCells ) return T_real(0);
+    T_real l_dL = i_q[i_ce] - i_q[i_ce-1];
+    T_real l_dR = i_q[i_ce+1] - i_q[i_ce];
+    if( l_dL * l_dR <= 0 ) return T_real(0);
+    return (std::abs( l_dL ) < std::abs( l_dR )) ? l_dL : l_dR;
+  };
+
+  // prolongate all cells from the next coarser level; the children are offset by a quarter of the coarse cell's size
+  Patch & l_coarse = m_levels[i_level-1][ findPatch( i_level-1, io_patch.m_first / 2 ) ];
+  T_real const * l_hCoarse = l_coarse.m_patch->getHeight();
+  T_real const * l_huCoarse = l_coarse.m_patch->getMomentumX();
+  T_real const * l_bCoarse = l_coarse.m_patch->getBathymetry();
+
+  std::vector< T_real > l_etaCoarse( l_coarse.m_nCells );
+  for( t_idx l_ce = 0; l_ce < l_coarse.m_nCells; l_ce++ ) {
+    l_etaCoarse[l_ce] = l_hCoarse[l_ce] + l_bCoarse[l_ce];
+  }
+
+  for( t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+    t_idx l_ceCoarse = (io_patch.m_first + l_ce) / 2 - l_coarse.m_first;
+    T_real l_offset = ( (io_patch.m_first + l_ce) % 2 == 0 ) ? T_real(-0.25) : T_real(0.25);
+
+    T_real l_eta = l_etaCoarse[l_ceCoarse] + l_offset * l_slope( l_etaCoarse.data(), l_ceCoarse, l_coarse.m_nCells );
+    l_b[l_ce]    = l_bCoarse[l_ceCoarse]   + l_offset * l_slope( l_bCoarse,          l_ceCoarse, l_coarse.m_nCells );
+    l_hu[l_ce]   = l_huCoarse[l_ceCoarse]  + l_offset * l_slope( l_huCoarse,         l_ceCoarse, l_coarse.m_nCells );
+    l_h[l_ce]    = l_eta - l_b[l_ce];
+  }
+
+  // keep the values of cells which were refined before
+  for( Patch const & l_old : i_old ) {
+    if( l_old.m_patch == nullptr ) continue;
+
+    t_idx l_first = std::max( l_old.m_first, io_patch.m_first );
+    t_idx l_end = std::min( l_old.m_first + l_old.m_nCells, io_patch.m_first + io_patch.m_nCells );
+    for( t_idx l_ce = l_first; l_ce < l_end; l_ce++ ) {
+      l_h[l_ce - io_patch.m_first]  = l_old.m_patch->getHeight()[l_ce - l_old.m_first];
+      l_hu[l_ce - io_patch.m_first] = l_old.m_patch->getMomentumX()[l_ce - l_old.m_first];
+      l_b[l_ce - io_patch.m_first]  = l_old.m_patch->getBathymetry()[l_ce - l_old.m_first];
+    }
+  }
+
+  io_patch.m_patch->setValues( 0,
+                               0,
+                               l_nCells,
+                               0,
+                               0,
+                               l_h.data(),
+                               l_hu.data(),
+                               nullptr,
+                               l_b.data() );
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationAmr1d< T_real, T_solver >::regrid() {
+  m_nStepsRegrid = 0;
+
+  // the new levels are built from the coarsest to the finest, each from the indicator on the already rebuilt coarser level
+  for( unsigned short l_le = 0; l_le+1 < m_nLevels; l_le++ ) {
+    t_idx l_nCellsLevel = m_nCells << l_le;
+    t_idx l_nBlocks = (l_nCellsLevel + m_blockSize-1) / m_blockSize;
+    T_real l_factor = T_real( t_idx(1) << l_le );
+
+    // flag the blocks with large jumps of the water surface, including a buffer of cells
+    std::vector< unsigned char > l_flags( l_nBlocks, 0 );
+    for( Patch & l_patch : m_levels[l_le] ) {
+      T_real const * l_h = l_patch.m_patch->getHeight();
+      T_real const * l_b = l_patch.m_patch->getBathymetry();
+
+      for( t_idx l_ce = 0; l_ce+1 < l_patch.m_nCells; l_ce++ ) {
+        T_real l_jump = std::abs( (l_h[l_ce+1] + l_b[l_ce+1]) - (l_h[l_ce] + l_b[l_ce]) );
+        if( l_jump * l_factor > m_threshold ) {
+          t_idx l_first = l_patch.m_first + l_ce;
+          l_first = (l_first > m_regridInterval) ? l_first - m_regridInterval : 0;
+          t_idx l_last = std::min( l_patch.m_first + l_ce+1 + m_regridInterval, l_nCellsLevel-1 );
+
+          for( t_idx l_bl = l_first / m_blockSize; l_bl <= l_last / m_blockSize; l_bl++ ) {
+            l_flags[l_bl] = 1;
+          }
+        }
+      }
+    }
+
+    // proper nesting: a block needs a cell of this level to each side, unless it touches the domain's boundary
+    for( t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++ ) {
+      if( !l_flags[l_bl] ) continue;
+
+      t_idx l_first = l_bl * m_blockSize;
+      t_idx l_end = std::min( l_first + m_blockSize, l_nCellsLevel );
+
+      t_idx l_paId = findPatch( l_le, l_first );
+      bool l_nested = l_paId < m_levels[l_le].size();
+      if( l_nested ) {
+        Patch const & l_patch = m_levels[l_le][l_paId];
+        t_idx l_endPatch = l_patch.m_first + l_patch.m_nCells;
+
+        l_nested =    ( l_first == 0 || l_first > l_patch.m_first )
+                   && ( l_end == l_nCellsLevel || l_end < l_endPatch )
+                   && l_end <= l_endPatch;
+      }
+      if( !l_nested ) l_flags[l_bl] = 0;
+    }
+
+    // merge consecutive blocks to patches of the finer level
+    std::vector< Patch > l_old;
+    l_old.swap( m_levels[l_le+1] );
+
+    for( t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++ ) {
+      if( !l_flags[l_bl] ) continue;
+
+      t_idx l_blEnd = l_bl;
+      while( l_blEnd < l_nBlocks && l_flags[l_blEnd] ) l_blEnd++;
+
+      Patch l_patch = { 2 * l_bl * m_blockSize,
+                        2 * ( std::min( l_blEnd * m_blockSize, l_nCellsLevel ) - l_bl * m_blockSize ),
+                        nullptr };
+      l_bl = l_blEnd;
+
+      // reuse an unchanged patch
+      for( Patch & l_pOld : l_old ) {
+        if( l_pOld.m_patch != nullptr && l_pOld.m_first == l_patch.m_first && l_pOld.m_nCells == l_patch.m_nCells ) {
+          l_patch.m_patch = l_pOld.m_patch;
+          l_pOld.m_patch = nullptr;
+        }
+      }
+
+      if( l_patch.m_patch == nullptr ) {
+        l_patch.m_patch = new t_patch( l_patch.m_nCells );
+        initPatch( l_le+1,
+                   l_old,
+                   l_patch );
+      }
+
+      m_levels[l_le+1].push_back( l_patch );
+    }
+
+    for( Patch & l_pOld : l_old ) {
+      delete l_pOld.m_patch;
+    }
+  }
+}
+
+template class tsunami_lab::patches::WavePropagationAmr1d< float,  tsunami_lab::solvers::Roe< float > >;
+template class tsunami_lab::patches::WavePropagationAmr1d< double, tsunami_lab::solvers::Roe< double > >;
+template class tsunami_lab::patches::WavePropagationAmr1d< float,  tsunami_lab::solvers::FWave< float > >;
+template class tsunami_lab::patches::WavePropagationAmr1d< double, tsunami_lab::solvers::FWave< double > >;
+template class tsunami_lab::patches::WavePropagationAmr1d< float,  tsunami_lab::solvers::Hll< float > >;
+template class tsunami_lab::patches::WavePropagationAmr1d< double, tsunami_lab::solvers::Hll< double > >;
@@ -0,0 +1,455 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Block-structured adaptive mesh refinement of one-dimensional wave propagation patches.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_AMR_1D
+#define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_AMR_1D
+
+#include "../constants.h"
+#include "WavePropagation1d.h"
+#include <string>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace patches {
+    template< typename T_real = t_real,
+              typename T_solver = solvers::Roe< T_real > >
+    class WavePropagationAmr1d;
+  }
+}
+
+/**
+ * Hierarchy of one-dimensional wave propagation patches with a refinement ratio of two between consecutive levels.
+ *
+ * Level 0 is a single patch which covers the domain.
+ * Every finer level consists of patches which are unions of blocks of m_blockSize cells of the next coarser level.
+ * The patches are properly nested: each one lies inside a patch of the next coarser level
+ * with at least one cell of that level to each side, unless it touches the domain's boundary.
+ *
+ * All levels advance with the same time step, which the finest level limits.
+ * In every time step:
+ *   1) The ghost cells of the fine patches are set to the adjacent cells of the next coarser level.
+ *   2) All patches advance independently.
+ *   3) From the finest to the coarsest level, the fine cells are averaged onto the coarse cells which they cover (restriction)
+ *      and the coarse cells adjacent to the fine patches are corrected by the difference of the fine and the coarse net-updates
+ *      at the shared edges (refluxing). The hierarchy's mass thus is conserved.
+ * Level 0 always holds the average of the finest data, which is what the getters return.
+ * The finest data itself is available at the resolution of the finest level through getFinest.
+ *
+ * The hierarchy is rebuilt every m_regridInterval time steps, from the coarsest to the finest level.
+ * A cell is flagged if the jump of the water surface h + b to a neighbor, scaled by the level's refinement factor,
+ * exceeds the threshold; for flat bathymetry the indicator is the gradient of h in units of level-0 cells.
+ * The blocks which contain flagged cells or cells within m_regridInterval cells of them are refined,
+ * which covers the distance fronts travel until the next regrid.
+ * Blocks without flags are coarsened by dropping their fine patches.
+ * New fine cells are prolongated from the coarse cells through minmod-limited linear reconstructions of the water surface,
+ * the momentum and the bathymetry; the fine cells average to the coarse cells, i.e., the prolongation is conservative.
+ **/
+template< typename T_real,
+          typename T_solver >
+class tsunami_lab::patches::WavePropagationAmr1d {
+  public:
+    //! floating point type of the hierarchy
+    typedef T_real t_realPatch;
+
+    //! type of the patches
+    typedef WavePropagation1d< T_real, T_solver > t_patch;
+
+  private:
+    //! patch of a level
+    struct Patch {
+      //! first cell of the patch in the index space of the level
+      t_idx m_first;
+      //! number of cells of the patch
+      t_idx m_nCells;
+      //! wave propagation patch, owned by the hierarchy
+      t_patch * m_patch;
+    };
+
+    //! correction of a coarse cell adjacent to a fine patch, derived before the time step
+    struct Correction {
+      //! id of the coarse patch
+      t_idx m_patch;
+      //! id of the cell in the coarse patch
+      t_idx m_cell;
+      //! difference of the fine and the coarse net-updates at the shared edge; 0: height, 1: momentum
+      T_real m_netUpdates[2];
+    };
+
+    //! maximum number of levels
+    unsigned short m_nLevels = 1;
+
+    //! threshold of the refinement indicator
+    T_real m_threshold = 0;
+
+    //! number of cells of the coarser level which form a block of the finer level
+    t_idx m_blockSize = 0;
+
+    //! number of time steps between two regrids
+    t_idx m_regridInterval = 0;
+
+    //! number of time steps since the last regrid
+    t_idx m_nStepsRegrid = 0;
+
+    //! number of cells of level 0
+    t_idx m_nCells = 0;
+
+    //! patches of the levels, sorted by their first cells
+    std::vector< std::vector< Patch > > m_levels;
+
+    /**
+     * Computes the net-updates of a single edge with the solver's batched version.
+     * The results are bitwise-identical to those of the patches' time steps, which the refluxing relies on.
+     *
+     * @param i_hL height of the left side.
+     * @param i_hR height of the right side.
+     * @param i_huL momentum of the left side.
+     * @param i_huR momentum of the right side.
+     * @param i_bL bathymetry of the left side.
+     * @param i_bR bathymetry of the right side.
+     * @param o_netUpdateL will be set to the net-updates for the left side; 0: height, 1: momentum.
+     * @param o_netUpdateR will be set to the net-updates for the right side; 0: height, 1: momentum.
+     **/
+    static void netUpdates( T_real i_hL,
+                            T_real i_hR,
+                            T_real i_huL,
+                            T_real i_huR,
+                            T_real i_bL,
+                            T_real i_bR,
+                            T_real o_netUpdateL[2],
+                            T_real o_netUpdateR[2] ) {
+      T_real * l_netUpdatesL[2] = { o_netUpdateL, o_netUpdateL+1 };
+      T_real * l_netUpdatesR[2] = { o_netUpdateR, o_netUpdateR+1 };
+
+      T_solver::netUpdatesBatch( 1,
+                                 &i_hL,
+                                 &i_hR,
+                                 &i_huL,
+                                 &i_huR,
+                                 &i_bL,
+                                 &i_bR,
+                                 l_netUpdatesL,
+                                 l_netUpdatesR );
+    }
+
+    /**
+     * Finds the patch of a level which contains a cell.
+     *
+     * @param i_level level.
+     * @param i_cell cell in the index space of the level.
+     * @return id of the patch; the number of patches of the level if no patch contains the cell.
+     **/
+    t_idx findPatch( unsigned short i_level,
+                     t_idx          i_cell ) const;
+
+    /**
+     * Sets the ghost cells of the patches of a fine level to the adjacent cells of the next coarser level.
+     * Ghost cells at the domain's boundaries follow outflow conditions.
+     *
+     * @param i_level fine level, at least 1.
+     **/
+    void setGhostCellsCoarse( unsigned short i_level );
+
+    /**
+     * Derives the corrections of the coarse cells adjacent to the patches of a fine level.
+     * Has to be called before the time step since it uses the current values and the ghost cells of the fine patches.
+     *
+     * @param i_level fine level, at least 1.
+     * @param o_corrections will be set to the corrections of the next coarser level's cells.
+     **/
+    void getCorrections( unsigned short            i_level,
+                         std::vector< Correction > & o_corrections );
+
+    /**
+     * Averages the cells of a fine level onto the cells of the next coarser level which they cover.
+     *
+     * @param i_level fine level, at least 1.
+     **/
+    void restrictLevel( unsigned short i_level );
+
+    /**
+     * Sets the values of a new fine patch.
+     * Cells covered by patches of the old fine level are copied, the others are prolongated from the next coarser level.
+     *
+     * @param i_level fine level, at least 1.
+     * @param i_old patches of the fine level before the regrid.
+     * @param io_patch new patch whose values are set.
+     **/
+    void initPatch( unsigned short               i_level,
+                    std::vector< Patch > const & i_old,
+                    Patch                      & io_patch );
+
+    /**
+     * Deletes the patches of all levels except level 0.
+     **/
+    void clearFineLevels();
+
+  public:
+    /**
+     * Constructs the hierarchy with a single patch on level 0.
+     * The fine levels are created by the first regrid, which follows the first time step.
+     *
+     * @param i_nCells number of cells of level 0.
+     * @param i_nLevels maximum number of levels including level 0.
+     * @param i_threshold threshold of the refinement indicator in meters per level-0 cell.
+     * @param i_blockSize number of cells of the coarser level which form a block of the finer level.
+     * @param i_regridInterval number of time steps between two regrids.
+     **/
+    WavePropagationAmr1d( t_idx          i_nCells,
+                          unsigned short i_nLevels,
+                          T_real         i_threshold = 0.1,
+                          t_idx          i_blockSize = 16,
+                          t_idx          i_regridInterval = 4 );
+
+    /**
+     * Destructor which frees all patches.
+     **/
+    ~WavePropagationAmr1d();
+
+    WavePropagationAmr1d( WavePropagationAmr1d const & ) = delete;
+    WavePropagationAmr1d & operator=( WavePropagationAmr1d const & ) = delete;
+
+    /**
+     * Performs a time step on all levels and regrids the hierarchy if due.
+     * The ghost cells of level 0 have to be set before, e.g., through setGhostOutflow.
+     *
+     * @param i_scaling scaling of the time step w.r.t. level 0 (dt / dx_0); level l uses 2^l times the scaling.
+     * @return maximum wave speed of the levels times the refinement factor of the finest level after the regrid;
+     *         bounds the time step in units of level-0 cells.
+     **/
+    T_real timeStep( T_real i_scaling );
+
+    /**
+     * Rebuilds the fine levels from the refinement indicator.
+     **/
+    void regrid();
+
+    /**
+     * Sets the values of level 0's ghost cells according to outflow boundary conditions.
+     **/
+    void setGhostOutflow() {
+      m_levels[0][0].m_patch->setGhostOutflow();
+    }
+
+    /**
+     * Gets the maximum number of levels.
+     *
+     * @return maximum number of levels including level 0.
+     **/
+    unsigned short getNumLevels() const {
+      return m_nLevels;
+    }
+
+    /**
+     * Gets the number of patches of a level.
+     *
+     * @param i_level level.
+     * @return number of patches.
+     **/
+    t_idx getNumPatches( unsigned short i_level ) const {
+      return m_levels[i_level].size();
+    }
+
+    /**
+     * Gets the first cell of a patch in the index space of its level.
+     *
+     * @param i_level level.
+     * @param i_patch id of the patch.
+     * @return first cell.
+     **/
+    t_idx getFirstCell( unsigned short i_level,
+                        t_idx          i_patch ) const {
+      return m_levels[i_level][i_patch].m_first;
+    }
+
+    /**
+     * Gets a patch.
+     *
+     * @param i_level level.
+     * @param i_patch id of the patch.
+     * @return patch.
+     **/
+    t_patch & getPatch( unsigned short i_level,
+                        t_idx          i_patch ) {
+      return *m_levels[i_level][i_patch].m_patch;
+    }
+
+    /**
+     * Gets the total number of cells of all levels.
+     *
+     * @return number of cells.
+     **/
+    t_idx getNumCells() const;
+
+    /**
+     * Gets the stride in y-direction. x-direction is stride-1.
+     *
+     * @return stride in y-direction.
+     **/
+    t_idx getStride() {
+      return m_levels[0][0].m_patch->getStride();
+    }
+
+    /**
+     * Gets the refinement factor of the finest level w.r.t. level 0.
+     *
+     * @return refinement factor, i.e., number of cells of the finest level per cell of level 0.
+     **/
+    t_idx getRefinement() const {
+      return t_idx(1) << (m_nLevels-1);
+    }
+
+    /**
+     * Gets the water heights and momenta of a range of cells at the resolution of the finest level.
+     * Every cell holds the value of the finest patch which covers it; the values of coarser patches are repeated.
+     *
+     * @param i_first first cell in the index space of the finest level.
+     * @param i_nCells number of cells.
+     * @param o_h will be set to the water heights.
+     * @param o_hu will be set to the momenta in x-direction.
+     **/
+    void getFinest( t_idx    i_first,
+                    t_idx    i_nCells,
+                    T_real * o_h,
+                    T_real * o_hu );
+
+    /**
+     * Gets the water heights of level 0.
+     *
+     * @return water heights.
+     **/
+    T_real const * getHeight() {
+      return m_levels[0][0].m_patch->getHeight();
+    }
+
+    /**
+     * Gets the momenta in x-direction of level 0.
+     *
+     * @return momenta in x-direction.
+     **/
+    T_real const * getMomentumX() {
+      return m_levels[0][0].m_patch->getMomentumX();
+    }
+
+    /**
+     * Dummy function which returns a nullptr.
+     **/
+    T_real const * getMomentumY() {
+      return nullptr;
+    }
+
+    /**
+     * Gets the bathymetry of level 0.
+     *
+     * @return bathymetry.
+     **/
+    T_real const * getBathymetry() {
+      return m_levels[0][0].m_patch->getBathymetry();
+    }
+
+    /**
+     * Sets the height of a cell of level 0 and removes the fine levels.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_h water height.
+     **/
+    void setHeight( t_idx  i_ix,
+                    t_idx,
+                    T_real i_h ) {
+      clearFineLevels();
+      m_levels[0][0].m_patch->setHeight( i_ix, 0, i_h );
+    }
+
+    /**
+     * Sets the momentum in x-direction of a cell of level 0 and removes the fine levels.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_hu momentum in x-direction.
+     **/
+    void setMomentumX( t_idx  i_ix,
+                       t_idx,
+                       T_real i_hu ) {
+      clearFineLevels();
+      m_levels[0][0].m_patch->setMomentumX( i_ix, 0, i_hu );
+    }
+
+    /**
+     * Dummy function since there is no y-momentum in the 1d solver.
+     **/
+    void setMomentumY( t_idx,
+                       t_idx,
+                       T_real ) {};
+
+    /**
+     * Sets the bathymetry of a cell of level 0 and removes the fine levels.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_b bathymetry.
+     **/
+    void setBathymetry( t_idx  i_ix,
+                        t_idx,
+                        T_real i_b ) {
+      clearFineLevels();
+      m_levels[0][0].m_patch->setBathymetry( i_ix, 0, i_b );
+    }
+
+    /**
+     * Sets the values of a block of cells of level 0 in bulk and removes the fine levels.
+     *
+     * @param i_ix id of the block's first cell.
+     * @param i_nx number of cells of the block.
+     * @param i_h water heights; optional: use nullptr if not required.
+     * @param i_hu momenta in x-direction; optional: use nullptr if not required.
+     * @param i_b bathymetry; optional: use nullptr if not required.
+     **/
+    void setValues( t_idx                i_ix,
+                    t_idx,
+                    t_idx                i_nx,
+                    t_idx,
+                    t_idx,
+                    T_real       const * i_h,
+                    T_real       const * i_hu,
+                    T_real       const *,
+                    T_real       const * i_b ) {
+      clearFineLevels();
+      m_levels[0][0].m_patch->setValues( i_ix, 0, i_nx, 0, 0, i_h, i_hu, nullptr, i_b );
+    }
+
+    /**
+     * Writes a checkpoint of level 0, which holds the average of the finest data.
+     * The fine levels are not part of the checkpoint; a restart rebuilds them at its first regrid.
+     *
+     * @param i_path path of the checkpoint.
+     * @param i_time simulation time.
+     * @param i_timeStep time step counter.
+     * @param i_speedMax maximum wave speed of the last time step.
+     * @return true if successful, false otherwise.
+     **/
+    bool writeCheckpoint( std::string const & i_path,
+                          T_real              i_time,
+                          t_idx               i_timeStep,
+                          T_real              i_speedMax ) {
+      return m_levels[0][0].m_patch->writeCheckpoint( i_path, i_time, i_timeStep, i_speedMax );
+    }
+
+    /**
+     * Restores level 0 from a checkpoint and removes the fine levels.
+     *
+     * @param i_path path of the checkpoint.
+     * @param o_time will be set to the simulation time.
+     * @param o_timeStep will be set to the time step counter.
+     * @param o_speedMax will be set to the maximum wave speed of the last time step.
+     * @return true if successful, false otherwise; the state is undefined on failure.
+     **/
+    bool readCheckpoint( std::string const & i_path,
+                         T_real            & o_time,
+                         t_idx             & o_timeStep,
+                         T_real            & o_speedMax ) {
+      clearFineLevels();
+      return m_levels[0][0].m_patch->readCheckpoint( i_path, o_time, o_timeStep, o_speedMax );
+    }
+};
+
+#endif
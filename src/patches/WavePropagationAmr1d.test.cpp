@@ -0,0 +1,260 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the adaptive mesh refinement of one-dimensional wave propagation patches.
+ **/
+#include <catch2/catch.hpp>
+#include "WavePropagationAmr1d.h"
+#include "../solvers/FWave.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+  /**
+   * Sets a dam break: height 10 in the left half of the domain and height 5 in the right half.
+   *
+   * @param i_nCells number of cells.
+   * @param io_waveProp patch or hierarchy whose cells are set.
+   **/
+  template< typename T_waveProp >
+  void setDamBreak( tsunami_lab::t_idx   i_nCells,
+                    T_waveProp         & io_waveProp ) {
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < i_nCells; l_ce++ ) {
+      io_waveProp.setHeight( l_ce,
+                             0,
+                             (l_ce < i_nCells / 2) ? 10 : 5 );
+      io_waveProp.setMomentumX( l_ce,
+                                0,
+                                0 );
+    }
+  }
+}
+
+TEST_CASE( "Test the adaptive mesh refinement with a single level.", "[WavePropAmr1dSingleLevel]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break in a hierarchy without fine levels.
+   *   The hierarchy has to match a single patch bitwise.
+   */
+  tsunami_lab::patches::WavePropagationAmr1d< double > l_amr( 200,
+                                                             1 );
+  tsunami_lab::patches::WavePropagation1d< double > l_waveProp( 200 );
+  setDamBreak( 200, l_amr );
+  setDamBreak( 200, l_waveProp );
+
+  for( unsigned short l_st = 0; l_st < 50; l_st++ ) {
+    l_amr.setGhostOutflow();
+    l_waveProp.setGhostOutflow();
+    double l_speedAmr = l_amr.timeStep( 0.04 );
+    double l_speed = l_waveProp.timeStep( 0.04 );
+    REQUIRE( l_speedAmr == l_speed );
+  }
+
+  REQUIRE( l_amr.getNumPatches( 0 ) == 1 );
+  REQUIRE( l_amr.getNumCells() == 200 );
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 200; l_ce++ ) {
+    REQUIRE( l_amr.getHeight()[l_ce] == l_waveProp.getHeight()[l_ce] );
+    REQUIRE( l_amr.getMomentumX()[l_ce] == l_waveProp.getMomentumX()[l_ce] );
+  }
+}
+
+TEST_CASE( "Test the refinement and the conservation of the adaptive mesh refinement.", "[WavePropAmr1dRefinement]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break in the middle of 256 cells with three levels.
+   *   The first regrid refines the dam on both fine levels; the patches are properly nested.
+   *   The mass of the hierarchy, i.e., that of level 0, is conserved until the waves reach the boundaries.
+   */
+  tsunami_lab::t_idx l_nCells = 256;
+  tsunami_lab::patches::WavePropagationAmr1d< double > l_amr( l_nCells,
+                                                             3,
+                                                             0.1,
+                                                             8,
+                                                             4 );
+  setDamBreak( l_nCells, l_amr );
+
+  double l_massInit = 0;
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) l_massInit += l_amr.getHeight()[l_ce];
+
+  // CFL number of 0.5 w.r.t. the finest level
+  double l_speedMax = std::sqrt( 9.81 * 10 ) * 4;
+
+  for( unsigned short l_st = 0; l_st < 100; l_st++ ) {
+    l_amr.setGhostOutflow();
+    l_speedMax = l_amr.timeStep( 0.5 / l_speedMax );
+
+    if( l_st == 0 ) {
+      // the dam is located at the edge between the cells 128 and 129 of level 0
+      for( unsigned short l_le = 1; l_le < 3; l_le++ ) {
+        REQUIRE( l_amr.getNumPatches( l_le ) == 1 );
+        tsunami_lab::t_idx l_first = l_amr.getFirstCell( l_le, 0 );
+        tsunami_lab::t_idx l_nCellsPatch = l_amr.getPatch( l_le, 0 ).getStride() - 2;
+        REQUIRE( l_first < (l_nCells / 2) << l_le );
+        REQUIRE( l_first + l_nCellsPatch > (l_nCells / 2) << l_le );
+      }
+      REQUIRE( l_amr.getNumCells() < l_nCells * 3 );
+    }
+
+    // proper nesting of all patches
+    for( unsigned short l_le = 2; l_le < 3; l_le++ ) {
+      for( tsunami_lab::t_idx l_pa = 0; l_pa < l_amr.getNumPatches( l_le ); l_pa++ ) {
+        tsunami_lab::t_idx l_first = l_amr.getFirstCell( l_le, l_pa ) / 2;
+        tsunami_lab::t_idx l_end = l_first + (l_amr.getPatch( l_le, l_pa ).getStride() - 2) / 2;
+
+        bool l_nested = false;
+        for( tsunami_lab::t_idx l_co = 0; l_co < l_amr.getNumPatches( l_le-1 ); l_co++ ) {
+          tsunami_lab::t_idx l_firstCo = l_amr.getFirstCell( l_le-1, l_co );
+          tsunami_lab::t_idx l_endCo = l_firstCo + l_amr.getPatch( l_le-1, l_co ).getStride() - 2;
+          l_nested = l_nested || ( l_firstCo < l_first && l_end < l_endCo );
+        }
+        REQUIRE( l_nested );
+      }
+    }
+
+    double l_mass = 0;
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) l_mass += l_amr.getHeight()[l_ce];
+    REQUIRE( l_mass == Approx( l_massInit ).epsilon( 1E-13 ) );
+  }
+
+  // the fronts left the refined region of the first regrid
+  REQUIRE( l_amr.getHeight()[l_nCells / 2] < 9 );
+  REQUIRE( l_amr.getHeight()[l_nCells / 2] > 6 );
+
+  // the finest data averages to level 0
+  REQUIRE( l_amr.getRefinement() == 4 );
+  std::vector< double > l_h( l_nCells * 4 );
+  std::vector< double > l_hu( l_nCells * 4 );
+  l_amr.getFinest( 0,
+                   l_nCells * 4,
+                   l_h.data(),
+                   l_hu.data() );
+
+  bool l_resolved = false;
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+    double l_hAvg = 0;
+    double l_huAvg = 0;
+    for( unsigned short l_fi = 0; l_fi < 4; l_fi++ ) {
+      l_hAvg += 0.25 * l_h[l_ce*4 + l_fi];
+      l_huAvg += 0.25 * l_hu[l_ce*4 + l_fi];
+    }
+    REQUIRE( l_hAvg == Approx( l_amr.getHeight()[l_ce] ) );
+    REQUIRE( l_huAvg == Approx( l_amr.getMomentumX()[l_ce] ).margin( 1E-12 ) );
+    l_resolved = l_resolved || l_h[l_ce*4] != l_h[l_ce*4 + 3];
+  }
+  REQUIRE( l_resolved );
+
+  // subranges match
+  std::vector< double > l_hSub( 5 );
+  std::vector< double > l_huSub( 5 );
+  l_amr.getFinest( 509,
+                   5,
+                   l_hSub.data(),
+                   l_huSub.data() );
+  for( unsigned short l_ce = 0; l_ce < 5; l_ce++ ) {
+    REQUIRE( l_hSub[l_ce] == l_h[509 + l_ce] );
+    REQUIRE( l_huSub[l_ce] == l_hu[509 + l_ce] );
+  }
+}
+
+TEST_CASE( "Test the accuracy of the adaptive mesh refinement.", "[WavePropAmr1dAccuracy]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break with 128 cells on level 0 and three levels, compared to uniform grids of 128 and 512 cells.
+   *   All grids use the same time step, which is stable for 512 cells.
+   *   The hierarchy has to be much closer to the fine uniform grid than the coarse uniform grid.
+   */
+  tsunami_lab::patches::WavePropagationAmr1d< double > l_amr( 128,
+                                                             3,
+                                                             0.1,
+                                                             8,
+                                                             4 );
+  tsunami_lab::patches::WavePropagation1d< double > l_coarse( 128 );
+  tsunami_lab::patches::WavePropagation1d< double > l_fine( 512 );
+  setDamBreak( 128, l_amr );
+  setDamBreak( 128, l_coarse );
+  setDamBreak( 512, l_fine );
+
+  // dt / dx of level 0
+  double l_scaling = 0.5 / (11 * 4);
+
+  for( unsigned short l_st = 0; l_st < 200; l_st++ ) {
+    l_amr.setGhostOutflow();
+    l_coarse.setGhostOutflow();
+    l_fine.setGhostOutflow();
+
+    l_amr.timeStep( l_scaling );
+    l_coarse.timeStep( l_scaling );
+    l_fine.timeStep( l_scaling * 4 );
+  }
+
+  double l_errorAmr = 0;
+  double l_errorCoarse = 0;
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 128; l_ce++ ) {
+    double l_hFine = 0;
+    for( unsigned short l_ch = 0; l_ch < 4; l_ch++ ) l_hFine += 0.25 * l_fine.getHeight()[4*l_ce + l_ch];
+
+    l_errorAmr += std::abs( l_amr.getHeight()[l_ce] - l_hFine );
+    l_errorCoarse += std::abs( l_coarse.getHeight()[l_ce] - l_hFine );
+  }
+
+  REQUIRE( l_errorAmr < 0.5 * l_errorCoarse );
+  REQUIRE( l_amr.getNumCells() < 128 + 512 );
+}
+
+TEST_CASE( "Test the coarsening of the adaptive mesh refinement.", "[WavePropAmr1dCoarsening]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break with 64 cells on level 0 and two levels.
+   *   After the waves left the domain through the outflow boundaries, the state is uniform and the fine level is removed.
+   */
+  tsunami_lab::patches::WavePropagationAmr1d< double > l_amr( 64,
+                                                             2,
+                                                             0.1,
+                                                             8,
+                                                             4 );
+  setDamBreak( 64, l_amr );
+
+  double l_speedMax = std::sqrt( 9.81 * 10 ) * 2;
+  bool l_refined = false;
+  for( unsigned short l_st = 0; l_st < 1000; l_st++ ) {
+    l_amr.setGhostOutflow();
+    l_speedMax = l_amr.timeStep( 0.5 / l_speedMax );
+    l_refined = l_refined || l_amr.getNumPatches( 1 ) > 0;
+  }
+
+  REQUIRE( l_refined );
+  REQUIRE( l_amr.getNumPatches( 1 ) == 0 );
+  REQUIRE( l_amr.getNumCells() == 64 );
+}
+
+TEST_CASE( "Test the refinement indicator of the adaptive mesh refinement for lakes at rest.", "[WavePropAmr1dLakeAtRest]" ) {
+  /*
+   * Test case:
+   *
+   *   Lake at rest over a sloping bathymetry with the f-wave solver.
+   *   The indicator uses the water surface, which is flat, thus no cell is refined and the lake stays at rest.
+   */
+  tsunami_lab::patches::WavePropagationAmr1d< double, tsunami_lab::solvers::FWave< double > > l_amr( 100,
+                                                                                                    3 );
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 100; l_ce++ ) {
+    l_amr.setBathymetry( l_ce, 0, -20 + 0.1 * l_ce );
+    l_amr.setHeight( l_ce, 0, 20 - 0.1 * l_ce );
+    l_amr.setMomentumX( l_ce, 0, 0 );
+  }
+
+  for( unsigned short l_st = 0; l_st < 10; l_st++ ) {
+    l_amr.setGhostOutflow();
+    l_amr.timeStep( 0.01 );
+  }
+
+  REQUIRE( l_amr.getNumPatches( 1 ) == 0 );
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 100; l_ce++ ) {
+    REQUIRE( l_amr.getHeight()[l_ce] + l_amr.getBathymetry()[l_ce] == Approx( 0 ).margin( 1E-12 ) );
+    REQUIRE( l_amr.getMomentumX()[l_ce] == Approx( 0 ).margin( 1E-12 ) );
+  }
+}
@@ -0,0 +1,154 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the one-dimensional wave propagation patch with single precision storage.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "WavePropagationCompact1d.h"
+#include "WavePropagation1d.h"
+#include "../setups/DamBreak1d.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+  /**
+   * Measures time steps of a dam break problem in a patch.
+   *
+   * @param io_benchmark benchmark which records the results.
+   * @param i_name name of the result.
+   * @param i_nCells number of cells.
+   * @param io_patch patch which is measured.
+   *
+   * @tparam T_patch type of the patch.
+   **/
+  template< typename T_patch >
+  void measure( tsunami_lab::benchmarks::Benchmark & io_benchmark,
+                std::string const                  & i_name,
+                tsunami_lab::t_idx                   i_nCells,
+                T_patch                            & io_patch ) {
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < i_nCells; l_ce++ ) {
+      io_patch.setHeight( l_ce,
+                          0,
+                          (l_ce < i_nCells / 2) ? 10 : 5 );
+    }
+
+    double l_seconds = io_benchmark.measure( [&]() {
+      io_patch.setGhostOutflow();
+      io_patch.timeStep( 0.01f );
+    } );
+
+    io_benchmark.report( i_name + "::timeStep/" + std::to_string( i_nCells ),
+                         "MLUPS",
+                         i_nCells / l_seconds * 1E-6 );
+  }
+
+  /**
+   * Measures time steps of dam break problems for grid sizes from L2-resident to DRAM-bound.
+   * The compact patch computes in double precision and is compared to the uncompressed patch in double and single precision.
+   * The uncompressed patches are measured without active-region tracking, which the compact patch does not have.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void runThroughput( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    for( tsunami_lab::t_idx l_nCells : { tsunami_lab::t_idx(1) << 16,
+                                         tsunami_lab::t_idx(1) << 19,
+                                         tsunami_lab::t_idx(1) << 22 } ) {
+      tsunami_lab::patches::WavePropagationCompact1d< double > l_compact( l_nCells );
+      measure( io_benchmark,
+               "WavePropagationCompact1d<double>",
+               l_nCells,
+               l_compact );
+
+      tsunami_lab::patches::WavePropagation1d< double > l_waveProp( l_nCells );
+      l_waveProp.setTracking( false );
+      measure( io_benchmark,
+               "WavePropagation1d<double>",
+               l_nCells,
+               l_waveProp );
+
+      tsunami_lab::patches::WavePropagation1d< float > l_waveProp32( l_nCells );
+      l_waveProp32.setTracking( false );
+      measure( io_benchmark,
+               "WavePropagation1d<float>",
+               l_nCells,
+               l_waveProp32 );
+    }
+  }
+
+  /**
+   * Simulates the dam break of the standalone application, i.e., the DamBreak1d setup with heights 10 and 5,
+   * with single precision storage and with double precision storage until the waves are about to reach the boundaries.
+   * Both patches advance with the same time steps, derived from the wave speeds of the double precision patch.
+   * Reports the L1 and maximum errors of the heights and momenta w.r.t. the double precision solution.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void runAccuracy( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    tsunami_lab::setups::DamBreak1d l_setup( 10,
+                                             5,
+                                             5 );
+    // the rarefaction's head reaches the left boundary at about t = 0.5
+    double l_endTime = 0.4;
+    double l_cfl = 0.5;
+
+    for( tsunami_lab::t_idx l_nCells : { tsunami_lab::t_idx(1) << 10,
+                                         tsunami_lab::t_idx(1) << 12 } ) {
+      double l_dxy = 10.0 / l_nCells;
+
+      tsunami_lab::patches::WavePropagationCompact1d< double > l_compact( l_nCells );
+      tsunami_lab::patches::WavePropagation1d< double > l_waveProp( l_nCells );
+      for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+        double l_x = ( l_ce + 0.5 ) * l_dxy;
+        l_compact.setHeight( l_ce, 0, l_setup.getHeight( l_x, 0 ) );
+        l_waveProp.setHeight( l_ce, 0, l_setup.getHeight( l_x, 0 ) );
+      }
+
+      double l_dt = l_cfl * l_dxy / std::sqrt( 9.80665 * 10 );
+      double l_simTime = 0;
+      while( l_simTime < l_endTime ) {
+        l_dt = std::min( l_dt, l_endTime - l_simTime );
+        l_compact.setGhostOutflow();
+        l_waveProp.setGhostOutflow();
+        // the compact patch's interface takes the scaling in the precision t_real
+        tsunami_lab::t_real l_scaling = l_dt / l_dxy;
+        l_compact.timeStep( l_scaling );
+        double l_speedMax = l_waveProp.timeStep( l_scaling );
+        l_simTime += l_dt;
+        if( l_speedMax > 0 ) l_dt = l_cfl * l_dxy / l_speedMax;
+      }
+
+      double l_errorL1[2] = { 0, 0 };
+      double l_errorMax[2] = { 0, 0 };
+      for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+        double l_errors[2] = { std::abs( double( l_compact.getHeight()[l_ce] )    - l_waveProp.getHeight()[l_ce] ),
+                               std::abs( double( l_compact.getMomentumX()[l_ce] ) - l_waveProp.getMomentumX()[l_ce] ) };
+        for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+          l_errorL1[l_qt] += l_errors[l_qt] * l_dxy;
+          l_errorMax[l_qt] = std::max( l_errorMax[l_qt], l_errors[l_qt] );
+        }
+      }
+
+      std::string l_prefix = "DamBreak1d/" + std::to_string( l_nCells );
+      io_benchmark.report( l_prefix + "/h/L1",    "m^2",   l_errorL1[0] );
+      io_benchmark.report( l_prefix + "/h/max",   "m",     l_errorMax[0] );
+      io_benchmark.report( l_prefix + "/hu/L1",   "m^3/s", l_errorL1[1] );
+      io_benchmark.report( l_prefix + "/hu/max",  "m^2/s", l_errorMax[1] );
+    }
+  }
+
+  /**
+   * Runs the case.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    runThroughput( io_benchmark );
+    runAccuracy( io_benchmark );
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "WavePropagationCompact1d",
+                                                                         run );
+}
@@ -0,0 +1,357 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * One-dimensional wave propagation patch with single precision storage.
+ **/
+#include "WavePropagationCompact1d.h"
+#include "../solvers/FWave.h"
+#include "../solvers/Hll.h"
+#include "../io/Checkpoint.h"
+#include "../memory/Allocator.h"
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::WavePropagationCompact1d( t_idx i_nCells ) {
+  m_nCells = i_nCells;
+  m_nTiles = (m_nCells + m_tileSize-1) / m_tileSize;
+
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    m_h[l_st]  = memory::Allocator::allocate< float >( m_nCells );
+    m_hu[l_st] = memory::Allocator::allocate< float >( m_nCells );
+    m_hRef[l_st]  = memory::Allocator::allocate< T_real >( m_nTiles );
+    m_huRef[l_st] = memory::Allocator::allocate< T_real >( m_nTiles );
+  }
+  m_b = memory::Allocator::allocate< T_real >( m_nCells + 2 );
+  m_bCopy = memory::Allocator::allocate< t_real >( m_nCells );
+  m_hDecoded  = memory::Allocator::allocate< t_real >( m_nCells );
+  m_huDecoded = memory::Allocator::allocate< t_real >( m_nCells );
+
+  // scratch memory of a tile per thread, which is reused by all time steps
+#ifdef _OPENMP
+  m_nThreads = omp_get_max_threads();
+#endif
+  m_scratch = memory::Allocator::allocate< T_real >( m_nThreads * getScratchSize() );
+
+#pragma omp parallel num_threads( m_nThreads )
+  {
+    // first touch: the encoded zeros, references and decoded values of a tile are written by the thread which steps the tile
+#pragma omp for schedule(static)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      t_idx l_first = l_ti * m_tileSize;
+      t_idx l_nCellsTile = getNumCellsTile( l_ti );
+
+      for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+        std::fill_n( m_h[l_st] + l_first,  l_nCellsTile, 0.0f );
+        std::fill_n( m_hu[l_st] + l_first, l_nCellsTile, 0.0f );
+        m_hRef[l_st][l_ti] = 0;
+        m_huRef[l_st][l_ti] = 0;
+      }
+      std::fill_n( m_b + l_first+1,       l_nCellsTile, T_real(0) );
+      std::fill_n( m_bCopy + l_first,     l_nCellsTile, t_real(0) );
+      std::fill_n( m_hDecoded + l_first,  l_nCellsTile, t_real(0) );
+      std::fill_n( m_huDecoded + l_first, l_nCellsTile, t_real(0) );
+    }
+
+    // every thread touches its own scratch memory
+    T_real * l_h = nullptr;
+    T_real * l_hu = nullptr;
+    T_real * l_netUpdatesL[2] = { nullptr, nullptr };
+    T_real * l_netUpdatesR[2] = { nullptr, nullptr };
+    getScratch( l_h,
+                l_hu,
+                l_netUpdatesL,
+                l_netUpdatesR );
+    std::fill_n( l_h, getScratchSize(), T_real(0) );
+  }
+  m_b[0] = m_b[m_nCells+1] = 0;
+}
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::~WavePropagationCompact1d() {
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    memory::Allocator::free( m_h[l_st] );
+    memory::Allocator::free( m_hu[l_st] );
+    memory::Allocator::free( m_hRef[l_st] );
+    memory::Allocator::free( m_huRef[l_st] );
+  }
+  memory::Allocator::free( m_b );
+  memory::Allocator::free( m_bCopy );
+  memory::Allocator::free( m_scratch );
+  memory::Allocator::free( m_hDecoded );
+  memory::Allocator::free( m_huDecoded );
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::getScratch( T_real *& o_h,
+                                                                                     T_real *& o_hu,
+                                                                                     T_real *  o_netUpdatesL[2],
+                                                                                     T_real *  o_netUpdatesR[2] ) {
+  t_idx l_th = 0;
+#ifdef _OPENMP
+  l_th = omp_get_thread_num();
+#endif
+  T_real * l_scratch = m_scratch + l_th * getScratchSize();
+
+  o_h  = l_scratch;
+  o_hu = l_scratch + (m_tileSize+2);
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    o_netUpdatesL[l_qt] = l_scratch + 2 * (m_tileSize+2) + l_qt * (m_tileSize+1);
+    o_netUpdatesR[l_qt] = l_scratch + 2 * (m_tileSize+2) + (2+l_qt) * (m_tileSize+1);
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+template< typename T_value >
+void tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::encodeTile( T_value const * i_values,
+                                                                                     t_idx           i_nCells,
+                                                                                     float         * o_values,
+                                                                                     T_real        & o_ref ) {
+  // the midpoint minimizes the largest offset
+  T_real l_min = i_values[0];
+  T_real l_max = i_values[0];
+  for( t_idx l_ce = 1; l_ce < i_nCells; l_ce++ ) {
+    l_min = std::min( l_min, T_real( i_values[l_ce] ) );
+    l_max = std::max( l_max, T_real( i_values[l_ce] ) );
+  }
+  o_ref = T_real(0.5) * ( l_min + l_max );
+
+  for( t_idx l_ce = 0; l_ce < i_nCells; l_ce++ ) {
+    o_values[l_ce] = float( i_values[l_ce] - o_ref );
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::decode() {
+  if( m_decoded ) return;
+
+#pragma omp parallel for num_threads( m_nThreads ) schedule(static)
+  for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+    t_idx l_first = l_ti * m_tileSize;
+    t_idx l_nCellsTile = getNumCellsTile( l_ti );
+    T_real l_hRef  = m_hRef[m_step][l_ti];
+    T_real l_huRef = m_huRef[m_step][l_ti];
+
+    for( t_idx l_ce = l_first; l_ce < l_first + l_nCellsTile; l_ce++ ) {
+      m_hDecoded[l_ce]  = t_real( l_hRef  + T_real( m_h[m_step][l_ce] ) );
+      m_huDecoded[l_ce] = t_real( l_huRef + T_real( m_hu[m_step][l_ce] ) );
+    }
+  }
+  m_decoded = true;
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::encode() {
+  if( !m_dirty ) return;
+
+#pragma omp parallel for num_threads( m_nThreads ) schedule(static)
+  for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+    t_idx l_first = l_ti * m_tileSize;
+    t_idx l_nCellsTile = getNumCellsTile( l_ti );
+
+    encodeTile( m_hDecoded + l_first,  l_nCellsTile, m_h[m_step] + l_first,  m_hRef[m_step][l_ti] );
+    encodeTile( m_huDecoded + l_first, l_nCellsTile, m_hu[m_step] + l_first, m_huRef[m_step][l_ti] );
+  }
+  m_nStepsRebase = 0;
+  m_dirty = false;
+}
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::t_real tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::timeStep( t_real i_scaling ) {
+  // changes of the decoded copy enter the time step; the copy is outdated afterwards
+  encode();
+
+  float const * l_hOld = m_h[m_step];
+  float const * l_huOld = m_hu[m_step];
+  T_real const * l_hRefOld = m_hRef[m_step];
+  T_real const * l_huRefOld = m_huRef[m_step];
+
+  unsigned short l_stepNew = (m_step+1) % 2;
+  float * l_hNew = m_h[l_stepNew];
+  float * l_huNew = m_hu[l_stepNew];
+  T_real * l_hRefNew = m_hRef[l_stepNew];
+  T_real * l_huRefNew = m_huRef[l_stepNew];
+
+  // the references are derived anew from the new quantities in every m_rebaseInterval-th time step and kept otherwise
+  m_nStepsRebase++;
+  bool l_rebase = m_nStepsRebase == m_rebaseInterval;
+  if( l_rebase ) m_nStepsRebase = 0;
+
+  T_real l_scaling = i_scaling;
+
+  // maximum wave speed of all edges
+  T_real l_speedMax = 0;
+
+#pragma omp parallel num_threads( m_nThreads ) reduction(max:l_speedMax)
+  {
+    // quantities of a tile including one neighboring cell on each side and the net-updates of its edges
+    T_real * l_h = nullptr;
+    T_real * l_hu = nullptr;
+    T_real * l_netUpdatesL[2] = { nullptr, nullptr };
+    T_real * l_netUpdatesR[2] = { nullptr, nullptr };
+    getScratch( l_h,
+                l_hu,
+                l_netUpdatesL,
+                l_netUpdatesR );
+
+#pragma omp for schedule(static)
+    for( t_idx l_ti = 0; l_ti < m_nTiles; l_ti++ ) {
+      t_idx l_first = l_ti * m_tileSize;
+      t_idx l_nCellsTile = getNumCellsTile( l_ti );
+      t_idx l_end = l_first + l_nCellsTile;
+      T_real l_hRef  = l_hRefOld[l_ti];
+      T_real l_huRef = l_huRefOld[l_ti];
+
+      // local cell i is cell l_first+i-1 of the patch; the neighbors are decoded w.r.t. their tiles' references
+      l_h[0]  = (l_ti == 0) ? m_hGhost[0]  : decodeCell( l_hOld,  l_hRefOld,  l_first-1 );
+      l_hu[0] = (l_ti == 0) ? m_huGhost[0] : decodeCell( l_huOld, l_huRefOld, l_first-1 );
+
+#pragma omp simd
+      for( t_idx l_ce = 0; l_ce < l_nCellsTile; l_ce++ ) {
+        l_h[l_ce+1]  = l_hRef  + T_real( l_hOld[l_first + l_ce] );
+        l_hu[l_ce+1] = l_huRef + T_real( l_huOld[l_first + l_ce] );
+      }
+
+      l_h[l_nCellsTile+1]  = (l_ti+1 == m_nTiles) ? m_hGhost[1]  : decodeCell( l_hOld,  l_hRefOld,  l_end );
+      l_hu[l_nCellsTile+1] = (l_ti+1 == m_nTiles) ? m_huGhost[1] : decodeCell( l_huOld, l_huRefOld, l_end );
+
+      // edge i is located between the local cells i and i+1
+      T_real l_speed = T_solver::netUpdatesBatch( l_nCellsTile+1,
+                                                  l_h,
+                                                  l_h+1,
+                                                  l_hu,
+                                                  l_hu+1,
+                                                  m_b + l_first,
+                                                  m_b + l_first+1,
+                                                  l_netUpdatesL,
+                                                  l_netUpdatesR );
+      l_speedMax = std::max( l_speed, l_speedMax );
+
+      if( !l_rebase ) {
+        // same update as in the uncompressed patch, encoded w.r.t. the unchanged references
+        l_hRefNew[l_ti]  = l_hRef;
+        l_huRefNew[l_ti] = l_huRef;
+
+#pragma omp simd
+        for( t_idx l_ce = 1; l_ce <= l_nCellsTile; l_ce++ ) {
+          T_real l_hUpd  = l_h[l_ce]  - l_scaling * l_netUpdatesR[0][l_ce-1] - l_scaling * l_netUpdatesL[0][l_ce];
+          T_real l_huUpd = l_hu[l_ce] - l_scaling * l_netUpdatesR[1][l_ce-1] - l_scaling * l_netUpdatesL[1][l_ce];
+
+          l_hNew[l_first + l_ce-1]  = float( l_hUpd  - l_hRef );
+          l_huNew[l_first + l_ce-1] = float( l_huUpd - l_huRef );
+        }
+      }
+      else {
+        for( t_idx l_ce = 1; l_ce <= l_nCellsTile; l_ce++ ) {
+          l_h[l_ce]  = l_h[l_ce]  - l_scaling * l_netUpdatesR[0][l_ce-1] - l_scaling * l_netUpdatesL[0][l_ce];
+          l_hu[l_ce] = l_hu[l_ce] - l_scaling * l_netUpdatesR[1][l_ce-1] - l_scaling * l_netUpdatesL[1][l_ce];
+        }
+
+        encodeTile( l_h+1,  l_nCellsTile, l_hNew + l_first,  l_hRefNew[l_ti] );
+        encodeTile( l_hu+1, l_nCellsTile, l_huNew + l_first, l_huRefNew[l_ti] );
+      }
+    }
+  }
+
+  m_step = l_stepNew;
+  m_decoded = false;
+
+  // outflow boundary conditions for the new quantities
+  setGhostOutflow();
+
+  return l_speedMax;
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::setGhostOutflow() {
+  // the ghost cells are derived from the encoded quantities, which the time step sees
+  encode();
+
+  m_hGhost[0]  = decodeCell( m_h[m_step],  m_hRef[m_step],  0 );
+  m_huGhost[0] = decodeCell( m_hu[m_step], m_huRef[m_step], 0 );
+  m_hGhost[1]  = decodeCell( m_h[m_step],  m_hRef[m_step],  m_nCells-1 );
+  m_huGhost[1] = decodeCell( m_hu[m_step], m_huRef[m_step], m_nCells-1 );
+
+  m_b[0] = m_b[1];
+  m_b[m_nCells+1] = m_b[m_nCells];
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::setValues( t_idx                i_ix,
+                                                                                    t_idx,
+                                                                                    t_idx                i_nx,
+                                                                                    t_idx,
+                                                                                    t_idx,
+                                                                                    t_real       const * i_h,
+                                                                                    t_real       const * i_hu,
+                                                                                    t_real       const *,
+                                                                                    t_real       const * i_b ) {
+  decode();
+  m_dirty = true;
+
+#pragma omp parallel for num_threads( m_nThreads ) schedule(static)
+  for( t_idx l_ce = 0; l_ce < i_nx; l_ce++ ) {
+    if( i_h  != nullptr ) m_hDecoded[i_ix + l_ce]  = i_h[l_ce];
+    if( i_hu != nullptr ) m_huDecoded[i_ix + l_ce] = i_hu[l_ce];
+    if( i_b  != nullptr ) {
+      m_b[i_ix+1 + l_ce]   = i_b[l_ce];
+      m_bCopy[i_ix + l_ce] = i_b[l_ce];
+    }
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+bool tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::writeCheckpoint( std::string const & i_path,
+                                                                                          t_real              i_time,
+                                                                                          t_idx               i_timeStep,
+                                                                                          t_real              i_speedMax ) {
+  decode();
+  t_real const * l_fields[2] = { m_hDecoded, m_huDecoded };
+
+  return io::Checkpoint::write< t_real >( i_path,
+                                          m_nCells,
+                                          1,
+                                          2,
+                                          l_fields,
+                                          i_time,
+                                          i_timeStep,
+                                          i_speedMax );
+}
+
+template< typename T_real,
+          typename T_solver >
+bool tsunami_lab::patches::WavePropagationCompact1d< T_real, T_solver >::readCheckpoint( std::string const & i_path,
+                                                                                         t_real            & o_time,
+                                                                                         t_idx             & o_timeStep,
+                                                                                         t_real            & o_speedMax ) {
+  t_real * l_fields[2] = { m_hDecoded, m_huDecoded };
+  m_decoded = true;
+  m_dirty = true;
+
+  return io::Checkpoint::read< t_real >( i_path,
+                                         m_nCells,
+                                         1,
+                                         2,
+                                         l_fields,
+                                         o_time,
+                                         o_timeStep,
+                                         o_speedMax );
+}
+
+// explicit instantiations
+template class tsunami_lab::patches::WavePropagationCompact1d< double, tsunami_lab::solvers::Roe< double > >;
+template class tsunami_lab::patches::WavePropagationCompact1d< double, tsunami_lab::solvers::FWave< double > >;
+template class tsunami_lab::patches::WavePropagationCompact1d< double, tsunami_lab::solvers::Hll< double > >;
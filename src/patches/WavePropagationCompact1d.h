@@ -0,0 +1,360 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * One-dimensional wave propagation patch with single precision storage.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_COMPACT_1D
+#define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_COMPACT_1D
+
+#include "../constants.h"
+#include "../solvers/Roe.h"
+#include <string>
+
+namespace tsunami_lab {
+  namespace patches {
+    template< typename T_real = double,
+              typename T_solver = solvers::Roe< T_real > >
+    class WavePropagationCompact1d;
+  }
+}
+
+/**
+ * One-dimensional wave propagation patch which stores the water heights and momenta as single precision offsets
+ * and computes in the precision T_real, e.g., double precision at the memory traffic of single precision.
+ *
+ * The cells are grouped in tiles of m_tileSize cells.
+ * Per tile and quantity, a reference value is kept in the precision T_real: the midpoint of the tile's minimum and maximum.
+ * The cells store their offsets from the reference in single precision.
+ * Thus, the absolute error of a cell is bounded by single precision's relative precision times its offset,
+ * which is small for smooth fields, and deep water does not cost precision.
+ * The references are fixed between rebases, which take place every m_rebaseInterval time steps.
+ *
+ * A time step decodes every tile together with one neighboring cell on each side into the calling thread's scratch memory,
+ * which stays in the L1 cache, and solves the tile's edges there.
+ * The update of the cells encodes the new quantities on the fly.
+ * The net-updates stay in the caches; per cell and time step, only the 8 bytes of the encoded quantities are read and written,
+ * plus the bathymetry if the solver reads it.
+ * The bathymetry is constant in time and kept in the precision T_real.
+ *
+ * The getters, setters and checkpoints operate on a decoded copy of the quantities in the precision t_real,
+ * which is only updated on demand.
+ * Thus, outputs or initializations cost one decoding or encoding sweep each, but not the time steps in between.
+ * Instantiations for double precision with the Roe, the f-wave and the HLL solver are provided.
+ **/
+template< typename T_real,
+          typename T_solver >
+class tsunami_lab::patches::WavePropagationCompact1d {
+  public:
+    //! floating point type of the getters, setters and checkpoints
+    typedef t_real t_realPatch;
+
+  private:
+    //! number of cells per tile which share reference values
+    static t_idx constexpr m_tileSize = 1024;
+
+    //! number of time steps between rebases of the references
+    static t_idx constexpr m_rebaseInterval = 64;
+
+    //! current step which indicates the active values in the arrays below
+    unsigned short m_step = 0;
+
+    //! number of time steps since the last rebase
+    t_idx m_nStepsRebase = 0;
+
+    //! number of cells discretizing the computational domain
+    t_idx m_nCells = 0;
+
+    //! number of tiles
+    t_idx m_nTiles = 0;
+
+    //! number of threads for which scratch memory is allocated
+    t_idx m_nThreads = 1;
+
+    //! encoded offsets of the water heights for the current and next time step, without ghost cells
+    float * m_h[2] = { nullptr, nullptr };
+
+    //! encoded offsets of the momenta for the current and next time step, without ghost cells
+    float * m_hu[2] = { nullptr, nullptr };
+
+    //! reference water heights of the tiles for the current and next time step
+    T_real * m_hRef[2] = { nullptr, nullptr };
+
+    //! reference momenta of the tiles for the current and next time step
+    T_real * m_huRef[2] = { nullptr, nullptr };
+
+    //! bathymetry of all cells including the ghost cells
+    T_real * m_b = nullptr;
+
+    //! copy of the cells' bathymetry in the precision of the getters
+    t_real * m_bCopy = nullptr;
+
+    //! water heights of the ghost cells; 0: left, 1: right
+    T_real m_hGhost[2] = { 0, 0 };
+
+    //! momenta of the ghost cells; 0: left, 1: right
+    T_real m_huGhost[2] = { 0, 0 };
+
+    //! scratch memory of all threads: decoded heights and momenta of a tile and its neighbors, net-updates of the tile's edges
+    T_real * m_scratch = nullptr;
+
+    //! decoded water heights
+    t_real * m_hDecoded = nullptr;
+
+    //! decoded momenta
+    t_real * m_huDecoded = nullptr;
+
+    //! true if the decoded copy matches the encoded quantities or is newer
+    bool m_decoded = true;
+
+    //! true if the decoded copy was changed and has to be encoded before the next time step
+    bool m_dirty = false;
+
+    /**
+     * Gets the number of cells of a tile.
+     *
+     * @param i_tile id of the tile.
+     * @return number of cells.
+     **/
+    t_idx getNumCellsTile( t_idx i_tile ) const {
+      t_idx l_first = i_tile * m_tileSize;
+      return (m_nCells - l_first < m_tileSize) ? m_nCells - l_first : m_tileSize;
+    }
+
+    /**
+     * Gets the size of a thread's scratch memory.
+     *
+     * @return number of values.
+     **/
+    static t_idx getScratchSize() {
+      return 2 * (m_tileSize+2) + 4 * (m_tileSize+1);
+    }
+
+    /**
+     * Gets the calling thread's scratch memory.
+     *
+     * @param o_h will be set to the scratch memory for the heights of a tile and its neighbors.
+     * @param o_hu will be set to the scratch memory for the momenta of a tile and its neighbors.
+     * @param o_netUpdatesL will be set to the scratch memory for the net-updates of the left cells; 0: heights, 1: momenta.
+     * @param o_netUpdatesR will be set to the scratch memory for the net-updates of the right cells; 0: heights, 1: momenta.
+     **/
+    void getScratch( T_real *& o_h,
+                     T_real *& o_hu,
+                     T_real *  o_netUpdatesL[2],
+                     T_real *  o_netUpdatesR[2] );
+
+    /**
+     * Decodes a single cell of the current time step.
+     *
+     * @param i_values encoded offsets.
+     * @param i_refs reference values of the tiles.
+     * @param i_ce id of the cell.
+     * @return decoded value.
+     **/
+    static T_real decodeCell( float  const * i_values,
+                              T_real const * i_refs,
+                              t_idx          i_ce ) {
+      return i_refs[i_ce / m_tileSize] + T_real( i_values[i_ce] );
+    }
+
+    /**
+     * Encodes the values of a tile w.r.t. the midpoint of their minimum and maximum.
+     *
+     * @param i_values values of the tile.
+     * @param i_nCells number of cells of the tile.
+     * @param o_values will be set to the encoded offsets of the tile's cells.
+     * @param o_ref will be set to the reference value of the tile.
+     **/
+    template< typename T_value >
+    static void encodeTile( T_value const * i_values,
+                            t_idx           i_nCells,
+                            float         * o_values,
+                            T_real        & o_ref );
+
+    /**
+     * Updates the decoded copy, if outdated.
+     **/
+    void decode();
+
+    /**
+     * Encodes the decoded copy, if changed.
+     **/
+    void encode();
+
+  public:
+    /**
+     * Constructs the 1d wave propagation solver.
+     *
+     * The fields are initialized to zero in parallel with the thread decomposition of the time step (first touch).
+     *
+     * @param i_nCells number of cells.
+     **/
+    WavePropagationCompact1d( t_idx i_nCells );
+
+    /**
+     * Destructor which frees all allocated memory.
+     **/
+    ~WavePropagationCompact1d();
+
+    WavePropagationCompact1d( WavePropagationCompact1d const & ) = delete;
+    WavePropagationCompact1d & operator=( WavePropagationCompact1d const & ) = delete;
+
+    /**
+     * Performs a time step.
+     * Uses all OpenMP threads; the result is bitwise-identical for any number of threads.
+     * The ghost cells are set according to outflow boundary conditions afterwards.
+     *
+     * @param i_scaling scaling of the time step (dt / dx).
+     * @return maximum wave speed of the Riemann problems solved in the time step.
+     **/
+    t_real timeStep( t_real i_scaling );
+
+    /**
+     * Sets the values of the ghost cells according to outflow boundary conditions, including the bathymetry.
+     **/
+    void setGhostOutflow();
+
+    /**
+     * Gets the stride in y-direction. x-direction is stride-1.
+     *
+     * @return stride in y-direction.
+     **/
+    t_idx getStride() {
+      return m_nCells;
+    }
+
+    /**
+     * Gets the cells' water heights, decoded to the precision t_real.
+     * The pointer stays valid, the values until the next time step.
+     *
+     * @return water heights.
+     **/
+    t_real const * getHeight() {
+      decode();
+      return m_hDecoded;
+    }
+
+    /**
+     * Gets the cells' momenta in x-direction, decoded to the precision t_real.
+     * The pointer stays valid, the values until the next time step.
+     *
+     * @return momenta in x-direction.
+     **/
+    t_real const * getMomentumX() {
+      decode();
+      return m_huDecoded;
+    }
+
+    /**
+     * Dummy function which returns a nullptr.
+     **/
+    t_real const * getMomentumY() {
+      return nullptr;
+    }
+
+    /**
+     * Gets the cells' bathymetry.
+     *
+     * @return bathymetry.
+     **/
+    t_real const * getBathymetry() {
+      return m_bCopy;
+    }
+
+    /**
+     * Sets the height of the cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_h water height.
+     **/
+    void setHeight( t_idx  i_ix,
+                    t_idx,
+                    t_real i_h ) {
+      decode();
+      m_hDecoded[i_ix] = i_h;
+      m_dirty = true;
+    }
+
+    /**
+     * Sets the momentum in x-direction to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_hu momentum in x-direction.
+     **/
+    void setMomentumX( t_idx  i_ix,
+                       t_idx,
+                       t_real i_hu ) {
+      decode();
+      m_huDecoded[i_ix] = i_hu;
+      m_dirty = true;
+    }
+
+    /**
+     * Dummy function since there is no y-momentum in the 1d solver.
+     **/
+    void setMomentumY( t_idx,
+                       t_idx,
+                       t_real ) {};
+
+    /**
+     * Sets the bathymetry of the cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_b bathymetry.
+     **/
+    void setBathymetry( t_idx  i_ix,
+                        t_idx,
+                        t_real i_b ) {
+      m_b[i_ix+1] = i_b;
+      m_bCopy[i_ix] = i_b;
+    }
+
+    /**
+     * Sets the values of a block of cells in bulk.
+     *
+     * @param i_ix id of the block's first cell.
+     * @param i_nx number of cells of the block.
+     * @param i_h water heights; optional: use nullptr if not required.
+     * @param i_hu momenta in x-direction; optional: use nullptr if not required.
+     * @param i_b bathymetry; optional: use nullptr if not required.
+     **/
+    void setValues( t_idx                i_ix,
+                    t_idx,
+                    t_idx                i_nx,
+                    t_idx,
+                    t_idx,
+                    t_real       const * i_h,
+                    t_real       const * i_hu,
+                    t_real       const *,
+                    t_real       const * i_b );
+
+    /**
+     * Writes a checkpoint of the decoded quantities.
+     *
+     * @param i_path path of the checkpoint.
+     * @param i_time simulation time.
+     * @param i_timeStep time step counter.
+     * @param i_speedMax maximum wave speed of the last time step.
+     * @return true if successful, false otherwise.
+     **/
+    bool writeCheckpoint( std::string const & i_path,
+                          t_real              i_time,
+                          t_idx               i_timeStep,
+                          t_real              i_speedMax );
+
+    /**
+     * Restores the quantities from a checkpoint; they are encoded before the next time step.
+     *
+     * @param i_path path of the checkpoint.
+     * @param o_time will be set to the simulation time.
+     * @param o_timeStep will be set to the time step counter.
+     * @param o_speedMax will be set to the maximum wave speed of the last time step.
+     * @return true if successful, false otherwise; the state is undefined on failure.
+     **/
+    bool readCheckpoint( std::string const & i_path,
+                         t_real            & o_time,
+                         t_idx             & o_timeStep,
+                         t_real            & o_speedMax );
+};
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the one-dimensional wave propagation patch with single precision storage.
+ **/
+#include <catch2/catch.hpp>
+#define private public
+#include "WavePropagationCompact1d.h"
+#undef public
+#include "WavePropagation1d.h"
+#include "WavePropagationWrapper.h"
+#include "../solvers/FWave.h"
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace {
+  /**
+   * Advances a dam break in a patch with single precision storage and in an uncompressed double precision patch.
+   * The dam is located in the middle of the second of three tiles, the last tile is incomplete.
+   *
+   * @param i_nSteps number of time steps.
+   * @param o_errorH will be set to the mean absolute difference of the heights.
+   * @param o_errorHu will be set to the mean absolute difference of the momenta.
+   **/
+  void damBreak( unsigned short   i_nSteps,
+                 double         & o_errorH,
+                 double         & o_errorHu ) {
+    tsunami_lab::patches::WavePropagationCompact1d< double > l_compact( 3000 );
+    tsunami_lab::patches::WavePropagation1d< double > l_waveProp( 3000 );
+
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < 3000; l_ce++ ) {
+      double l_h = (l_ce < 1500) ? 10 : 5;
+      l_compact.setHeight( l_ce, 0, l_h );
+      l_waveProp.setHeight( l_ce, 0, l_h );
+      l_compact.setMomentumX( l_ce, 0, 0 );
+      l_waveProp.setMomentumX( l_ce, 0, 0 );
+    }
+
+    // the decoded copy holds the exact values until the first time step
+    REQUIRE( l_compact.getHeight()[1499] == 10 );
+    REQUIRE( l_compact.getHeight()[1500] == 5 );
+
+    for( unsigned short l_st = 0; l_st < i_nSteps; l_st++ ) {
+      l_compact.setGhostOutflow();
+      l_waveProp.setGhostOutflow();
+      double l_speed = l_compact.timeStep( 0.05f );
+      double l_speedRef = l_waveProp.timeStep( 0.05f );
+      REQUIRE( l_speed == Approx( l_speedRef ).epsilon( 1E-3 ) );
+    }
+
+    o_errorH = 0;
+    o_errorHu = 0;
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < 3000; l_ce++ ) {
+      o_errorH  += std::abs( l_compact.getHeight()[l_ce]    - l_waveProp.getHeight()[l_ce] );
+      o_errorHu += std::abs( l_compact.getMomentumX()[l_ce] - l_waveProp.getMomentumX()[l_ce] );
+    }
+    o_errorH /= 3000;
+    o_errorHu /= 3000;
+  }
+}
+
+TEST_CASE( "Test the 1d wave propagation solver with single precision storage.", "[WaveProp1dCompact]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break with heights 10 and 5 in 3000 cells, advanced by 500 time steps.
+   *   The waves reach the outer tiles and pass several rebases of the references.
+   *   The storage's rounding errors are bounded by single precision's relative precision times the offsets,
+   *   the getters add the rounding to single precision.
+   */
+  double l_errorH = 0;
+  double l_errorHu = 0;
+
+  damBreak( 500,
+            l_errorH,
+            l_errorHu );
+  REQUIRE( l_errorH < 1E-6 );
+  REQUIRE( l_errorHu < 1E-5 );
+}
+
+TEST_CASE( "Test the offsets of the 1d wave propagation solver with single precision storage.", "[WaveProp1dCompactOffsets]" ) {
+  /*
+   * Test case:
+   *
+   *   Lake at rest with a depth of 4000 and a hump of the water surface with height 2^-10,
+   *   which the single precision setters represent exactly.
+   *   The f-wave solver takes the bathymetry into account; the computations use double precision.
+   *   Single precision would resolve 4000 only to 2.4E-4, the offsets from the tiles' references to about 1E-10.
+   *   Thus, the encoded quantities are compared, which the single precision getters would round.
+   */
+  typedef tsunami_lab::patches::WavePropagationCompact1d< double,
+                                                          tsunami_lab::solvers::FWave< double > > t_patch;
+  t_patch l_compact( 2048 );
+  tsunami_lab::patches::WavePropagation1d< double, tsunami_lab::solvers::FWave< double > > l_waveProp( 2048 );
+
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 2048; l_ce++ ) {
+    double l_eta = (l_ce >= 1000 && l_ce < 1100) ? 1.0 / 1024 : 0;
+    l_compact.setBathymetry( l_ce, 0, -4000 );
+    l_waveProp.setBathymetry( l_ce, 0, -4000 );
+    l_compact.setHeight( l_ce, 0, 4000 + l_eta );
+    l_waveProp.setHeight( l_ce, 0, 4000 + l_eta );
+  }
+
+  for( unsigned short l_st = 0; l_st < 200; l_st++ ) {
+    l_compact.setGhostOutflow();
+    l_waveProp.setGhostOutflow();
+    l_compact.timeStep( 0.002 );
+    l_waveProp.timeStep( 0.002 );
+  }
+
+  float const * l_h = l_compact.m_h[l_compact.m_step];
+  float const * l_hu = l_compact.m_hu[l_compact.m_step];
+  double const * l_hRef = l_compact.m_hRef[l_compact.m_step];
+  double const * l_huRef = l_compact.m_huRef[l_compact.m_step];
+
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 2048; l_ce++ ) {
+    REQUIRE( t_patch::decodeCell( l_h,  l_hRef,  l_ce ) == Approx( l_waveProp.getHeight()[l_ce] ).margin( 1E-8 ) );
+    REQUIRE( t_patch::decodeCell( l_hu, l_huRef, l_ce ) == Approx( l_waveProp.getMomentumX()[l_ce] ).margin( 1E-6 ) );
+  }
+
+  // the hump spread
+  REQUIRE( t_patch::decodeCell( l_h, l_hRef, 1050 ) < 4000.00093 );
+  REQUIRE( t_patch::decodeCell( l_h, l_hRef, 950 ) > 4000.0001 );
+}
+
+TEST_CASE( "Test the type-erased wrapper and checkpoints of the 1d wave propagation solver with single precision storage.", "[WaveProp1dCompactWrapper]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break through the wrapper, checkpointed after 20 time steps and restored into a second patch.
+   *   The restored patch holds the decoded values exactly; since they are encoded anew, both patches continue up to single precision.
+   */
+  typedef tsunami_lab::patches::WavePropagationCompact1d<> t_patch;
+  tsunami_lab::patches::WavePropagationWrapper< t_patch > l_waveProp( 500 );
+  t_patch l_restored( 500 );
+
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 500; l_ce++ ) {
+    l_waveProp.setHeight( l_ce, 0, (l_ce < 250) ? 10 : 5 );
+  }
+  for( unsigned short l_st = 0; l_st < 20; l_st++ ) {
+    l_waveProp.setGhostOutflow();
+    l_waveProp.timeStep( 0.05f );
+  }
+
+  std::string l_path = "compact.test.chk";
+  REQUIRE( l_waveProp.writeCheckpoint( l_path, 1.5f, 20, 7.5f ) );
+
+  tsunami_lab::t_real l_time = 0;
+  tsunami_lab::t_idx l_timeStep = 0;
+  tsunami_lab::t_real l_speedMax = 0;
+  REQUIRE( l_restored.readCheckpoint( l_path, l_time, l_timeStep, l_speedMax ) );
+  std::remove( l_path.c_str() );
+  REQUIRE( l_time == 1.5f );
+  REQUIRE( l_timeStep == 20 );
+  REQUIRE( l_speedMax == 7.5f );
+
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 500; l_ce++ ) {
+    REQUIRE( l_waveProp.getHeight()[l_ce]    == l_restored.getHeight()[l_ce] );
+    REQUIRE( l_waveProp.getMomentumX()[l_ce] == l_restored.getMomentumX()[l_ce] );
+  }
+
+  for( unsigned short l_st = 0; l_st < 20; l_st++ ) {
+    l_waveProp.setGhostOutflow();
+    l_restored.setGhostOutflow();
+    REQUIRE( l_waveProp.timeStep( 0.05f ) == Approx( l_restored.timeStep( 0.05f ) ).epsilon( 1E-3 ) );
+  }
+
+  for( tsunami_lab::t_idx l_ce = 0; l_ce < 500; l_ce++ ) {
+    REQUIRE( l_waveProp.getHeight()[l_ce]    == Approx( l_restored.getHeight()[l_ce] ).margin( 1E-2 ) );
+    REQUIRE( l_waveProp.getMomentumX()[l_ce] == Approx( l_restored.getMomentumX()[l_ce] ).margin( 1E-2 ) );
+  }
+}
@@ -0,0 +1,69 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the one-dimensional wave propagation patch for ensembles of scenarios.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "WavePropagationEnsemble1d.h"
+#include <string>
+#include <vector>
+
+namespace {
+  /**
+   * Measures time steps of ensembles of dam break problems with different dam locations.
+   * The MLUPS refer to the cells of all members; a single member is the reference of separate simulations.
+   *
+   * @param io_benchmark benchmark which records the results.
+   * @param i_type name of the floating point type.
+   **/
+  template< typename T_real >
+  void runType( tsunami_lab::benchmarks::Benchmark & io_benchmark,
+                std::string const                  & i_type ) {
+    tsunami_lab::t_idx l_nCells = 4096;
+
+    for( tsunami_lab::t_idx l_nMembers : { 1, 16, 256 } ) {
+      tsunami_lab::patches::WavePropagationEnsemble1d< T_real > l_ensemble( l_nCells,
+                                                                            l_nMembers );
+
+      std::vector< T_real > l_h( l_nCells );
+      for( tsunami_lab::t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+        for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+          l_h[l_ce] = (l_ce < (l_me+1) * l_nCells / (l_nMembers+1)) ? 10 : 5;
+        }
+        l_ensemble.setValues( l_me,
+                              0,
+                              l_nCells,
+                              l_h.data(),
+                              nullptr );
+      }
+      l_ensemble.setGhostOutflow();
+
+      std::vector< T_real > l_scalings( l_nMembers, T_real(0.01) );
+      std::vector< T_real > l_speedsMax( l_nMembers, 0 );
+
+      double l_seconds = io_benchmark.measure( [&]() {
+        l_ensemble.timeStep( l_scalings.data(),
+                             l_speedsMax.data() );
+      } );
+
+      io_benchmark.report( "WavePropagationEnsemble1d::timeStep/" + i_type + "/" + std::to_string( l_nCells )
+                           + "x" + std::to_string( l_nMembers ),
+                           "MLUPS",
+                           l_nCells * l_nMembers / l_seconds * 1E-6 );
+    }
+  }
+
+  /**
+   * Runs the case.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    runType< float >( io_benchmark, "float" );
+    runType< double >( io_benchmark, "double" );
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "WavePropagationEnsemble1d",
+                                                                         run );
+}
@@ -0,0 +1,207 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * One-dimensional wave propagation patch for ensembles of scenarios.
+ **/
+#include "WavePropagationEnsemble1d.h"
+#include "../memory/Allocator.h"
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagationEnsemble1d< T_real, T_solver >::WavePropagationEnsemble1d( t_idx i_nCells,
+                                                                                                t_idx i_nMembers,
+                                                                                                bool  i_hugePages ) {
+  m_nCells = i_nCells;
+  m_nMembers = i_nMembers;
+  m_nEdgesBatch = std::max< t_idx >( 1, m_batchSize / m_nMembers );
+
+  // allocate memory including a single ghost cell on each side
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    m_h[l_st]  = memory::Allocator::allocate< T_real >( (m_nCells + 2) * m_nMembers, i_hugePages );
+    m_hu[l_st] = memory::Allocator::allocate< T_real >( (m_nCells + 2) * m_nMembers, i_hugePages );
+  }
+
+  // allocate scratch memory for the net-updates of all edges
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    m_netUpdatesL[l_qt] = memory::Allocator::allocate< T_real >( (m_nCells + 1) * m_nMembers, i_hugePages );
+    m_netUpdatesR[l_qt] = memory::Allocator::allocate< T_real >( (m_nCells + 1) * m_nMembers, i_hugePages );
+  }
+
+  // allocate scratch memory for the wave speeds per thread
+#ifdef _OPENMP
+  m_nThreads = omp_get_max_threads();
+#endif
+  m_speeds = memory::Allocator::allocate< T_real >( m_nThreads * m_nEdgesBatch * m_nMembers );
+  m_speedsMax = memory::Allocator::allocate< T_real >( m_nThreads * m_nMembers );
+
+  // first touch: cells and edges are zeroed with all their members in the static chunks of timeStep's two sweeps
+#pragma omp parallel num_threads( m_nThreads )
+  {
+#pragma omp for schedule(static)
+    for( t_idx l_ce = 1; l_ce < m_nCells+1; l_ce++ ) {
+      for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+        std::fill_n( m_h[l_st] + l_ce * m_nMembers, m_nMembers, T_real(0) );
+        std::fill_n( m_hu[l_st] + l_ce * m_nMembers, m_nMembers, T_real(0) );
+      }
+    }
+
+#pragma omp for schedule(static)
+    for( t_idx l_ed = 0; l_ed < m_nCells+1; l_ed += m_nEdgesBatch ) {
+      t_idx l_nValues = std::min( m_nEdgesBatch, m_nCells+1 - l_ed ) * m_nMembers;
+
+      for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+        std::fill_n( m_netUpdatesL[l_qt] + l_ed * m_nMembers, l_nValues, T_real(0) );
+        std::fill_n( m_netUpdatesR[l_qt] + l_ed * m_nMembers, l_nValues, T_real(0) );
+      }
+    }
+  }
+
+  // ghost cells
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    std::fill_n( m_h[l_st], m_nMembers, T_real(0) );
+    std::fill_n( m_hu[l_st], m_nMembers, T_real(0) );
+    std::fill_n( m_h[l_st] + (m_nCells+1) * m_nMembers, m_nMembers, T_real(0) );
+    std::fill_n( m_hu[l_st] + (m_nCells+1) * m_nMembers, m_nMembers, T_real(0) );
+  }
+}
+
+template< typename T_real,
+          typename T_solver >
+tsunami_lab::patches::WavePropagationEnsemble1d< T_real, T_solver >::~WavePropagationEnsemble1d() {
+  for( unsigned short l_st = 0; l_st < 2; l_st++ ) {
+    memory::Allocator::free( m_h[l_st] );
+    memory::Allocator::free( m_hu[l_st] );
+  }
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    memory::Allocator::free( m_netUpdatesL[l_qt] );
+    memory::Allocator::free( m_netUpdatesR[l_qt] );
+  }
+  memory::Allocator::free( m_speeds );
+  memory::Allocator::free( m_speedsMax );
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationEnsemble1d< T_real, T_solver >::timeStep( T_real const * i_scalings,
+                                                                                    T_real       * o_speedsMax ) {
+  // pointers to old and new data
+  T_real const * l_hOld = m_h[m_step];
+  T_real const * l_huOld = m_hu[m_step];
+
+  m_step = (m_step+1) % 2;
+  T_real * l_hNew =  m_h[m_step];
+  T_real * l_huNew = m_hu[m_step];
+
+  t_idx l_nMembers = m_nMembers;
+  std::fill_n( o_speedsMax, l_nMembers, T_real(0) );
+
+#pragma omp parallel num_threads( m_nThreads )
+  {
+    t_idx l_th = 0;
+#ifdef _OPENMP
+    l_th = omp_get_thread_num();
+#endif
+    T_real * l_speeds = m_speeds + l_th * m_nEdgesBatch * l_nMembers;
+    T_real * l_speedsMax = m_speedsMax + l_th * l_nMembers;
+    std::fill_n( l_speedsMax, l_nMembers, T_real(0) );
+
+    // compute net-updates in batches of edges; the Riemann problems of edge i are located between cells i and i+1
+#pragma omp for schedule(static)
+    for( t_idx l_ed = 0; l_ed < m_nCells+1; l_ed += m_nEdgesBatch ) {
+      t_idx l_nEdges = std::min( m_nEdgesBatch, m_nCells+1 - l_ed );
+      t_idx l_first = l_ed * l_nMembers;
+
+      T_real * l_netUpdatesL[2] = { m_netUpdatesL[0] + l_first,
+                                    m_netUpdatesL[1] + l_first };
+      T_real * l_netUpdatesR[2] = { m_netUpdatesR[0] + l_first,
+                                    m_netUpdatesR[1] + l_first };
+
+      // the right cells of all members are a cell, i.e., #members values, ahead
+      T_solver::netUpdatesBatch( l_nEdges * l_nMembers,
+                                 l_hOld + l_first,
+                                 l_hOld + l_first + l_nMembers,
+                                 l_huOld + l_first,
+                                 l_huOld + l_first + l_nMembers,
+                                 l_netUpdatesL,
+                                 l_netUpdatesR,
+                                 l_speeds );
+
+      for( t_idx l_be = 0; l_be < l_nEdges; l_be++ ) {
+#pragma omp simd
+        for( t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+          l_speedsMax[l_me] = std::max( l_speeds[l_be * l_nMembers + l_me], l_speedsMax[l_me] );
+        }
+      }
+    }
+
+    // the maximum is independent of the order of the threads
+#pragma omp critical
+    for( t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+      o_speedsMax[l_me] = std::max( l_speedsMax[l_me], o_speedsMax[l_me] );
+    }
+
+    // update the cells' quantities with the net-updates of the left (l_ce-1) and right (l_ce) edge
+#pragma omp for schedule(static)
+    for( t_idx l_ce = 1; l_ce < m_nCells+1; l_ce++ ) {
+      t_idx l_id = l_ce * l_nMembers;
+
+      T_real const * l_netUpdatesRH  = m_netUpdatesR[0] + l_id - l_nMembers;
+      T_real const * l_netUpdatesRHu = m_netUpdatesR[1] + l_id - l_nMembers;
+      T_real const * l_netUpdatesLH  = m_netUpdatesL[0] + l_id;
+      T_real const * l_netUpdatesLHu = m_netUpdatesL[1] + l_id;
+
+      // members with a zero scaling keep their state exactly, even if their net-updates are not finite (dry members)
+#pragma omp simd
+      for( t_idx l_me = 0; l_me < l_nMembers; l_me++ ) {
+        T_real l_hUpd  = l_hOld[l_id + l_me]  - i_scalings[l_me] * l_netUpdatesRH[l_me]  - i_scalings[l_me] * l_netUpdatesLH[l_me];
+        T_real l_huUpd = l_huOld[l_id + l_me] - i_scalings[l_me] * l_netUpdatesRHu[l_me] - i_scalings[l_me] * l_netUpdatesLHu[l_me];
+        l_hNew[l_id + l_me]  = (i_scalings[l_me] != 0) ? l_hUpd  : l_hOld[l_id + l_me];
+        l_huNew[l_id + l_me] = (i_scalings[l_me] != 0) ? l_huUpd : l_huOld[l_id + l_me];
+      }
+    }
+  }
+
+  // outflow boundary conditions for the new quantities
+  setGhostOutflow();
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationEnsemble1d< T_real, T_solver >::setGhostOutflow() {
+  T_real * l_h = m_h[m_step];
+  T_real * l_hu = m_hu[m_step];
+
+  // set left boundary
+  std::copy_n( l_h + m_nMembers, m_nMembers, l_h );
+  std::copy_n( l_hu + m_nMembers, m_nMembers, l_hu );
+
+  // set right boundary
+  std::copy_n( l_h + m_nCells * m_nMembers, m_nMembers, l_h + (m_nCells+1) * m_nMembers );
+  std::copy_n( l_hu + m_nCells * m_nMembers, m_nMembers, l_hu + (m_nCells+1) * m_nMembers );
+}
+
+template< typename T_real,
+          typename T_solver >
+void tsunami_lab::patches::WavePropagationEnsemble1d< T_real, T_solver >::setValues( t_idx                i_member,
+                                                                                     t_idx                i_ix,
+                                                                                     t_idx                i_nx,
+                                                                                     T_real       const * i_h,
+                                                                                     T_real       const * i_hu ) {
+  T_real * l_h  = m_h[m_step]  + (i_ix+1) * m_nMembers + i_member;
+  T_real * l_hu = m_hu[m_step] + (i_ix+1) * m_nMembers + i_member;
+
+#pragma omp parallel for schedule(static)
+  for( t_idx l_ce = 0; l_ce < i_nx; l_ce++ ) {
+    if( i_h  != nullptr ) l_h[l_ce * m_nMembers]  = i_h[l_ce];
+    if( i_hu != nullptr ) l_hu[l_ce * m_nMembers] = i_hu[l_ce];
+  }
+}
+
+// explicit instantiations
+template class tsunami_lab::patches::WavePropagationEnsemble1d< float,  tsunami_lab::solvers::Roe< float > >;
+template class tsunami_lab::patches::WavePropagationEnsemble1d< double, tsunami_lab::solvers::Roe< double > >;
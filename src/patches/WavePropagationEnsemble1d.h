@@ -0,0 +1,161 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * One-dimensional wave propagation patch for ensembles of scenarios.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_ENSEMBLE_1D
+#define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_ENSEMBLE_1D
+
+#include "../constants.h"
+#include "../solvers/Roe.h"
+
+namespace tsunami_lab {
+  namespace patches {
+    template< typename T_real = t_real,
+              typename T_solver = solvers::Roe< T_real > >
+    class WavePropagationEnsemble1d;
+  }
+}
+
+/**
+ * One-dimensional wave propagation patch which advances an ensemble of scenarios on the same grid together.
+ *
+ * The members' quantities are interleaved, i.e., the member id is the innermost dimension:
+ * the value of member m in cell c is stored at position c * #members + m.
+ * Thus, the Riemann problems of all members at an edge are contiguous in memory and solved in the same vector instructions.
+ * Every member has its own time step size; a time step size of zero keeps a member's state unchanged.
+ * The solver has to provide a static netUpdatesBatch which returns the wave speeds of the edges.
+ **/
+template< typename T_real,
+          typename T_solver >
+class tsunami_lab::patches::WavePropagationEnsemble1d {
+  public:
+    //! floating point type of the patch
+    typedef T_real t_realPatch;
+
+  private:
+    //! minimum number of Riemann problems (edges times members) which are passed to the solver as one batch
+    static t_idx constexpr m_batchSize = 1024;
+
+    //! number of threads for which scratch memory is allocated
+    t_idx m_nThreads = 1;
+
+    //! current step which indicates the active values in the arrays below
+    unsigned short m_step = 0;
+
+    //! number of cells discretizing the computational domain
+    t_idx m_nCells = 0;
+
+    //! number of ensemble members
+    t_idx m_nMembers = 0;
+
+    //! number of edges which are passed to the solver as one batch
+    t_idx m_nEdgesBatch = 0;
+
+    //! water heights for the current and next time step for all cells and members
+    T_real * m_h[2] = { nullptr, nullptr };
+
+    //! momenta for the current and next time step for all cells and members
+    T_real * m_hu[2] = { nullptr, nullptr };
+
+    //! net-updates of the edges for the left cells; 0: heights, 1: momenta
+    T_real * m_netUpdatesL[2] = { nullptr, nullptr };
+
+    //! net-updates of the edges for the right cells; 0: heights, 1: momenta
+    T_real * m_netUpdatesR[2] = { nullptr, nullptr };
+
+    //! per-thread wave speeds of a batch of edges
+    T_real * m_speeds = nullptr;
+
+    //! per-thread maximum wave speeds of the members
+    T_real * m_speedsMax = nullptr;
+
+  public:
+    /**
+     * Constructs the ensemble patch.
+     *
+     * The fields are initialized to zero in parallel with the thread decomposition of the time step (first touch).
+     *
+     * @param i_nCells number of cells.
+     * @param i_nMembers number of ensemble members.
+     * @param i_hugePages true if the fields should be backed by transparent huge pages.
+     **/
+    WavePropagationEnsemble1d( t_idx i_nCells,
+                               t_idx i_nMembers,
+                               bool  i_hugePages = false );
+
+    /**
+     * Destructor which frees all allocated memory.
+     **/
+    ~WavePropagationEnsemble1d();
+
+    /**
+     * Performs a time step for all members.
+     * The outflow boundary conditions are applied to the new quantities.
+     * The result is bitwise-identical to that of separate WavePropagation1d patches.
+     *
+     * @param i_scalings scalings of the members' time steps (dt / dx); zero if a member should not be advanced, which keeps its state exactly.
+     * @param o_speedsMax will be set to the members' maximum wave speeds of the Riemann problems solved in the time step.
+     **/
+    void timeStep( T_real const * i_scalings,
+                   T_real       * o_speedsMax );
+
+    /**
+     * Sets the values of all members' ghost cells according to outflow boundary conditions.
+     **/
+    void setGhostOutflow();
+
+    /**
+     * Gets the number of cells.
+     *
+     * @return number of cells.
+     **/
+    t_idx getNumCells() const {
+      return m_nCells;
+    }
+
+    /**
+     * Gets the number of ensemble members, which is the stride between two cells.
+     *
+     * @return number of members.
+     **/
+    t_idx getNumMembers() const {
+      return m_nMembers;
+    }
+
+    /**
+     * Gets the cells' water heights of all members.
+     *
+     * @return water heights, interleaved by member.
+     **/
+    T_real const * getHeight() const {
+      return m_h[m_step] + m_nMembers;
+    }
+
+    /**
+     * Gets the cells' momenta in x-direction of all members.
+     *
+     * @return momenta in x-direction, interleaved by member.
+     **/
+    T_real const * getMomentumX() const {
+      return m_hu[m_step] + m_nMembers;
+    }
+
+    /**
+     * Sets the values of a block of cells of a single member.
+     *
+     * @param i_member id of the member.
+     * @param i_ix id of the block's first cell.
+     * @param i_nx number of cells of the block.
+     * @param i_h water heights; optional: use nullptr if not required.
+     * @param i_hu momenta in x-direction; optional: use nullptr if not required.
+     **/
+    void setValues( t_idx                i_member,
+                    t_idx                i_ix,
+                    t_idx                i_nx,
+                    T_real       const * i_h,
+                    T_real       const * i_hu );
+};
+
+#endif
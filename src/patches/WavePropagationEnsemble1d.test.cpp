@@ -0,0 +1,104 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the one-dimensional wave propagation patch for ensembles of scenarios.
+ **/
+#include <catch2/catch.hpp>
+#include "WavePropagationEnsemble1d.h"
+#include "WavePropagation1d.h"
+#include <cmath>
+#include <vector>
+
+TEST_CASE( "Test the 1d ensemble wave propagation solver.", "[WavePropEnsemble1d]" ) {
+  /*
+   * Test case:
+   *
+   *   Three dam breaks with different heights and dam locations in 3000 cells,
+   *   advanced by 40 time steps with different time step sizes.
+   *   The third member is frozen after 20 steps.
+   *   The results and the wave speeds have to be bitwise-identical to those of separate patches.
+   */
+  std::size_t l_nCells = 3000;
+  float l_heightsL[3] = { 10, 12, 4 };
+  float l_heightsR[3] = { 5, 2, 3.5 };
+  std::size_t l_dams[3] = { 1500, 100, 2990 };
+  float l_scalings[3] = { 0.05f, 0.03f, 0.08f };
+
+  tsunami_lab::patches::WavePropagationEnsemble1d< float > l_ensemble( l_nCells,
+                                                                       3 );
+  REQUIRE( l_ensemble.getNumMembers() == 3 );
+  REQUIRE( l_ensemble.getNumCells() == l_nCells );
+
+  std::vector< tsunami_lab::patches::WavePropagation1d< float > * > l_members;
+  for( std::size_t l_me = 0; l_me < 3; l_me++ ) {
+    std::vector< float > l_h( l_nCells );
+    std::vector< float > l_hu( l_nCells, 0 );
+    for( std::size_t l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+      l_h[l_ce] = (l_ce < l_dams[l_me]) ? l_heightsL[l_me] : l_heightsR[l_me];
+    }
+
+    l_ensemble.setValues( l_me,
+                          0,
+                          l_nCells,
+                          l_h.data(),
+                          l_hu.data() );
+
+    l_members.push_back( new tsunami_lab::patches::WavePropagation1d< float >( l_nCells ) );
+    l_members[l_me]->setValues( 0, 0, l_nCells, 1, l_nCells, l_h.data(), l_hu.data(), nullptr, nullptr );
+    l_members[l_me]->setGhostOutflow();
+  }
+  l_ensemble.setGhostOutflow();
+
+  for( unsigned short l_ti = 0; l_ti < 40; l_ti++ ) {
+    if( l_ti == 20 ) l_scalings[2] = 0;
+
+    float l_speedsMax[3] = { 0, 0, 0 };
+    l_ensemble.timeStep( l_scalings,
+                         l_speedsMax );
+
+    for( std::size_t l_me = 0; l_me < 3; l_me++ ) {
+      if( l_scalings[l_me] == 0 ) continue;
+      REQUIRE( l_members[l_me]->timeStep( l_scalings[l_me] ) == l_speedsMax[l_me] );
+    }
+  }
+
+  for( std::size_t l_me = 0; l_me < 3; l_me++ ) {
+    for( std::size_t l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+      REQUIRE( l_ensemble.getHeight()[l_ce * 3 + l_me]    == l_members[l_me]->getHeight()[l_ce] );
+      REQUIRE( l_ensemble.getMomentumX()[l_ce * 3 + l_me] == l_members[l_me]->getMomentumX()[l_ce] );
+    }
+    delete l_members[l_me];
+  }
+}
+
+TEST_CASE( "Test dry members of the 1d ensemble wave propagation solver.", "[WavePropEnsemble1dDry]" ) {
+  /*
+   * Test case:
+   *
+   *   A dam break and a dry member, whose net-updates are not finite.
+   *   The dry member is not advanced and has to keep its state exactly.
+   */
+  tsunami_lab::patches::WavePropagationEnsemble1d< float > l_ensemble( 100,
+                                                                       2 );
+  std::vector< float > l_h( 100 );
+  for( std::size_t l_ce = 0; l_ce < 100; l_ce++ ) {
+    l_h[l_ce] = (l_ce < 50) ? 10 : 5;
+  }
+  l_ensemble.setValues( 0, 0, 100, l_h.data(), nullptr );
+  l_ensemble.setGhostOutflow();
+
+  float l_scalings[2] = { 0.05f, 0 };
+  for( unsigned short l_ti = 0; l_ti < 10; l_ti++ ) {
+    float l_speedsMax[2] = { 0, 0 };
+    l_ensemble.timeStep( l_scalings,
+                         l_speedsMax );
+    REQUIRE( l_speedsMax[0] > 0 );
+  }
+
+  for( std::size_t l_ce = 0; l_ce < 100; l_ce++ ) {
+    REQUIRE( l_ensemble.getHeight()[l_ce * 2 + 1]    == 0 );
+    REQUIRE( l_ensemble.getMomentumX()[l_ce * 2 + 1] == 0 );
+    REQUIRE( std::isfinite( l_ensemble.getHeight()[l_ce * 2] ) );
+  }
+}
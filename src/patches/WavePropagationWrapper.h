@@ -0,0 +1,173 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Adapter of the templated wave propagation patches to the type-erased interface.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_WRAPPER
+#define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_WRAPPER
+
+#include "WavePropagation.h"
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace tsunami_lab {
+  namespace patches {
+    template< typename T_patch >
+    class WavePropagationWrapper;
+  }
+}
+
+/**
+ * Owns a patch and forwards the calls of the interface to it.
+ * The interface uses the default floating point type, thus the patch has to use it as well.
+ *
+ * @tparam T_patch type of the patch, e.g., WavePropagation1d< t_real, solvers::Roe< t_real > >.
+ **/
+template< typename T_patch >
+class tsunami_lab::patches::WavePropagationWrapper: public WavePropagation {
+  static_assert( std::is_same< typename T_patch::t_realPatch, t_real >::value,
+                 "the wrapped patch has to use the default floating point type" );
+
+  private:
+    //! wrapped patch
+    T_patch m_patch;
+
+    /**
+     * Checks whether a patch provides finest data through getRefinement and getFinest, e.g., a hierarchy of patches.
+     *
+     * @return true if provided, false otherwise.
+     **/
+    template< typename T_check >
+    static constexpr auto hasFinest( int ) -> decltype( std::declval< T_check & >().getRefinement(), bool() ) {
+      return true;
+    }
+
+    template< typename T_check >
+    static constexpr bool hasFinest( ... ) {
+      return false;
+    }
+
+  public:
+    /**
+     * Constructs the wrapped patch.
+     *
+     * @param i_args arguments which are forwarded to the patch's constructor.
+     **/
+    template< typename... T_args >
+    WavePropagationWrapper( T_args &&... i_args ): m_patch( std::forward< T_args >( i_args )... ) {}
+
+    /**
+     * Gets the wrapped patch.
+     *
+     * @return wrapped patch.
+     **/
+    T_patch & getPatch() {
+      return m_patch;
+    }
+
+    t_real timeStep( t_real i_scaling ) {
+      return m_patch.timeStep( i_scaling );
+    }
+
+    void setGhostOutflow() {
+      m_patch.setGhostOutflow();
+    }
+
+    t_idx getStride() {
+      return m_patch.getStride();
+    }
+
+    t_real const * getHeight() {
+      return m_patch.getHeight();
+    }
+
+    t_real const * getMomentumX() {
+      return m_patch.getMomentumX();
+    }
+
+    t_real const * getMomentumY() {
+      return m_patch.getMomentumY();
+    }
+
+    t_real const * getBathymetry() {
+      return m_patch.getBathymetry();
+    }
+
+    t_idx getRefinement() {
+      if constexpr( hasFinest< T_patch >( 0 ) ) {
+        return m_patch.getRefinement();
+      }
+      else {
+        return 1;
+      }
+    }
+
+    void getFinest( t_idx    i_first,
+                    t_idx    i_nCells,
+                    t_real * o_h,
+                    t_real * o_hu ) {
+      if constexpr( hasFinest< T_patch >( 0 ) ) {
+        m_patch.getFinest( i_first, i_nCells, o_h, o_hu );
+      }
+      else {
+        t_real const * l_h = m_patch.getHeight();
+        t_real const * l_hu = m_patch.getMomentumX();
+        std::copy( l_h + i_first, l_h + i_first + i_nCells, o_h );
+        std::copy( l_hu + i_first, l_hu + i_first + i_nCells, o_hu );
+      }
+    }
+
+    void setHeight( t_idx  i_ix,
+                    t_idx  i_iy,
+                    t_real i_h ) {
+      m_patch.setHeight( i_ix, i_iy, i_h );
+    }
+
+    void setMomentumX( t_idx  i_ix,
+                       t_idx  i_iy,
+                       t_real i_hu ) {
+      m_patch.setMomentumX( i_ix, i_iy, i_hu );
+    }
+
+    void setMomentumY( t_idx  i_ix,
+                       t_idx  i_iy,
+                       t_real i_hv ) {
+      m_patch.setMomentumY( i_ix, i_iy, i_hv );
+    }
+
+    void setBathymetry( t_idx  i_ix,
+                        t_idx  i_iy,
+                        t_real i_b ) {
+      m_patch.setBathymetry( i_ix, i_iy, i_b );
+    }
+
+    void setValues( t_idx                i_ix,
+                    t_idx                i_iy,
+                    t_idx                i_nx,
+                    t_idx                i_ny,
+                    t_idx                i_stride,
+                    t_real       const * i_h,
+                    t_real       const * i_hu,
+                    t_real       const * i_hv,
+                    t_real       const * i_b ) {
+      m_patch.setValues( i_ix, i_iy, i_nx, i_ny, i_stride, i_h, i_hu, i_hv, i_b );
+    }
+
+    bool writeCheckpoint( std::string const & i_path,
+                          t_real              i_time,
+                          t_idx               i_timeStep,
+                          t_real              i_speedMax ) {
+      return m_patch.writeCheckpoint( i_path, i_time, i_timeStep, i_speedMax );
+    }
+
+    bool readCheckpoint( std::string const & i_path,
+                         t_real            & o_time,
+                         t_idx             & o_timeStep,
+                         t_real            & o_speedMax ) {
+      return m_patch.readCheckpoint( i_path, o_time, o_timeStep, o_speedMax );
+    }
+};
+
+#endif
@@ -32,4 +32,33 @@ tsunami_lab::t_real tsunami_lab::setups::DamBreak1d::getMomentumX( t_real,
 tsunami_lab::t_real tsunami_lab::setups::DamBreak1d::getMomentumY( t_real,
                                                                    t_real ) const {
   return 0;
+}
+
+tsunami_lab::t_real tsunami_lab::setups::DamBreak1d::getBathymetry( t_real,
+                                                                    t_real ) const {
+  return 0;
+}
+
+void tsunami_lab::setups::DamBreak1d::getValues( t_real   i_dxy,
+                                                 t_idx    i_ix,
+                                                 t_idx,
+                                                 t_idx    i_nx,
+                                                 t_idx    i_ny,
+                                                 t_idx    i_stride,
+                                                 t_real * o_h,
+                                                 t_real * o_hu,
+                                                 t_real * o_hv,
+                                                 t_real * o_b ) const {
+#pragma omp parallel for collapse(2) schedule(static)
+  for( t_idx l_cy = 0; l_cy < i_ny; l_cy++ ) {
+    for( t_idx l_cx = 0; l_cx < i_nx; l_cx++ ) {
+      t_real l_x = (i_ix + l_cx) * i_dxy;
+      t_idx l_id = l_cy * i_stride + l_cx;
+
+      if( o_h  != nullptr ) o_h[l_id]  = (l_x < m_locationDam) ? m_heightLeft : m_heightRight;
+      if( o_hu != nullptr ) o_hu[l_id] = 0;
+      if( o_hv != nullptr ) o_hv[l_id] = 0;
+      if( o_b  != nullptr ) o_b[l_id]  = 0;
+    }
+  }
 }
\ No newline at end of file
@@ -66,6 +66,38 @@ class tsunami_lab::setups::DamBreak1d: public Setup {
     t_real getMomentumY( t_real,
                          t_real ) const;
 
+    /**
+     * Gets the bathymetry, which is flat.
+     *
+     * @return bathymetry.
+     **/
+    t_real getBathymetry( t_real,
+                          t_real ) const;
+
+    /**
+     * Gets the initial values of a block of cells in bulk without virtual calls per cell.
+     *
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_ix id of the block's first cell in x-direction.
+     * @param i_iy id of the block's first cell in y-direction.
+     * @param i_nx number of cells of the block in x-direction.
+     * @param i_ny number of cells of the block in y-direction.
+     * @param i_stride stride of the output arrays in y-direction (x is assumed to be stride-1).
+     * @param o_h will be set to the water heights; optional: use nullptr if not required.
+     * @param o_hu will be set to the momenta in x-direction; optional: use nullptr if not required.
+     * @param o_hv will be set to the momenta in y-direction; optional: use nullptr if not required.
+     * @param o_b will be set to the bathymetry; optional: use nullptr if not required.
+     **/
+    void getValues( t_real   i_dxy,
+                    t_idx    i_ix,
+                    t_idx    i_iy,
+                    t_idx    i_nx,
+                    t_idx    i_ny,
+                    t_idx    i_stride,
+                    t_real * o_h,
+                    t_real * o_hu,
+                    t_real * o_hv,
+                    t_real * o_b ) const;
 };
 
 #endif
\ No newline at end of file
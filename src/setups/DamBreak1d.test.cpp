@@ -37,4 +37,53 @@ TEST_CASE( "Test the one-dimensional dam break setup.", "[DamBreak1d]" ) {
   REQUIRE( l_damBreak.getMomentumX( 4, 5 ) == 0 );
 
   REQUIRE( l_damBreak.getMomentumY( 4, 2 ) == 0 );  
-}
\ No newline at end of file
+
+  // flat bathymetry
+  REQUIRE( l_damBreak.getBathymetry( 2, 0 ) == 0 );
+
+  REQUIRE( l_damBreak.getBathymetry( 4, 5 ) == 0 );
+}
+
+TEST_CASE( "Test the bulk initialization of the one-dimensional dam break setup.", "[DamBreak1dValues]" ) {
+  tsunami_lab::setups::DamBreak1d l_damBreak( 25,
+                                              55,
+                                               3 );
+
+  // block of 5x2 cells starting at cell (2, 1), stored with a stride of 7
+  tsunami_lab::t_real l_h[14]  = { -1, -1, -1, -1, -1, -1, -1,
+                                   -1, -1, -1, -1, -1, -1, -1 };
+  tsunami_lab::t_real l_hu[14] = { -1, -1, -1, -1, -1, -1, -1,
+                                   -1, -1, -1, -1, -1, -1, -1 };
+
+  l_damBreak.getValues( 0.5,
+                        2,
+                        1,
+                        5,
+                        2,
+                        7,
+                        l_h,
+                        l_hu,
+                        nullptr,
+                        nullptr );
+
+  for( std::size_t l_cy = 0; l_cy < 2; l_cy++ ) {
+    for( std::size_t l_cx = 0; l_cx < 7; l_cx++ ) {
+      std::size_t l_id = l_cy * 7 + l_cx;
+
+      // padding is untouched
+      if( l_cx >= 5 ) {
+        REQUIRE( l_h[l_id]  == -1 );
+        REQUIRE( l_hu[l_id] == -1 );
+        continue;
+      }
+
+      tsunami_lab::t_real l_x = (2 + l_cx) * tsunami_lab::t_real(0.5);
+      REQUIRE( l_h[l_id]  == l_damBreak.getHeight( l_x, 0 ) );
+      REQUIRE( l_hu[l_id] == 0 );
+    }
+  }
+
+  // cells 2-5 are left of the dam, cell 6 is right of it
+  REQUIRE( l_h[3] == 25 );
+  REQUIRE( l_h[4] == 55 );
+}
@@ -0,0 +1,33 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Simulation setup.
+ **/
+#include "Setup.h"
+
+void tsunami_lab::setups::Setup::getValues( t_real   i_dxy,
+                                            t_idx    i_ix,
+                                            t_idx    i_iy,
+                                            t_idx    i_nx,
+                                            t_idx    i_ny,
+                                            t_idx    i_stride,
+                                            t_real * o_h,
+                                            t_real * o_hu,
+                                            t_real * o_hv,
+                                            t_real * o_b ) const {
+#pragma omp parallel for collapse(2) schedule(static)
+  for( t_idx l_cy = 0; l_cy < i_ny; l_cy++ ) {
+    for( t_idx l_cx = 0; l_cx < i_nx; l_cx++ ) {
+      t_real l_x = (i_ix + l_cx) * i_dxy;
+      t_real l_y = (i_iy + l_cy) * i_dxy;
+
+      t_idx l_id = l_cy * i_stride + l_cx;
+
+      if( o_h  != nullptr ) o_h[l_id]  = getHeight(    l_x, l_y );
+      if( o_hu != nullptr ) o_hu[l_id] = getMomentumX( l_x, l_y );
+      if( o_hv != nullptr ) o_hv[l_id] = getMomentumY( l_x, l_y );
+      if( o_b  != nullptr ) o_b[l_id]  = getBathymetry( l_x, l_y );
+    }
+  }
+}
@@ -54,7 +54,44 @@ class tsunami_lab::setups::Setup {
      **/
     virtual t_real getMomentumY( t_real i_x,
                                  t_real i_y ) const = 0;
-      
+
+    /**
+     * Gets the bathymetry at a given point.
+     *
+     * @param i_x x-coordinate of the queried point.
+     * @param i_y y-coordinate of the queried point.
+     * @return bathymetry at the given point.
+     **/
+    virtual t_real getBathymetry( t_real i_x,
+                                  t_real i_y ) const = 0;
+
+    /**
+     * Gets the initial values of a block of cells in bulk.
+     * Cell (ix, iy) of the block is located at ( (i_ix+ix) * i_dxy, (i_iy+iy) * i_dxy ),
+     * its values are stored at offset iy * i_stride + ix of the output arrays.
+     * The default implementation queries the point-wise getters in parallel; derived setups may override it.
+     *
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_ix id of the block's first cell in x-direction.
+     * @param i_iy id of the block's first cell in y-direction.
+     * @param i_nx number of cells of the block in x-direction.
+     * @param i_ny number of cells of the block in y-direction.
+     * @param i_stride stride of the output arrays in y-direction (x is assumed to be stride-1).
+     * @param o_h will be set to the water heights; optional: use nullptr if not required.
+     * @param o_hu will be set to the momenta in x-direction; optional: use nullptr if not required.
+     * @param o_hv will be set to the momenta in y-direction; optional: use nullptr if not required.
+     * @param o_b will be set to the bathymetry; optional: use nullptr if not required.
+     **/
+    virtual void getValues( t_real   i_dxy,
+                            t_idx    i_ix,
+                            t_idx    i_iy,
+                            t_idx    i_nx,
+                            t_idx    i_ny,
+                            t_idx    i_stride,
+                            t_real * o_h,
+                            t_real * o_hu,
+                            t_real * o_hv,
+                            t_real * o_b ) const;
 };
 
 #endif
\ No newline at end of file
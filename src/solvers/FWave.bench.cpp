@@ -0,0 +1,111 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the f-wave Riemann solver.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "FWave.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  //! number of edges per call; small enough to stay in the L1 and L2 caches
+  tsunami_lab::t_idx constexpr g_nEdges = 4096;
+
+  /**
+   * Measures the single-edge and batched net-updates for subcritical flows over flat and varying bathymetry.
+   * The cases match the subcritical case of the Roe solver's benchmarks, which allows to compare the throughput.
+   *
+   * @param io_benchmark benchmark which records the results.
+   * @param i_type name of the floating point type.
+   **/
+  template< typename T_real >
+  void runType( tsunami_lab::benchmarks::Benchmark & io_benchmark,
+                std::string const                  & i_type ) {
+    typedef tsunami_lab::solvers::FWave< T_real > t_solver;
+
+    std::vector< T_real > l_netUpdates( 4 * g_nEdges );
+    T_real * l_netUpdatesL[2] = { l_netUpdates.data(),
+                                  l_netUpdates.data() + g_nEdges };
+    T_real * l_netUpdatesR[2] = { l_netUpdates.data() + 2 * g_nEdges,
+                                  l_netUpdates.data() + 3 * g_nEdges };
+
+    for( std::string l_bathymetry : { "flat", "varying" } ) {
+      std::mt19937 l_gen( 42 );
+      std::uniform_real_distribution< T_real > l_hDist( 1, 10 );
+      std::uniform_real_distribution< T_real > l_uDist( -2, 2 );
+      std::uniform_real_distribution< T_real > l_bDist( -100, -10 );
+
+      // left sides first, right sides second
+      std::vector< T_real > l_h( 2 * g_nEdges );
+      std::vector< T_real > l_hu( 2 * g_nEdges );
+      std::vector< T_real > l_b( 2 * g_nEdges, 0 );
+      for( tsunami_lab::t_idx l_va = 0; l_va < 2 * g_nEdges; l_va++ ) {
+        l_h[l_va] = l_hDist( l_gen );
+        l_hu[l_va] = l_h[l_va] * l_uDist( l_gen );
+        if( l_bathymetry == "varying" ) l_b[l_va] = l_bDist( l_gen );
+      }
+
+      T_real const * l_hL = l_h.data();
+      T_real const * l_hR = l_h.data() + g_nEdges;
+      T_real const * l_huL = l_hu.data();
+      T_real const * l_huR = l_hu.data() + g_nEdges;
+      T_real const * l_bL = l_b.data();
+      T_real const * l_bR = l_b.data() + g_nEdges;
+
+      double l_seconds = io_benchmark.measure( [&]() {
+        for( tsunami_lab::t_idx l_ed = 0; l_ed < g_nEdges; l_ed++ ) {
+          T_real l_netUpdateL[2];
+          T_real l_netUpdateR[2];
+
+          t_solver::netUpdates( l_hL[l_ed],
+                                l_hR[l_ed],
+                                l_huL[l_ed],
+                                l_huR[l_ed],
+                                l_bL[l_ed],
+                                l_bR[l_ed],
+                                l_netUpdateL,
+                                l_netUpdateR );
+
+          l_netUpdatesL[0][l_ed] = l_netUpdateL[0];
+          l_netUpdatesL[1][l_ed] = l_netUpdateL[1];
+          l_netUpdatesR[0][l_ed] = l_netUpdateR[0];
+          l_netUpdatesR[1][l_ed] = l_netUpdateR[1];
+        }
+      } );
+      io_benchmark.report( "FWave::netUpdates/" + i_type + "/" + l_bathymetry,
+                           "edges/s",
+                           g_nEdges / l_seconds );
+
+      l_seconds = io_benchmark.measure( [&]() {
+        t_solver::netUpdatesBatch( g_nEdges,
+                                   l_hL,
+                                   l_hR,
+                                   l_huL,
+                                   l_huR,
+                                   l_bL,
+                                   l_bR,
+                                   l_netUpdatesL,
+                                   l_netUpdatesR );
+      } );
+      io_benchmark.report( "FWave::netUpdatesBatch/" + i_type + "/" + l_bathymetry,
+                           "edges/s",
+                           g_nEdges / l_seconds );
+    }
+  }
+
+  /**
+   * Runs the case.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    runType< float >( io_benchmark, "float" );
+    runType< double >( io_benchmark, "double" );
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "FWave",
+                                                                         run );
+}
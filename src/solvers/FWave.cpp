@@ -0,0 +1,96 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * F-wave Riemann solver for the shallow water equations with bathymetry.
+ **/
+#include "FWave.h"
+#include "TargetClones.h"
+#include <algorithm>
+
+template< typename T_real,
+          bool     T_davisSpeeds >
+TSUNAMI_LAB_TARGET_CLONES
+T_real tsunami_lab::solvers::FWave< T_real, T_davisSpeeds >::netUpdatesBatch( t_idx                     i_nEdges,
+                                                                               T_real const * __restrict i_hL,
+                                                                               T_real const * __restrict i_hR,
+                                                                               T_real const * __restrict i_huL,
+                                                                               T_real const * __restrict i_huR,
+                                                                               T_real const * __restrict i_bL,
+                                                                               T_real const * __restrict i_bR,
+                                                                               T_real       *            o_netUpdatesL[2],
+                                                                               T_real       *            o_netUpdatesR[2] ) {
+  T_real * __restrict l_netUpdatesLH  = o_netUpdatesL[0];
+  T_real * __restrict l_netUpdatesLHu = o_netUpdatesL[1];
+  T_real * __restrict l_netUpdatesRH  = o_netUpdatesR[0];
+  T_real * __restrict l_netUpdatesRHu = o_netUpdatesR[1];
+
+  // maximum absolute wave speed, reduced on the fly
+  T_real l_speedMax = 0;
+
+#pragma omp simd reduction(max:l_speedMax)
+  for( t_idx l_ed = 0; l_ed < i_nEdges; l_ed++ ) {
+    // compute particle velocities
+    T_real l_uL = i_huL[l_ed] / i_hL[l_ed];
+    T_real l_uR = i_huR[l_ed] / i_hR[l_ed];
+
+    // compute wave speeds
+    T_real l_sL = 0;
+    T_real l_sR = 0;
+
+    waveSpeeds( i_hL[l_ed],
+                i_hR[l_ed],
+                l_uL,
+                l_uR,
+                l_sL,
+                l_sR );
+
+    l_speedMax = std::max( std::max( -l_sL, l_sR ), l_speedMax );
+
+    // compute wave strengths
+    T_real l_aL = 0;
+    T_real l_aR = 0;
+
+    waveStrengths( i_hL[l_ed],
+                   i_hR[l_ed],
+                   i_huL[l_ed],
+                   i_huR[l_ed],
+                   l_uL,
+                   l_uR,
+                   i_bL[l_ed],
+                   i_bR[l_ed],
+                   l_sL,
+                   l_sR,
+                   l_aL,
+                   l_aR );
+
+    // f-waves, which are scaled by the speeds already
+    T_real l_waveLH  = l_aL;
+    T_real l_waveLHu = l_aL * l_sL;
+
+    T_real l_waveRH  = l_aR;
+    T_real l_waveRHu = l_aR * l_sR;
+
+    // select net-updates through blends; matches the single-edge version
+    bool l_toLeft1  = l_sL < 0;
+    bool l_toRight2 = l_sR > 0;
+
+    T_real l_upLH  = l_toLeft1 ? l_waveLH  : 0;
+    T_real l_upLHu = l_toLeft1 ? l_waveLHu : 0;
+    T_real l_upRH  = l_toLeft1 ? 0 : l_waveLH;
+    T_real l_upRHu = l_toLeft1 ? 0 : l_waveLHu;
+
+    l_netUpdatesLH[l_ed]  = l_toRight2 ? l_upLH  : l_upLH  + l_waveRH;
+    l_netUpdatesLHu[l_ed] = l_toRight2 ? l_upLHu : l_upLHu + l_waveRHu;
+    l_netUpdatesRH[l_ed]  = l_toRight2 ? l_upRH  + l_waveRH  : l_upRH;
+    l_netUpdatesRHu[l_ed] = l_toRight2 ? l_upRHu + l_waveRHu : l_upRHu;
+  }
+
+  return l_speedMax;
+}
+
+// explicit instantiations of the batched version with the Roe eigenvalues and Davis' estimates as wave speeds
+template class tsunami_lab::solvers::FWave< float >;
+template class tsunami_lab::solvers::FWave< double >;
+template class tsunami_lab::solvers::FWave< float,  true >;
+template class tsunami_lab::solvers::FWave< double, true >;
@@ -0,0 +1,271 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * F-wave Riemann solver for the one-dimensional shallow water equations with bathymetry.
+ **/
+#ifndef TSUNAMI_LAB_SOLVERS_F_WAVE
+#define TSUNAMI_LAB_SOLVERS_F_WAVE
+
+#include "../constants.h"
+#include <cmath>
+
+namespace tsunami_lab {
+  namespace solvers {
+    template< typename T_real = t_real,
+              bool     T_davisSpeeds = false >
+    class FWave;
+  }
+}
+
+/**
+ * F-wave solver, templated on the floating point type and the wave speeds.
+ * The jump in the fluxes, reduced by the bathymetry source term, is decomposed into two waves.
+ * By default, their speeds are the eigenvalues of the Roe matrix.
+ * Alternatively, Davis' estimates, i.e., the extremes of the characteristic speeds of the left and right states, are used:
+ * this is the HLL solver in f-wave formulation, see Hll.h.
+ * The source term is discretized such that lakes at rest (h + b constant, hu = 0) yield zero net-updates exactly.
+ * Dry cells are not supported.
+ *
+ * The single-edge functions are defined in this header to allow inlining into the callers' loops;
+ * the helpers are declared inline explicitly since they exceed the compiler's early-inlining limit otherwise, which prevents vectorization.
+ * The batched version is explicitly instantiated for float and double with both wave speeds.
+ **/
+template< typename T_real,
+          bool     T_davisSpeeds >
+class tsunami_lab::solvers::FWave {
+  public:
+    //! floating point type of the solver
+    typedef T_real t_realSolver;
+
+  private:
+    //! gravity
+    static T_real constexpr m_g = 9.80665;
+
+    //! square root of gravity
+    static T_real constexpr m_gSqrt = 3.131557121;
+
+    /**
+     * Computes the wave speeds: the eigenvalues of the Roe matrix or Davis' estimates, which bound the characteristic speeds of both sides.
+     *
+     * @param i_hL height of the left side.
+     * @param i_hR height of the right side.
+     * @param i_uL particle velocity of the left side.
+     * @param i_uR particle velocity of the right side.
+     * @param o_waveSpeedL will be set to the speed of the wave propagating to the left.
+     * @param o_waveSpeedR will be set to the speed of the wave propagating to the right.
+     **/
+    static void waveSpeeds( T_real   i_hL,
+                            T_real   i_hR,
+                            T_real   i_uL,
+                            T_real   i_uR,
+                            T_real & o_waveSpeedL,
+                            T_real & o_waveSpeedR );
+
+    /**
+     * Computes the wave strengths by decomposing the flux jump minus the bathymetry source term.
+     *
+     * @param i_hL height of the left side.
+     * @param i_hR height of the right side.
+     * @param i_huL momentum of the left side.
+     * @param i_huR momentum of the right side.
+     * @param i_uL particle velocity of the left side.
+     * @param i_uR particle velocity of the right side.
+     * @param i_bL bathymetry of the left side.
+     * @param i_bR bathymetry of the right side.
+     * @param i_waveSpeedL speed of the wave propagating to the left.
+     * @param i_waveSpeedR speed of the wave propagating to the right.
+     * @param o_strengthL will be set to the strength of the wave propagating to the left.
+     * @param o_strengthR will be set to the strength of the wave propagating to the right.
+     **/
+    static void waveStrengths( T_real   i_hL,
+                               T_real   i_hR,
+                               T_real   i_huL,
+                               T_real   i_huR,
+                               T_real   i_uL,
+                               T_real   i_uR,
+                               T_real   i_bL,
+                               T_real   i_bR,
+                               T_real   i_waveSpeedL,
+                               T_real   i_waveSpeedR,
+                               T_real & o_strengthL,
+                               T_real & o_strengthR );
+
+  public:
+    /**
+     * Computes the net-updates.
+     * The waves are assigned to the sides through selects, which compile to blends instead of branches.
+     *
+     * @param i_hL height of the left side.
+     * @param i_hR height of the right side.
+     * @param i_huL momentum of the left side.
+     * @param i_huR momentum of the right side.
+     * @param i_bL bathymetry of the left side.
+     * @param i_bR bathymetry of the right side.
+     * @param o_netUpdateL will be set to the net-updates for the left side; 0: height, 1: momentum.
+     * @param o_netUpdateR will be set to the net-updates for the right side; 0: height, 1: momentum.
+     **/
+    static void netUpdates( T_real i_hL,
+                            T_real i_hR,
+                            T_real i_huL,
+                            T_real i_huR,
+                            T_real i_bL,
+                            T_real i_bR,
+                            T_real o_netUpdateL[2],
+                            T_real o_netUpdateR[2] );
+
+    /**
+     * Computes the net-updates for a batch of edges.
+     * The input and output arrays are structure-of-arrays, i.e., entry i of every array belongs to edge i.
+     * Equivalent to calling the single-edge version for every edge, but vectorized.
+     * The instruction set (AVX-512, AVX2 or scalar fallback) is selected at runtime.
+     *
+     * @param i_nEdges number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param i_bL bathymetry of the left sides.
+     * @param i_bR bathymetry of the right sides.
+     * @param o_netUpdatesL will be set to the net-updates for the left sides; 0: heights, 1: momenta.
+     * @param o_netUpdatesR will be set to the net-updates for the right sides; 0: heights, 1: momenta.
+     * @return maximum absolute wave speed of all edges in the batch.
+     **/
+    static T_real netUpdatesBatch( t_idx                     i_nEdges,
+                                   T_real const * __restrict i_hL,
+                                   T_real const * __restrict i_hR,
+                                   T_real const * __restrict i_huL,
+                                   T_real const * __restrict i_huR,
+                                   T_real const * __restrict i_bL,
+                                   T_real const * __restrict i_bR,
+                                   T_real       *            o_netUpdatesL[2],
+                                   T_real       *            o_netUpdatesR[2] );
+};
+
+template< typename T_real,
+          bool     T_davisSpeeds >
+inline void tsunami_lab::solvers::FWave< T_real, T_davisSpeeds >::waveSpeeds( T_real   i_hL,
+                                                                              T_real   i_hR,
+                                                                              T_real   i_uL,
+                                                                              T_real   i_uR,
+                                                                              T_real & o_waveSpeedL,
+                                                                              T_real & o_waveSpeedR ) {
+  if constexpr( T_davisSpeeds ) {
+    // gravity wave speeds of both sides
+    T_real l_cL = m_gSqrt * std::sqrt( i_hL );
+    T_real l_cR = m_gSqrt * std::sqrt( i_hR );
+
+    // extremes of the characteristic speeds through selects, which compile to blends
+    T_real l_sCharLL = i_uL - l_cL;
+    T_real l_sCharLR = i_uR - l_cR;
+    T_real l_sCharRL = i_uL + l_cL;
+    T_real l_sCharRR = i_uR + l_cR;
+
+    o_waveSpeedL = ( l_sCharLL < l_sCharLR ) ? l_sCharLL : l_sCharLR;
+    o_waveSpeedR = ( l_sCharRR > l_sCharRL ) ? l_sCharRR : l_sCharRL;
+  }
+  else {
+    // pre-compute square-root ops
+    T_real l_hSqrtL = std::sqrt( i_hL );
+    T_real l_hSqrtR = std::sqrt( i_hR );
+
+    // compute Roe averages
+    T_real l_hRoe = T_real(0.5) * ( i_hL + i_hR );
+    T_real l_uRoe = l_hSqrtL * i_uL + l_hSqrtR * i_uR;
+    l_uRoe /= l_hSqrtL + l_hSqrtR;
+
+    // compute wave speeds
+    T_real l_ghSqrtRoe = m_gSqrt * std::sqrt( l_hRoe );
+    o_waveSpeedL = l_uRoe - l_ghSqrtRoe;
+    o_waveSpeedR = l_uRoe + l_ghSqrtRoe;
+  }
+}
+
+template< typename T_real,
+          bool     T_davisSpeeds >
+inline void tsunami_lab::solvers::FWave< T_real, T_davisSpeeds >::waveStrengths( T_real   i_hL,
+                                                                                 T_real   i_hR,
+                                                                                 T_real   i_huL,
+                                                                                 T_real   i_huR,
+                                                                                 T_real   i_uL,
+                                                                                 T_real   i_uR,
+                                                                                 T_real   i_bL,
+                                                                                 T_real   i_bR,
+                                                                                 T_real   i_waveSpeedL,
+                                                                                 T_real   i_waveSpeedR,
+                                                                                 T_real & o_strengthL,
+                                                                                 T_real & o_strengthR ) {
+  // compute inverse of right eigenvector-matrix
+  T_real l_detInv = 1 / (i_waveSpeedR - i_waveSpeedL);
+
+  // jump in the fluxes minus the source term;
+  // the jumps in the hydrostatic pressure and the bathymetry share the average height, i.e., they cancel for lakes at rest
+  T_real l_fluxJumpH  = i_huR - i_huL;
+  T_real l_fluxJumpHu = i_huR * i_uR - i_huL * i_uL;
+  l_fluxJumpHu += m_g * T_real(0.5) * ( i_hL + i_hR ) * ( (i_hR + i_bR) - (i_hL + i_bL) );
+
+  // compute wave strengths
+  o_strengthL = l_detInv * ( i_waveSpeedR * l_fluxJumpH - l_fluxJumpHu );
+  o_strengthR = l_detInv * ( l_fluxJumpHu - i_waveSpeedL * l_fluxJumpH );
+}
+
+template< typename T_real,
+          bool     T_davisSpeeds >
+void tsunami_lab::solvers::FWave< T_real, T_davisSpeeds >::netUpdates( T_real i_hL,
+                                                                       T_real i_hR,
+                                                                       T_real i_huL,
+                                                                       T_real i_huR,
+                                                                       T_real i_bL,
+                                                                       T_real i_bR,
+                                                                       T_real o_netUpdateL[2],
+                                                                       T_real o_netUpdateR[2] ) {
+  // compute particle velocities
+  T_real l_uL = i_huL / i_hL;
+  T_real l_uR = i_huR / i_hR;
+
+  // compute wave speeds
+  T_real l_sL = 0;
+  T_real l_sR = 0;
+
+  waveSpeeds( i_hL,
+              i_hR,
+              l_uL,
+              l_uR,
+              l_sL,
+              l_sR );
+
+  // compute wave strengths
+  T_real l_aL = 0;
+  T_real l_aR = 0;
+
+  waveStrengths( i_hL,
+                 i_hR,
+                 i_huL,
+                 i_huR,
+                 l_uL,
+                 l_uR,
+                 i_bL,
+                 i_bR,
+                 l_sL,
+                 l_sR,
+                 l_aL,
+                 l_aR );
+
+  // f-waves, which are scaled by the speeds already
+  T_real l_waveL[2] = { l_aL, l_aL * l_sL };
+  T_real l_waveR[2] = { l_aR, l_aR * l_sR };
+
+  // set net-updates depending on wave speeds
+  bool l_toLeft1  = l_sL < 0;
+  bool l_toRight2 = l_sR > 0;
+
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    T_real l_upL = l_toLeft1 ? l_waveL[l_qt] : 0;
+    T_real l_upR = l_toLeft1 ? 0 : l_waveL[l_qt];
+
+    o_netUpdateL[l_qt] = l_toRight2 ? l_upL : l_upL + l_waveR[l_qt];
+    o_netUpdateR[l_qt] = l_toRight2 ? l_upR + l_waveR[l_qt] : l_upR;
+  }
+}
+
+#endif
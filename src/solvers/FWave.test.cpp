@@ -0,0 +1,214 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests of the f-wave Riemann solver.
+ **/
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#define private public
+#include "FWave.h"
+#undef public
+
+TEST_CASE( "Test the derivation of the f-wave net-updates.", "[FWaveUpdates]" ) {
+  /*
+   * Test case (flat bathymetry):
+   *
+   *      left | right
+   *  h:    10 | 9
+   *  u:    -3 | 3
+   *  hu:  -30 | 27
+   *  b:     0 | 0
+   *
+   * Without bathymetry, the decomposition of the flux jump into the eigenvectors of the Roe matrix
+   * yields the same net-updates as the Roe solver, see the Roe solver's tests for the derivation.
+   */
+  float l_netUpdatesL[2] = { -5, 3 };
+  float l_netUpdatesR[2] = {  4, 7 };
+
+  tsunami_lab::solvers::FWave<>::netUpdates( 10,
+                                             9,
+                                             -30,
+                                             27,
+                                             0,
+                                             0,
+                                             l_netUpdatesL,
+                                             l_netUpdatesR );
+
+  REQUIRE( l_netUpdatesL[0] == Approx( 33.5590017014261442469872822877 ) );
+  REQUIRE( l_netUpdatesL[1] == Approx( -326.566316905910925895832482536 ) );
+
+  REQUIRE( l_netUpdatesR[0] == Approx( 23.4409982985738557530127177123 ) );
+  REQUIRE( l_netUpdatesR[1] == Approx( 224.403141905910925895832482535 ) );
+
+  /*
+   * Test case (bathymetry):
+   *
+   *      left | right
+   *  h:    10 | 9
+   *  hu:  -30 | 27
+   *  b:    -5 | -3
+   *
+   * The source term is subtracted from the jump in the momentum flux:
+   *
+   *   df = | 27 - -30                                                          |   |  57       |
+   *        | 27 * 3 - -30 * -3 + 9.80665 * (10 + 9) / 2 * ((9 - 3) - (10 - 5)) | = | 84.163175 |
+   *
+   * Decomposition into the eigenvectors (1, s1) and (1, s2) with the Roe speeds of above yields the f-waves:
+   *
+   *   Z1 = | 23.9068944185578067956150758100 |   Z2 = | 33.0931055814421932043849241899 |
+   *        | -232.640604997350764336377150686 |       | 316.803779997350764336377150685 |
+   */
+  tsunami_lab::solvers::FWave<>::netUpdates( 10,
+                                             9,
+                                             -30,
+                                             27,
+                                             -5,
+                                             -3,
+                                             l_netUpdatesL,
+                                             l_netUpdatesR );
+
+  REQUIRE( l_netUpdatesL[0] == Approx( 23.9068944185578067956150758100 ) );
+  REQUIRE( l_netUpdatesL[1] == Approx( -232.640604997350764336377150686 ) );
+
+  REQUIRE( l_netUpdatesR[0] == Approx( 33.0931055814421932043849241899 ) );
+  REQUIRE( l_netUpdatesR[1] == Approx( 316.803779997350764336377150685 ) );
+
+  /*
+   * Test case (supercritical flow):
+   *
+   *      left | right
+   *  h:     2 | 1.5
+   *  hu:   20 | 15
+   *  b:    -4 | -3
+   *
+   * Both Roe speeds are positive (5.857 and 14.143), thus both f-waves update the right cell
+   * and their sum is the jump in the fluxes minus the source term.
+   */
+  tsunami_lab::solvers::FWave<>::netUpdates( 2,
+                                             1.5,
+                                             20,
+                                             15,
+                                             -4,
+                                             -3,
+                                             l_netUpdatesL,
+                                             l_netUpdatesR );
+
+  REQUIRE( l_netUpdatesL[0] == 0 );
+  REQUIRE( l_netUpdatesL[1] == 0 );
+
+  REQUIRE( l_netUpdatesR[0] == Approx( -5 ) );
+  REQUIRE( l_netUpdatesR[1] == Approx( -41.41918125 ) );
+}
+
+TEST_CASE( "Test the well-balancedness of the f-wave solver.", "[FWaveLakeAtRest]" ) {
+  /*
+   * Test case (lake at rest):
+   *
+   *   The water surface h + b is constant and the water does not move.
+   *   The hydrostatic pressure and the source term cancel exactly, thus all net-updates are zero.
+   */
+  float l_hL[4] = { 10, 100, 4, 0.5f };
+  float l_hR[4] = {  5,  20, 4, 7.5f };
+  float l_bL[4] = { -10, -100, -4, -0.5f };
+  float l_bR[4] = { -5,   -20, -4, -7.5f };
+
+  for( unsigned short l_ed = 0; l_ed < 4; l_ed++ ) {
+    float l_netUpdatesL[2] = { -5, 3 };
+    float l_netUpdatesR[2] = {  4, 7 };
+
+    tsunami_lab::solvers::FWave< float >::netUpdates( l_hL[l_ed],
+                                                      l_hR[l_ed],
+                                                      0,
+                                                      0,
+                                                      l_bL[l_ed],
+                                                      l_bR[l_ed],
+                                                      l_netUpdatesL,
+                                                      l_netUpdatesR );
+
+    REQUIRE( l_netUpdatesL[0] == 0 );
+    REQUIRE( l_netUpdatesL[1] == 0 );
+    REQUIRE( l_netUpdatesR[0] == 0 );
+    REQUIRE( l_netUpdatesR[1] == 0 );
+  }
+}
+
+TEST_CASE( "Test the batched derivation of the f-wave net-updates.", "[FWaveUpdatesBatch]" ) {
+  /*
+   * Test case:
+   *
+   *   Random edges with subcritical and supercritical flows in both directions and random bathymetry.
+   *   The batched net-updates have to match the single-edge version.
+   */
+  std::size_t l_nEdges = 100;
+
+  std::mt19937 l_gen( 7 );
+  std::uniform_real_distribution< double > l_hDist( 0.5, 10 );
+  std::uniform_real_distribution< double > l_uDist( -15, 15 );
+  std::uniform_real_distribution< double > l_bDist( -20, 0 );
+
+  std::vector< double > l_hL( l_nEdges ), l_hR( l_nEdges );
+  std::vector< double > l_huL( l_nEdges ), l_huR( l_nEdges );
+  std::vector< double > l_bL( l_nEdges ), l_bR( l_nEdges );
+  for( std::size_t l_ed = 0; l_ed < l_nEdges; l_ed++ ) {
+    l_hL[l_ed] = l_hDist( l_gen );
+    l_hR[l_ed] = l_hDist( l_gen );
+    l_huL[l_ed] = l_hL[l_ed] * l_uDist( l_gen );
+    l_huR[l_ed] = l_hR[l_ed] * l_uDist( l_gen );
+    l_bL[l_ed] = l_bDist( l_gen );
+    l_bR[l_ed] = l_bDist( l_gen );
+  }
+
+  std::vector< double > l_netUpdates( 4 * l_nEdges, 0 );
+  double * l_netUpdatesL[2] = { l_netUpdates.data(), l_netUpdates.data() + l_nEdges };
+  double * l_netUpdatesR[2] = { l_netUpdates.data() + 2 * l_nEdges, l_netUpdates.data() + 3 * l_nEdges };
+
+  double l_speedMax = tsunami_lab::solvers::FWave< double >::netUpdatesBatch( l_nEdges,
+                                                                              l_hL.data(),
+                                                                              l_hR.data(),
+                                                                              l_huL.data(),
+                                                                              l_huR.data(),
+                                                                              l_bL.data(),
+                                                                              l_bR.data(),
+                                                                              l_netUpdatesL,
+                                                                              l_netUpdatesR );
+
+  double l_speedMaxRef = 0;
+  for( std::size_t l_ed = 0; l_ed < l_nEdges; l_ed++ ) {
+    double l_waveSpeedL = 0;
+    double l_waveSpeedR = 0;
+    tsunami_lab::solvers::FWave< double >::waveSpeeds( l_hL[l_ed],
+                                                       l_hR[l_ed],
+                                                       l_huL[l_ed] / l_hL[l_ed],
+                                                       l_huR[l_ed] / l_hR[l_ed],
+                                                       l_waveSpeedL,
+                                                       l_waveSpeedR );
+    l_speedMaxRef = std::max( l_speedMaxRef, std::abs( l_waveSpeedL ) );
+    l_speedMaxRef = std::max( l_speedMaxRef, std::abs( l_waveSpeedR ) );
+
+    double l_netUpdatesRefL[2] = { 0 };
+    double l_netUpdatesRefR[2] = { 0 };
+    tsunami_lab::solvers::FWave< double >::netUpdates( l_hL[l_ed],
+                                                       l_hR[l_ed],
+                                                       l_huL[l_ed],
+                                                       l_huR[l_ed],
+                                                       l_bL[l_ed],
+                                                       l_bR[l_ed],
+                                                       l_netUpdatesRefL,
+                                                       l_netUpdatesRefR );
+
+    REQUIRE( l_netUpdatesL[0][l_ed] == Approx( l_netUpdatesRefL[0] ).epsilon( 1E-12 ) );
+    REQUIRE( l_netUpdatesL[1][l_ed] == Approx( l_netUpdatesRefL[1] ).epsilon( 1E-12 ) );
+    REQUIRE( l_netUpdatesR[0][l_ed] == Approx( l_netUpdatesRefR[0] ).epsilon( 1E-12 ) );
+    REQUIRE( l_netUpdatesR[1][l_ed] == Approx( l_netUpdatesRefR[1] ).epsilon( 1E-12 ) );
+
+    // the f-waves sum up to the jump in the fluxes minus the source term
+    double l_fluxJumpH = l_huR[l_ed] - l_huL[l_ed];
+    REQUIRE( l_netUpdatesL[0][l_ed] + l_netUpdatesR[0][l_ed] == Approx( l_fluxJumpH ).margin( 1E-9 ) );
+  }
+
+  REQUIRE( l_speedMax == Approx( l_speedMaxRef ) );
+}
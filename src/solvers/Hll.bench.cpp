@@ -0,0 +1,234 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the HLL Riemann solver in comparison to the Roe solver.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "../patches/WavePropagation1d.h"
+#include "../setups/DamBreak1d.h"
+#include "Roe.h"
+#include "Hll.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  //! number of edges per call; small enough to stay in the L1 and L2 caches
+  tsunami_lab::t_idx constexpr g_nEdges = 4096;
+
+  //! gravity
+  double constexpr g_g = 9.80665;
+
+  /**
+   * Computes the exact height of a dam break without initial momenta, i.e., a left rarefaction and a right shock.
+   * The middle state's height is derived through bisection of the shallow water equations' Riemann invariants
+   * and the Rankine-Hugoniot conditions.
+   *
+   * @param i_hL height left of the dam.
+   * @param i_hR height right of the dam; has to be smaller than i_hL.
+   * @param i_xi similarity variable (x - x_dam) / t.
+   * @return height at the given similarity variable.
+   **/
+  double damBreakHeight( double i_hL,
+                         double i_hR,
+                         double i_xi ) {
+    // velocity behind the rarefaction minus velocity behind the shock is zero for the middle state's height
+    double l_hLo = i_hR;
+    double l_hHi = i_hL;
+    for( unsigned short l_it = 0; l_it < 100; l_it++ ) {
+      double l_hMid = 0.5 * ( l_hLo + l_hHi );
+      double l_uRare = 2 * ( std::sqrt( g_g * i_hL ) - std::sqrt( g_g * l_hMid ) );
+      double l_uShock = ( l_hMid - i_hR ) * std::sqrt( 0.5 * g_g * ( l_hMid + i_hR ) / ( l_hMid * i_hR ) );
+      if( l_uRare > l_uShock ) l_hLo = l_hMid;
+      else                     l_hHi = l_hMid;
+    }
+    double l_hM = 0.5 * ( l_hLo + l_hHi );
+    double l_uM = 2 * ( std::sqrt( g_g * i_hL ) - std::sqrt( g_g * l_hM ) );
+
+    // head and tail of the rarefaction, shock speed through conservation of mass
+    double l_sHead = -std::sqrt( g_g * i_hL );
+    double l_sTail = l_uM - std::sqrt( g_g * l_hM );
+    double l_sShock = l_hM * l_uM / ( l_hM - i_hR );
+
+    if( i_xi <= l_sHead ) return i_hL;
+    if( i_xi <  l_sTail ) {
+      double l_c = ( 2 * std::sqrt( g_g * i_hL ) - i_xi ) / 3;
+      return l_c * l_c / g_g;
+    }
+    if( i_xi <  l_sShock ) return l_hM;
+    return i_hR;
+  }
+
+  /**
+   * Measures the batched net-updates of the Roe and the HLL solver for the same subcritical flows.
+   * The HLL solver gets flat bathymetry, which makes both solvers compute the same quantities.
+   *
+   * @param io_benchmark benchmark which records the results.
+   * @param i_type name of the floating point type.
+   **/
+  template< typename T_real >
+  void runEdges( tsunami_lab::benchmarks::Benchmark & io_benchmark,
+                 std::string const                  & i_type ) {
+    std::vector< T_real > l_netUpdates( 4 * g_nEdges );
+    T_real * l_netUpdatesL[2] = { l_netUpdates.data(),
+                                  l_netUpdates.data() + g_nEdges };
+    T_real * l_netUpdatesR[2] = { l_netUpdates.data() + 2 * g_nEdges,
+                                  l_netUpdates.data() + 3 * g_nEdges };
+
+    std::mt19937 l_gen( 42 );
+    std::uniform_real_distribution< T_real > l_hDist( 1, 10 );
+    std::uniform_real_distribution< T_real > l_uDist( -2, 2 );
+
+    // left sides first, right sides second
+    std::vector< T_real > l_h( 2 * g_nEdges );
+    std::vector< T_real > l_hu( 2 * g_nEdges );
+    std::vector< T_real > l_b( 2 * g_nEdges, 0 );
+    for( tsunami_lab::t_idx l_va = 0; l_va < 2 * g_nEdges; l_va++ ) {
+      l_h[l_va] = l_hDist( l_gen );
+      l_hu[l_va] = l_h[l_va] * l_uDist( l_gen );
+    }
+
+    T_real const * l_hL = l_h.data();
+    T_real const * l_hR = l_h.data() + g_nEdges;
+    T_real const * l_huL = l_hu.data();
+    T_real const * l_huR = l_hu.data() + g_nEdges;
+    T_real const * l_bL = l_b.data();
+    T_real const * l_bR = l_b.data() + g_nEdges;
+
+    double l_seconds = io_benchmark.measure( [&]() {
+      tsunami_lab::solvers::Roe< T_real >::netUpdatesBatch( g_nEdges,
+                                                            l_hL,
+                                                            l_hR,
+                                                            l_huL,
+                                                            l_huR,
+                                                            l_netUpdatesL,
+                                                            l_netUpdatesR );
+    } );
+    io_benchmark.report( "Roe::netUpdatesBatch/" + i_type,
+                         "edges/s",
+                         g_nEdges / l_seconds );
+
+    l_seconds = io_benchmark.measure( [&]() {
+      tsunami_lab::solvers::Hll< T_real >::netUpdatesBatch( g_nEdges,
+                                                            l_hL,
+                                                            l_hR,
+                                                            l_huL,
+                                                            l_huR,
+                                                            l_bL,
+                                                            l_bR,
+                                                            l_netUpdatesL,
+                                                            l_netUpdatesR );
+    } );
+    io_benchmark.report( "Hll::netUpdatesBatch/" + i_type,
+                         "edges/s",
+                         g_nEdges / l_seconds );
+  }
+
+  /**
+   * Simulates the dam break of the standalone application, i.e., the DamBreak1d setup with heights 10 and 5,
+   * until the waves are about to reach the boundaries.
+   * Reports the throughput of the edges and the L1 error of the heights w.r.t. the exact solution.
+   *
+   * @param io_benchmark benchmark which records the results.
+   * @param i_name name of the solver.
+   **/
+  template< typename T_solver >
+  void runDamBreak( tsunami_lab::benchmarks::Benchmark & io_benchmark,
+                    std::string const                  & i_name ) {
+    typedef tsunami_lab::t_real t_real;
+
+    tsunami_lab::setups::DamBreak1d l_setup( 10,
+                                             5,
+                                             5 );
+    // the rarefaction's head reaches the left boundary at about t = 0.5
+    t_real l_endTime = 0.4;
+    t_real l_cfl = 0.5;
+
+    for( tsunami_lab::t_idx l_nCells : { tsunami_lab::t_idx(1) << 8,
+                                         tsunami_lab::t_idx(1) << 10,
+                                         tsunami_lab::t_idx(1) << 12 } ) {
+      t_real l_dxy = t_real(10) / l_nCells;
+
+      std::vector< t_real > l_hInit( l_nCells );
+      std::vector< t_real > l_huInit( l_nCells );
+      std::vector< t_real > l_bInit( l_nCells );
+      l_setup.getValues( l_dxy,
+                         0,
+                         0,
+                         l_nCells,
+                         1,
+                         l_nCells,
+                         l_hInit.data(),
+                         l_huInit.data(),
+                         nullptr,
+                         l_bInit.data() );
+
+      std::vector< t_real > l_h( l_nCells );
+      tsunami_lab::t_idx l_nSteps = 0;
+
+      double l_seconds = io_benchmark.measure( [&]() {
+        tsunami_lab::patches::WavePropagation1d< t_real, T_solver > l_waveProp( l_nCells );
+        l_waveProp.setValues( 0,
+                              0,
+                              l_nCells,
+                              1,
+                              l_nCells,
+                              l_hInit.data(),
+                              l_huInit.data(),
+                              nullptr,
+                              l_bInit.data() );
+
+        // initial speed of the gravity waves on the left side, adapted to the previous step afterwards
+        t_real l_dt = l_cfl * l_dxy / std::sqrt( t_real(g_g) * 10 );
+        t_real l_simTime = 0;
+        l_nSteps = 0;
+        while( l_simTime < l_endTime ) {
+          l_dt = std::min( l_dt, l_endTime - l_simTime );
+          l_waveProp.setGhostOutflow();
+          t_real l_speedMax = l_waveProp.timeStep( l_dt / l_dxy );
+          l_simTime += l_dt;
+          l_nSteps++;
+          if( l_speedMax > 0 ) l_dt = l_cfl * l_dxy / l_speedMax;
+        }
+
+        std::copy( l_waveProp.getHeight(),
+                   l_waveProp.getHeight() + l_nCells,
+                   l_h.begin() );
+      } );
+
+      // cell centers relative to the dam, which is located at an edge
+      double l_errorL1 = 0;
+      for( tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++ ) {
+        double l_x = ( l_ce + 0.5 ) * l_dxy - 5;
+        l_errorL1 += std::abs( l_h[l_ce] - damBreakHeight( 10, 5, l_x / l_endTime ) ) * l_dxy;
+      }
+
+      std::string l_prefix = "DamBreak1d/" + i_name + "/" + std::to_string( l_nCells );
+      io_benchmark.report( l_prefix,
+                           "edges/s",
+                           double(l_nCells+1) * l_nSteps / l_seconds );
+      io_benchmark.report( l_prefix + "/L1",
+                           "m^2",
+                           l_errorL1 );
+    }
+  }
+
+  /**
+   * Runs the case.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    runEdges< float >( io_benchmark, "float" );
+    runEdges< double >( io_benchmark, "double" );
+
+    runDamBreak< tsunami_lab::solvers::Roe< tsunami_lab::t_real > >( io_benchmark, "roe" );
+    runDamBreak< tsunami_lab::solvers::Hll< tsunami_lab::t_real > >( io_benchmark, "hll" );
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "Hll",
+                                                                         run );
+}
@@ -0,0 +1,32 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * HLL Riemann solver for the one-dimensional shallow water equations with bathymetry.
+ **/
+#ifndef TSUNAMI_LAB_SOLVERS_HLL
+#define TSUNAMI_LAB_SOLVERS_HLL
+
+#include "../constants.h"
+#include "FWave.h"
+
+namespace tsunami_lab {
+  namespace solvers {
+    /**
+     * HLL solver in f-wave formulation, templated on the floating point type.
+     * The jump in the fluxes, reduced by the bathymetry source term, is decomposed into two waves whose speeds are Davis' estimates,
+     * i.e., the extremes of the characteristic speeds of the left and right states.
+     * Compared to the f-wave solver, this adds numerical diffusion at shocks and avoids entropy-violating transonic rarefactions.
+     *
+     * The HLLE solver would bound the speeds by Einfeldt's estimates, which also take the Roe eigenvalues into account.
+     * These require the Roe averages, i.e., a third square root and a division per edge,
+     * which made the solver as expensive as the Roe solver; thus, Davis' estimates are used instead.
+     * They cost the square roots of the two heights only.
+     * The decomposition and the batched version are shared with the f-wave solver.
+     **/
+    template< typename T_real = t_real >
+    using Hll = FWave< T_real, true >;
+  }
+}
+
+#endif
@@ -0,0 +1,261 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests of the HLL Riemann solver.
+ **/
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#define private public
+#include "Hll.h"
+#undef public
+
+TEST_CASE( "Test the derivation of the Davis speeds.", "[HllSpeeds]" ) {
+  /*
+   * Test case:
+   *
+   *      left | right
+   *  h:    10 | 9
+   *  u:    -3 | 3
+   *
+   * The characteristic speeds of the sides are:
+   *
+   *   u_l -+ sqrt(g * h_l) = -3 -+ sqrt(9.80665 * 10) = -12.902853124226371 and 6.902853124226371
+   *   u_r -+ sqrt(g * h_r) =  3 -+ sqrt(9.80665 *  9) =  -6.394671362000908 and 12.394671362000908
+   *
+   * The Davis speeds are the minimum and maximum of them.
+   */
+  float l_waveSpeedL = 0;
+  float l_waveSpeedR = 0;
+  tsunami_lab::solvers::Hll<>::waveSpeeds( 10,
+                                           9,
+                                           -3,
+                                           3,
+                                           l_waveSpeedL,
+                                           l_waveSpeedR );
+
+  REQUIRE( l_waveSpeedL == Approx( -12.9028531242263711562621756249 ) );
+  REQUIRE( l_waveSpeedR == Approx( 12.3946713620009082252769918220 ) );
+
+  /*
+   * Test case (supercritical flow to the right):
+   *
+   *      left | right
+   *  h:     4 | 4
+   *  u:     2 | 10
+   *
+   * The Davis speeds are 2 - sqrt(g * 4) of the left side and 10 + sqrt(g * 4) of the right side.
+   */
+  tsunami_lab::solvers::Hll<>::waveSpeeds( 4,
+                                           4,
+                                           2,
+                                           10,
+                                           l_waveSpeedL,
+                                           l_waveSpeedR );
+
+  REQUIRE( l_waveSpeedL == Approx( 2 - 6.26311424 ) );
+  REQUIRE( l_waveSpeedR == Approx( 10 + 6.26311424 ) );
+}
+
+TEST_CASE( "Test the derivation of the HLL net-updates.", "[HllUpdates]" ) {
+  /*
+   * Test case (flat bathymetry):
+   *
+   *      left | right
+   *  h:    10 | 9
+   *  u:    -3 | 3
+   *  hu:  -30 | 27
+   *  b:     0 | 0
+   *
+   * Jump in the fluxes:
+   *
+   *   df = | 27 - -30                                          |   |  57       |
+   *        | 27 * 3 - -30 * -3 + 9.80665 * (10 + 9) / 2 * (-1) | = | -102.16318 |
+   *
+   * Decomposition into (1, s1) and (1, s2) with the Davis speeds of above yields:
+   *
+   *   Z1 = | 31.9659515726256096383584782452  |   Z2 = | 25.0340484273743903616415217548 |
+   *        | -412.451978117721229623214171796 |        | 310.288803117721229623214171796 |
+   */
+  float l_netUpdatesL[2] = { -5, 3 };
+  float l_netUpdatesR[2] = {  4, 7 };
+
+  tsunami_lab::solvers::Hll<>::netUpdates( 10,
+                                           9,
+                                           -30,
+                                           27,
+                                           0,
+                                           0,
+                                           l_netUpdatesL,
+                                           l_netUpdatesR );
+
+  REQUIRE( l_netUpdatesL[0] == Approx( 31.9659515726256096383584782452 ) );
+  REQUIRE( l_netUpdatesL[1] == Approx( -412.451978117721229623214171796 ) );
+
+  REQUIRE( l_netUpdatesR[0] == Approx( 25.0340484273743903616415217548 ) );
+  REQUIRE( l_netUpdatesR[1] == Approx( 310.288803117721229623214171796 ) );
+
+  /*
+   * Test case (dam break):
+   *
+   *      left | right
+   *  h:    10 | 8
+   *  hu:    0 | 0
+   *  b:     0 | 0
+   *
+   * Davis speeds: -+ sqrt(g * 10) = -+ 9.9028531242263711, since the left side has the larger height.
+   * Jump in the fluxes: (0, 9.80665 * (10 + 8) / 2 * (-2)) = (0, -176.5197).
+   */
+  tsunami_lab::solvers::Hll<>::netUpdates( 10,
+                                           8,
+                                           0,
+                                           0,
+                                           0,
+                                           0,
+                                           l_netUpdatesL,
+                                           l_netUpdatesR );
+
+  REQUIRE( l_netUpdatesL[0] == Approx( 8.912567811803735 ) );
+  REQUIRE( l_netUpdatesL[1] == Approx( -88.25985 ) );
+
+  REQUIRE( l_netUpdatesR[0] == Approx( -8.912567811803735 ) );
+  REQUIRE( l_netUpdatesR[1] == Approx( -88.25985 ) );
+
+  /*
+   * Test case (supercritical flow):
+   *
+   *      left | right
+   *  h:     2 | 1.5
+   *  hu:   20 | 15
+   *  b:    -4 | -3
+   *
+   * Both Davis speeds are positive, thus both waves update the right cell
+   * and their sum is the jump in the fluxes minus the source term.
+   */
+  tsunami_lab::solvers::Hll<>::netUpdates( 2,
+                                           1.5,
+                                           20,
+                                           15,
+                                           -4,
+                                           -3,
+                                           l_netUpdatesL,
+                                           l_netUpdatesR );
+
+  REQUIRE( l_netUpdatesL[0] == 0 );
+  REQUIRE( l_netUpdatesL[1] == 0 );
+
+  REQUIRE( l_netUpdatesR[0] == Approx( -5 ) );
+  REQUIRE( l_netUpdatesR[1] == Approx( -41.41918125 ) );
+}
+
+TEST_CASE( "Test the well-balancedness of the HLL solver.", "[HllLakeAtRest]" ) {
+  /*
+   * Test case (lake at rest):
+   *
+   *   The water surface h + b is constant and the water does not move.
+   *   The hydrostatic pressure and the source term cancel exactly, thus all net-updates are zero.
+   */
+  float l_hL[4] = { 10, 100, 4, 0.5f };
+  float l_hR[4] = {  5,  20, 4, 7.5f };
+  float l_bL[4] = { -10, -100, -4, -0.5f };
+  float l_bR[4] = { -5,   -20, -4, -7.5f };
+
+  for( unsigned short l_ed = 0; l_ed < 4; l_ed++ ) {
+    float l_netUpdatesL[2] = { -5, 3 };
+    float l_netUpdatesR[2] = {  4, 7 };
+
+    tsunami_lab::solvers::Hll< float >::netUpdates( l_hL[l_ed],
+                                                    l_hR[l_ed],
+                                                    0,
+                                                    0,
+                                                    l_bL[l_ed],
+                                                    l_bR[l_ed],
+                                                    l_netUpdatesL,
+                                                    l_netUpdatesR );
+
+    REQUIRE( l_netUpdatesL[0] == 0 );
+    REQUIRE( l_netUpdatesL[1] == 0 );
+    REQUIRE( l_netUpdatesR[0] == 0 );
+    REQUIRE( l_netUpdatesR[1] == 0 );
+  }
+}
+
+TEST_CASE( "Test the batched derivation of the HLL net-updates.", "[HllUpdatesBatch]" ) {
+  /*
+   * Test case:
+   *
+   *   Random edges with subcritical and supercritical flows in both directions and random bathymetry.
+   *   The batched net-updates have to match the single-edge version.
+   */
+  std::size_t l_nEdges = 100;
+
+  std::mt19937 l_gen( 7 );
+  std::uniform_real_distribution< double > l_hDist( 0.5, 10 );
+  std::uniform_real_distribution< double > l_uDist( -15, 15 );
+  std::uniform_real_distribution< double > l_bDist( -20, 0 );
+
+  std::vector< double > l_hL( l_nEdges ), l_hR( l_nEdges );
+  std::vector< double > l_huL( l_nEdges ), l_huR( l_nEdges );
+  std::vector< double > l_bL( l_nEdges ), l_bR( l_nEdges );
+  for( std::size_t l_ed = 0; l_ed < l_nEdges; l_ed++ ) {
+    l_hL[l_ed] = l_hDist( l_gen );
+    l_hR[l_ed] = l_hDist( l_gen );
+    l_huL[l_ed] = l_hL[l_ed] * l_uDist( l_gen );
+    l_huR[l_ed] = l_hR[l_ed] * l_uDist( l_gen );
+    l_bL[l_ed] = l_bDist( l_gen );
+    l_bR[l_ed] = l_bDist( l_gen );
+  }
+
+  std::vector< double > l_netUpdates( 4 * l_nEdges, 0 );
+  double * l_netUpdatesL[2] = { l_netUpdates.data(), l_netUpdates.data() + l_nEdges };
+  double * l_netUpdatesR[2] = { l_netUpdates.data() + 2 * l_nEdges, l_netUpdates.data() + 3 * l_nEdges };
+
+  double l_speedMax = tsunami_lab::solvers::Hll< double >::netUpdatesBatch( l_nEdges,
+                                                                            l_hL.data(),
+                                                                            l_hR.data(),
+                                                                            l_huL.data(),
+                                                                            l_huR.data(),
+                                                                            l_bL.data(),
+                                                                            l_bR.data(),
+                                                                            l_netUpdatesL,
+                                                                            l_netUpdatesR );
+
+  double l_speedMaxRef = 0;
+  for( std::size_t l_ed = 0; l_ed < l_nEdges; l_ed++ ) {
+    double l_waveSpeedL = 0;
+    double l_waveSpeedR = 0;
+    tsunami_lab::solvers::Hll< double >::waveSpeeds( l_hL[l_ed],
+                                                     l_hR[l_ed],
+                                                     l_huL[l_ed] / l_hL[l_ed],
+                                                     l_huR[l_ed] / l_hR[l_ed],
+                                                     l_waveSpeedL,
+                                                     l_waveSpeedR );
+    l_speedMaxRef = std::max( l_speedMaxRef, std::abs( l_waveSpeedL ) );
+    l_speedMaxRef = std::max( l_speedMaxRef, std::abs( l_waveSpeedR ) );
+
+    double l_netUpdatesRefL[2] = { 0 };
+    double l_netUpdatesRefR[2] = { 0 };
+    tsunami_lab::solvers::Hll< double >::netUpdates( l_hL[l_ed],
+                                                     l_hR[l_ed],
+                                                     l_huL[l_ed],
+                                                     l_huR[l_ed],
+                                                     l_bL[l_ed],
+                                                     l_bR[l_ed],
+                                                     l_netUpdatesRefL,
+                                                     l_netUpdatesRefR );
+
+    REQUIRE( l_netUpdatesL[0][l_ed] == Approx( l_netUpdatesRefL[0] ).epsilon( 1E-12 ) );
+    REQUIRE( l_netUpdatesL[1][l_ed] == Approx( l_netUpdatesRefL[1] ).epsilon( 1E-12 ) );
+    REQUIRE( l_netUpdatesR[0][l_ed] == Approx( l_netUpdatesRefR[0] ).epsilon( 1E-12 ) );
+    REQUIRE( l_netUpdatesR[1][l_ed] == Approx( l_netUpdatesRefR[1] ).epsilon( 1E-12 ) );
+
+    // the waves sum up to the jump in the fluxes minus the source term
+    double l_fluxJumpH = l_huR[l_ed] - l_huL[l_ed];
+    REQUIRE( l_netUpdatesL[0][l_ed] + l_netUpdatesR[0][l_ed] == Approx( l_fluxJumpH ).margin( 1E-9 ) );
+  }
+
+  REQUIRE( l_speedMax == Approx( l_speedMaxRef ) );
+}
@@ -0,0 +1,137 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the Roe Riemann solver.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "Roe.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  //! number of edges per call; small enough to stay in the L1 and L2 caches
+  tsunami_lab::t_idx constexpr g_nEdges = 4096;
+
+  /**
+   * Generates the states of the edges' left and right sides.
+   *
+   * @param i_distribution steady, dambreak, subcritical or supercritical.
+   * @param o_h will be set to the heights; left sides first, right sides second.
+   * @param o_hu will be set to the momenta; left sides first, right sides second.
+   **/
+  template< typename T_real >
+  void generate( std::string const     & i_distribution,
+                 std::vector< T_real > & o_h,
+                 std::vector< T_real > & o_hu ) {
+    std::mt19937 l_gen( 42 );
+    std::uniform_real_distribution< T_real > l_hDist( 1, 10 );
+    std::uniform_real_distribution< T_real > l_uDist( -2, 2 );
+
+    // flows faster than the gravity waves, thus both waves move to the right
+    std::uniform_real_distribution< T_real > l_hDistSuper( 1, 2 );
+    std::uniform_real_distribution< T_real > l_uDistSuper( 10, 20 );
+
+    o_h.resize( 2 * g_nEdges );
+    o_hu.resize( 2 * g_nEdges );
+
+    for( tsunami_lab::t_idx l_va = 0; l_va < 2 * g_nEdges; l_va++ ) {
+      if( i_distribution == "steady" ) {
+        o_h[l_va] = 5;
+        o_hu[l_va] = 0;
+      }
+      else if( i_distribution == "dambreak" ) {
+        o_h[l_va] = l_hDist( l_gen );
+        o_hu[l_va] = 0;
+      }
+      else if( i_distribution == "subcritical" ) {
+        o_h[l_va] = l_hDist( l_gen );
+        o_hu[l_va] = o_h[l_va] * l_uDist( l_gen );
+      }
+      else {
+        o_h[l_va] = l_hDistSuper( l_gen );
+        o_hu[l_va] = o_h[l_va] * l_uDistSuper( l_gen );
+      }
+    }
+  }
+
+  /**
+   * Measures the single-edge and batched net-updates for all state distributions.
+   *
+   * @param io_benchmark benchmark which records the results.
+   * @param i_type name of the floating point type.
+   **/
+  template< typename T_real >
+  void runType( tsunami_lab::benchmarks::Benchmark & io_benchmark,
+                std::string const                  & i_type ) {
+    typedef tsunami_lab::solvers::Roe< T_real > t_solver;
+
+    std::vector< T_real > l_netUpdates( 4 * g_nEdges );
+    T_real * l_netUpdatesL[2] = { l_netUpdates.data(),
+                                  l_netUpdates.data() + g_nEdges };
+    T_real * l_netUpdatesR[2] = { l_netUpdates.data() + 2 * g_nEdges,
+                                  l_netUpdates.data() + 3 * g_nEdges };
+
+    for( std::string l_distribution : { "steady", "dambreak", "subcritical", "supercritical" } ) {
+      std::vector< T_real > l_h;
+      std::vector< T_real > l_hu;
+      generate( l_distribution,
+                l_h,
+                l_hu );
+
+      T_real const * l_hL = l_h.data();
+      T_real const * l_hR = l_h.data() + g_nEdges;
+      T_real const * l_huL = l_hu.data();
+      T_real const * l_huR = l_hu.data() + g_nEdges;
+
+      double l_seconds = io_benchmark.measure( [&]() {
+        for( tsunami_lab::t_idx l_ed = 0; l_ed < g_nEdges; l_ed++ ) {
+          T_real l_netUpdateL[2];
+          T_real l_netUpdateR[2];
+
+          t_solver::netUpdates( l_hL[l_ed],
+                                l_hR[l_ed],
+                                l_huL[l_ed],
+                                l_huR[l_ed],
+                                l_netUpdateL,
+                                l_netUpdateR );
+
+          l_netUpdatesL[0][l_ed] = l_netUpdateL[0];
+          l_netUpdatesL[1][l_ed] = l_netUpdateL[1];
+          l_netUpdatesR[0][l_ed] = l_netUpdateR[0];
+          l_netUpdatesR[1][l_ed] = l_netUpdateR[1];
+        }
+      } );
+      io_benchmark.report( "Roe::netUpdates/" + i_type + "/" + l_distribution,
+                           "edges/s",
+                           g_nEdges / l_seconds );
+
+      l_seconds = io_benchmark.measure( [&]() {
+        t_solver::netUpdatesBatch( g_nEdges,
+                                   l_hL,
+                                   l_hR,
+                                   l_huL,
+                                   l_huR,
+                                   l_netUpdatesL,
+                                   l_netUpdatesR );
+      } );
+      io_benchmark.report( "Roe::netUpdatesBatch/" + i_type + "/" + l_distribution,
+                           "edges/s",
+                           g_nEdges / l_seconds );
+    }
+  }
+
+  /**
+   * Runs the case.
+   *
+   * @param io_benchmark benchmark which records the results.
+   **/
+  void run( tsunami_lab::benchmarks::Benchmark & io_benchmark ) {
+    runType< float >( io_benchmark, "float" );
+    runType< double >( io_benchmark, "double" );
+  }
+
+  [[maybe_unused]] bool g_registered = tsunami_lab::benchmarks::Benchmark::registerCase( "Roe",
+                                                                         run );
+}
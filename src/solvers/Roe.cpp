@@ -5,122 +5,135 @@
  * Roe Riemann solver for the shallow water equations.
  **/
 #include "Roe.h"
-#include <cmath>
-
-void tsunami_lab::solvers::Roe::waveSpeeds( t_real   i_hL,
-                                            t_real   i_hR,
-                                            t_real   i_uL,
-                                            t_real   i_uR,
-                                            t_real & o_waveSpeedL,
-                                            t_real & o_waveSpeedR ) {
-  // pre-compute square-root ops
-  t_real l_hSqrtL = std::sqrt( i_hL );
-  t_real l_hSqrtR = std::sqrt( i_hR );
-
-  // compute Roe averages
-  t_real l_hRoe = 0.5f * ( i_hL + i_hR );
-  t_real l_uRoe = l_hSqrtL * i_uL + l_hSqrtR * i_uR;
-  l_uRoe /= l_hSqrtL + l_hSqrtR;
-
-  // compute wave speeds
-  t_real l_ghSqrtRoe = m_gSqrt * std::sqrt( l_hRoe );
-  o_waveSpeedL = l_uRoe - l_ghSqrtRoe;
-  o_waveSpeedR = l_uRoe + l_ghSqrtRoe;
+#include "TargetClones.h"
+#include <algorithm>
+
+// the kernel is inlined into every clone and thus compiled for the clone's instruction set
+#if defined(__GNUC__)
+#define TSUNAMI_LAB_ALWAYS_INLINE __attribute__(( always_inline )) inline
+#else
+#define TSUNAMI_LAB_ALWAYS_INLINE inline
+#endif
+
+template< typename T_real >
+template< bool T_speeds >
+TSUNAMI_LAB_ALWAYS_INLINE
+T_real tsunami_lab::solvers::Roe< T_real >::netUpdatesBatchKernel( t_idx                     i_nEdges,
+                                                                    T_real const * __restrict i_hL,
+                                                                    T_real const * __restrict i_hR,
+                                                                    T_real const * __restrict i_huL,
+                                                                    T_real const * __restrict i_huR,
+                                                                    T_real       *            o_netUpdatesL[2],
+                                                                    T_real       *            o_netUpdatesR[2],
+                                                                    T_real       * __restrict o_speeds ) {
+  T_real * __restrict l_netUpdatesLH  = o_netUpdatesL[0];
+  T_real * __restrict l_netUpdatesLHu = o_netUpdatesL[1];
+  T_real * __restrict l_netUpdatesRH  = o_netUpdatesR[0];
+  T_real * __restrict l_netUpdatesRHu = o_netUpdatesR[1];
+
+  // maximum absolute wave speed, reduced on the fly
+  T_real l_speedMax = 0;
+
+#pragma omp simd reduction(max:l_speedMax)
+  for( t_idx l_ed = 0; l_ed < i_nEdges; l_ed++ ) {
+    // compute particle velocities
+    T_real l_uL = i_huL[l_ed] / i_hL[l_ed];
+    T_real l_uR = i_huR[l_ed] / i_hR[l_ed];
+
+    // compute wave speeds
+    T_real l_sL = 0;
+    T_real l_sR = 0;
+
+    waveSpeeds( i_hL[l_ed],
+                i_hR[l_ed],
+                l_uL,
+                l_uR,
+                l_sL,
+                l_sR );
+
+    T_real l_speed = std::max( -l_sL, l_sR );
+    l_speedMax = std::max( l_speed, l_speedMax );
+    if constexpr( T_speeds ) {
+      o_speeds[l_ed] = l_speed;
+    }
+
+    // compute wave strengths
+    T_real l_aL = 0;
+    T_real l_aR = 0;
+
+    waveStrengths( i_hL[l_ed],
+                   i_hR[l_ed],
+                   i_huL[l_ed],
+                   i_huR[l_ed],
+                   l_sL,
+                   l_sR,
+                   l_aL,
+                   l_aR );
+
+    // compute scaled waves
+    T_real l_waveLH  = l_sL * l_aL;
+    T_real l_waveLHu = l_sL * l_aL * l_sL;
+
+    T_real l_waveRH  = l_sR * l_aR;
+    T_real l_waveRHu = l_sR * l_aR * l_sR;
+
+    // select net-updates through blends; mirrors the branches of the single-edge version
+    bool l_toLeft1  = l_sL < 0;
+    bool l_toRight2 = l_sR > 0;
+
+    T_real l_upLH  = l_toLeft1 ? l_waveLH  : 0;
+    T_real l_upLHu = l_toLeft1 ? l_waveLHu : 0;
+    T_real l_upRH  = l_toLeft1 ? 0 : l_waveLH;
+    T_real l_upRHu = l_toLeft1 ? 0 : l_waveLHu;
+
+    l_netUpdatesLH[l_ed]  = l_toRight2 ? l_upLH  : l_waveRH;
+    l_netUpdatesLHu[l_ed] = l_toRight2 ? l_upLHu : l_waveRHu;
+    l_netUpdatesRH[l_ed]  = l_toRight2 ? l_waveRH  : l_upRH;
+    l_netUpdatesRHu[l_ed] = l_toRight2 ? l_waveRHu : l_upRHu;
+  }
+
+  return l_speedMax;
 }
 
-void tsunami_lab::solvers::Roe::waveStrengths( t_real   i_hL,
-                                               t_real   i_hR,
-                                               t_real   i_huL,
-                                               t_real   i_huR,
-                                               t_real   i_waveSpeedL,
-                                               t_real   i_waveSpeedR,
-                                               t_real & o_strengthL,
-                                               t_real & o_strengthR ) {
-  // compute inverse of right eigenvector-matrix
-  t_real l_detInv = 1 / (i_waveSpeedR - i_waveSpeedL);
-
-  t_real l_rInv[2][2] = {0};
-  l_rInv[0][0] =  l_detInv * i_waveSpeedR;
-  l_rInv[0][1] = -l_detInv;
-  l_rInv[1][0] = -l_detInv * i_waveSpeedL;
-  l_rInv[1][1] =  l_detInv;
-
-  // compute jump in quantities
-  t_real l_hJump  = i_hR  - i_hL;
-  t_real l_huJump = i_huR - i_huL;
-
-  // compute wave strengths
-  o_strengthL  = l_rInv[0][0] * l_hJump;
-  o_strengthL += l_rInv[0][1] * l_huJump;
-
-  o_strengthR  = l_rInv[1][0] * l_hJump;
-  o_strengthR += l_rInv[1][1] * l_huJump;
+template< typename T_real >
+TSUNAMI_LAB_TARGET_CLONES
+T_real tsunami_lab::solvers::Roe< T_real >::netUpdatesBatch( t_idx                     i_nEdges,
+                                                              T_real const * __restrict i_hL,
+                                                              T_real const * __restrict i_hR,
+                                                              T_real const * __restrict i_huL,
+                                                              T_real const * __restrict i_huR,
+                                                              T_real       *            o_netUpdatesL[2],
+                                                              T_real       *            o_netUpdatesR[2] ) {
+  return netUpdatesBatchKernel< false >( i_nEdges,
+                                         i_hL,
+                                         i_hR,
+                                         i_huL,
+                                         i_huR,
+                                         o_netUpdatesL,
+                                         o_netUpdatesR,
+                                         nullptr );
 }
 
-void tsunami_lab::solvers::Roe::netUpdates( t_real i_hL,
-                                            t_real i_hR,
-                                            t_real i_huL,
-                                            t_real i_huR,
-                                            t_real o_netUpdateL[2],
-                                            t_real o_netUpdateR[2] ) {
-  // compute particle velocities
-  t_real l_uL = i_huL / i_hL;
-  t_real l_uR = i_huR / i_hR;
-
-  // compute wave speeds
-  t_real l_sL = 0;
-  t_real l_sR = 0;
-
-  waveSpeeds( i_hL,
-              i_hR,
-              l_uL,
-              l_uR,
-              l_sL,
-              l_sR );
-
-  // compute wave strengths
-  t_real l_aL = 0;
-  t_real l_aR = 0;
-
-  waveStrengths( i_hL,
-                 i_hR,
-                 i_huL,
-                 i_huR,
-                 l_sL,
-                 l_sR,
-                 l_aL,
-                 l_aR );
-
-  // compute scaled waves
-  t_real l_waveL[2] = {0};
-  t_real l_waveR[2] = {0};
-
-  l_waveL[0] = l_sL * l_aL;
-  l_waveL[1] = l_sL * l_aL * l_sL;
-
-  l_waveR[0] = l_sR * l_aR;
-  l_waveR[1] = l_sR * l_aR * l_sR;
-
-  // set net-updates depending on wave speeds
-  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
-    // init
-    o_netUpdateL[l_qt] = 0;
-    o_netUpdateR[l_qt] = 0;
-
-    // 1st wave
-    if( l_sL < 0 ) {
-      o_netUpdateL[l_qt] = l_waveL[l_qt];
-    }
-    else {
-      o_netUpdateR[l_qt] = l_waveL[l_qt];
-    }
+template< typename T_real >
+TSUNAMI_LAB_TARGET_CLONES
+T_real tsunami_lab::solvers::Roe< T_real >::netUpdatesBatch( t_idx                     i_nEdges,
+                                                              T_real const * __restrict i_hL,
+                                                              T_real const * __restrict i_hR,
+                                                              T_real const * __restrict i_huL,
+                                                              T_real const * __restrict i_huR,
+                                                              T_real       *            o_netUpdatesL[2],
+                                                              T_real       *            o_netUpdatesR[2],
+                                                              T_real       * __restrict o_speeds ) {
+  return netUpdatesBatchKernel< true >( i_nEdges,
+                                        i_hL,
+                                        i_hR,
+                                        i_huL,
+                                        i_huR,
+                                        o_netUpdatesL,
+                                        o_netUpdatesR,
+                                        o_speeds );
+}
 
-    // 2nd wave
-    if( l_sR > 0 ) {
-      o_netUpdateR[l_qt] = l_waveR[l_qt];
-    }
-    else {
-      o_netUpdateL[l_qt] = l_waveR[l_qt];
-    }
-  }
-}
\ No newline at end of file
+// explicit instantiations of the batched version
+template class tsunami_lab::solvers::Roe< float >;
+template class tsunami_lab::solvers::Roe< double >;
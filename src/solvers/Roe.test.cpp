@@ -5,6 +5,8 @@
  * Unit tests of the Roe Riemann solver.
  **/
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <cmath>
 #define private public
 #include "Roe.h"
 #undef public
@@ -23,12 +25,12 @@ TEST_CASE( "Test the derivation of the Roe speeds.", "[RoeSpeeds]" ) {
     */
   float l_waveSpeedL = 0;
   float l_waveSpeedR = 0;
-  tsunami_lab::solvers::Roe::waveSpeeds( 10,
-                                         9,
-                                         -3,
-                                         3,
-                                         l_waveSpeedL,
-                                         l_waveSpeedR );
+  tsunami_lab::solvers::Roe<>::waveSpeeds( 10,
+                                           9,
+                                           -3,
+                                           3,
+                                           l_waveSpeedL,
+                                           l_waveSpeedR );
 
   REQUIRE( l_waveSpeedL == Approx( -9.7311093998375095 ) );
   REQUIRE( l_waveSpeedR == Approx(  9.5731051658991654 ) );
@@ -69,14 +71,14 @@ TEST_CASE( "Test the derivation of the Roe wave speeds.", "[RoeStrengths]" ) {
   float l_strengthL = 0;
   float l_strengthR = 0;
 
-  tsunami_lab::solvers::Roe::waveStrengths( 10,
-                                            9,
-                                            -30,
-                                            27,
-                                            -9.7311093998375095,
-                                            9.5731051658991654,
-                                            l_strengthL,
-                                            l_strengthR );
+  tsunami_lab::solvers::Roe<>::waveStrengths( 10,
+                                              9,
+                                              -30,
+                                              27,
+                                              -9.7311093998375095,
+                                              9.5731051658991654,
+                                              l_strengthL,
+                                              l_strengthR );
 
   REQUIRE( l_strengthL == Approx(-3.4486306054668869) );
   REQUIRE( l_strengthR == Approx( 2.4486306054668869) );
@@ -106,12 +108,12 @@ TEST_CASE( "Test the derivation of the Roe net-updates.", "[RoeUpdates]" ) {
   float l_netUpdatesL[2] = { -5, 3 };
   float l_netUpdatesR[2] = {  4, 7 };
 
-  tsunami_lab::solvers::Roe::netUpdates( 10,
-                                         9,
-                                         -30,
-                                         27,
-                                         l_netUpdatesL,
-                                         l_netUpdatesR );
+  tsunami_lab::solvers::Roe<>::netUpdates( 10,
+                                           9,
+                                           -30,
+                                           27,
+                                           l_netUpdatesL,
+                                           l_netUpdatesR );
 
   REQUIRE( l_netUpdatesL[0] == Approx( 33.5590017014261447899292 ) );
   REQUIRE( l_netUpdatesL[1] == Approx( -326.56631690591093200508 ) );
@@ -155,12 +157,12 @@ TEST_CASE( "Test the derivation of the Roe net-updates.", "[RoeUpdates]" ) {
    * update #2: s2 * a2 * |    | = |               |
    *                      | s2 |   | -88.25985     |
    */
-  tsunami_lab::solvers::Roe::netUpdates( 10,
-                                         8,
-                                         0,
-                                         0,
-                                         l_netUpdatesL,
-                                         l_netUpdatesR ); 
+  tsunami_lab::solvers::Roe<>::netUpdates( 10,
+                                           8,
+                                           0,
+                                           0,
+                                           l_netUpdatesL,
+                                           l_netUpdatesR ); 
 
   REQUIRE( l_netUpdatesL[0] ==  Approx(9.394671362) );
   REQUIRE( l_netUpdatesL[1] == -Approx(88.25985)    );
@@ -175,16 +177,131 @@ TEST_CASE( "Test the derivation of the Roe net-updates.", "[RoeUpdates]" ) {
    *   h:  10 | 10
    *  hu:   0 |  0
    */
-  tsunami_lab::solvers::Roe::netUpdates( 10,
-                                         10,
-                                         0,
-                                         0,
-                                         l_netUpdatesL,
-                                         l_netUpdatesR );
+  tsunami_lab::solvers::Roe<>::netUpdates( 10,
+                                           10,
+                                           0,
+                                           0,
+                                           l_netUpdatesL,
+                                           l_netUpdatesR );
 
   REQUIRE( l_netUpdatesL[0] == Approx(0) );
   REQUIRE( l_netUpdatesL[1] == Approx(0) );
 
   REQUIRE( l_netUpdatesR[0] == Approx(0) );
   REQUIRE( l_netUpdatesR[1] == Approx(0) );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Test the batched derivation of the Roe net-updates.", "[RoeUpdatesBatch]" ) {
+  /*
+   * Test case:
+   *
+   *   Batch of edges covering subsonic and supersonic states in both directions.
+   *   The batched net-updates have to match the single-edge version.
+   *   Vectorized clones may contract to FMAs, thus results are compared up to rounding.
+   */
+  tsunami_lab::t_real l_hL[7]  = {  10, 10,  10,  10,   1,  4,   2 };
+  tsunami_lab::t_real l_hR[7]  = {   9,  8,  10,   5,   1,  3,   2 };
+  tsunami_lab::t_real l_huL[7] = { -30,  0,   0, 100, -40,  7,  30 };
+  tsunami_lab::t_real l_huR[7] = {  27,  0,   0,  90, -35,  2,  25 };
+
+  tsunami_lab::t_real l_nuLH[7]  = { 0 };
+  tsunami_lab::t_real l_nuLHu[7] = { 0 };
+  tsunami_lab::t_real l_nuRH[7]  = { 0 };
+  tsunami_lab::t_real l_nuRHu[7] = { 0 };
+
+  tsunami_lab::t_real * l_netUpdatesL[2] = { l_nuLH, l_nuLHu };
+  tsunami_lab::t_real * l_netUpdatesR[2] = { l_nuRH, l_nuRHu };
+
+  tsunami_lab::t_real l_speedMax = tsunami_lab::solvers::Roe<>::netUpdatesBatch( 7,
+                                                                                 l_hL,
+                                                                                 l_hR,
+                                                                                 l_huL,
+                                                                                 l_huR,
+                                                                                 l_netUpdatesL,
+                                                                                 l_netUpdatesR );
+
+  tsunami_lab::t_real l_speedMaxRef = 0;
+
+  for( unsigned short l_ed = 0; l_ed < 7; l_ed++ ) {
+    float l_waveSpeedL = 0;
+    float l_waveSpeedR = 0;
+    tsunami_lab::solvers::Roe<>::waveSpeeds( l_hL[l_ed],
+                                             l_hR[l_ed],
+                                             l_huL[l_ed] / l_hL[l_ed],
+                                             l_huR[l_ed] / l_hR[l_ed],
+                                             l_waveSpeedL,
+                                             l_waveSpeedR );
+    l_speedMaxRef = std::max( l_speedMaxRef, std::abs( l_waveSpeedL ) );
+    l_speedMaxRef = std::max( l_speedMaxRef, std::abs( l_waveSpeedR ) );
+
+    float l_netUpdatesRefL[2] = { 0 };
+    float l_netUpdatesRefR[2] = { 0 };
+
+    tsunami_lab::solvers::Roe<>::netUpdates( l_hL[l_ed],
+                                             l_hR[l_ed],
+                                             l_huL[l_ed],
+                                             l_huR[l_ed],
+                                             l_netUpdatesRefL,
+                                             l_netUpdatesRefR );
+
+    REQUIRE( l_nuLH[l_ed]  == Approx( l_netUpdatesRefL[0] ) );
+    REQUIRE( l_nuLHu[l_ed] == Approx( l_netUpdatesRefL[1] ) );
+    REQUIRE( l_nuRH[l_ed]  == Approx( l_netUpdatesRefR[0] ) );
+    REQUIRE( l_nuRHu[l_ed] == Approx( l_netUpdatesRefR[1] ) );
+  }
+
+  REQUIRE( l_speedMax == Approx( l_speedMaxRef ) );
+
+  // first edge: see derivation of the net-updates above
+  REQUIRE( l_nuLH[0]  == Approx( 33.5590017014261447899292 ) );
+  REQUIRE( l_nuLHu[0] == Approx( -326.56631690591093200508 ) );
+  REQUIRE( l_nuRH[0]  == Approx( 23.4409982985738561366777 ) );
+  REQUIRE( l_nuRHu[0] == Approx( 224.403141905910928927533 ) );
+}
+
+TEST_CASE( "Test the derivation of the Roe net-updates in double precision.", "[RoeUpdatesDouble]" ) {
+  /*
+   * Test case: same as in RoeUpdates, but with a tighter tolerance.
+   */
+  double l_netUpdatesL[2] = { -5, 3 };
+  double l_netUpdatesR[2] = {  4, 7 };
+
+  tsunami_lab::solvers::Roe< double >::netUpdates( 10,
+                                                   9,
+                                                   -30,
+                                                   27,
+                                                   l_netUpdatesL,
+                                                   l_netUpdatesR );
+
+  // the reference uses 9.80665 as gravity, the solver its truncated square root
+  REQUIRE( l_netUpdatesL[0] == Approx( 33.5590017014261447899292 ).epsilon( 1E-8 ) );
+  REQUIRE( l_netUpdatesL[1] == Approx( -326.56631690591093200508 ).epsilon( 1E-8 ) );
+
+  REQUIRE( l_netUpdatesR[0] == Approx( 23.4409982985738561366777 ).epsilon( 1E-8 ) );
+  REQUIRE( l_netUpdatesR[1] == Approx( 224.403141905910928927533 ).epsilon( 1E-8 ) );
+
+  // the batched version agrees with the single-edge one
+  double l_hL[1] = { 10 };
+  double l_hR[1] = { 9 };
+  double l_huL[1] = { -30 };
+  double l_huR[1] = { 27 };
+  double l_batchLH[1] = { 0 };
+  double l_batchLHu[1] = { 0 };
+  double l_batchRH[1] = { 0 };
+  double l_batchRHu[1] = { 0 };
+  double * l_batchL[2] = { l_batchLH, l_batchLHu };
+  double * l_batchR[2] = { l_batchRH, l_batchRHu };
+
+  tsunami_lab::solvers::Roe< double >::netUpdatesBatch( 1,
+                                                        l_hL,
+                                                        l_hR,
+                                                        l_huL,
+                                                        l_huR,
+                                                        l_batchL,
+                                                        l_batchR );
+
+  REQUIRE( l_batchLH[0]  == Approx( l_netUpdatesL[0] ).epsilon( 1E-12 ) );
+  REQUIRE( l_batchLHu[0] == Approx( l_netUpdatesL[1] ).epsilon( 1E-12 ) );
+  REQUIRE( l_batchRH[0]  == Approx( l_netUpdatesR[0] ).epsilon( 1E-12 ) );
+  REQUIRE( l_batchRHu[0] == Approx( l_netUpdatesR[1] ).epsilon( 1E-12 ) );
+}
@@ -0,0 +1,17 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Function multi-versioning of the solvers' batched kernels.
+ **/
+#ifndef TSUNAMI_LAB_SOLVERS_TARGET_CLONES
+#define TSUNAMI_LAB_SOLVERS_TARGET_CLONES
+
+// function multi-versioning: the loader picks the best clone for the host's CPU at runtime
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define TSUNAMI_LAB_TARGET_CLONES __attribute__(( target_clones( "avx512f", "avx2", "default" ) ))
+#else
+#define TSUNAMI_LAB_TARGET_CLONES
+#endif
+
+#endif